@@ -253,12 +253,12 @@ QWidget* DltDBusPlugin::initViewer()
     return form;
 }
 
-void DltDBusPlugin::selectedIdxMsgDecoded(int , QDltMsg &/*msg*/)
+void DltDBusPlugin::selectedIdxMsgDecoded(qint64 , QDltMsg &/*msg*/)
 {
     /* Show Decoded output */
 }
 
-void DltDBusPlugin::selectedIdxMsg(int /*index*/, QDltMsg &msg)
+void DltDBusPlugin::selectedIdxMsg(qint64 /*index*/, QDltMsg &msg)
 {
     QString text;
     QDltArgument argument;
@@ -490,7 +490,7 @@ void DltDBusPlugin::segmentedMsg(QDltMsg &msg)
     } // NWCN
 }
 
-void DltDBusPlugin::initMsg(int /*index*/, QDltMsg &msg)
+void DltDBusPlugin::initMsg(qint64 /*index*/, QDltMsg &msg)
 {
 
     if(!checkIfDBusMsg(msg))
@@ -504,7 +504,7 @@ void DltDBusPlugin::initMsg(int /*index*/, QDltMsg &msg)
 
 }
 
-void DltDBusPlugin::initMsgDecoded(int , QDltMsg &)
+void DltDBusPlugin::initMsgDecoded(qint64 , QDltMsg &)
 {
 //empty. Implemented because derived plugin interface functions are virtual.
 }
@@ -518,7 +518,7 @@ void DltDBusPlugin::updateFileStart()
 //empty. Implemented because derived plugin interface functions are virtual.
 }
 
-void DltDBusPlugin::updateMsg(int /*index*/, QDltMsg &msg)
+void DltDBusPlugin::updateMsg(qint64 /*index*/, QDltMsg &msg)
 {
    //  qDebug () << "Activate plugin" << plugin_name_displayed << "Version" << DLT_DBUS_PLUGIN_VERSION;
     if(!checkIfDBusMsg(msg))
@@ -531,7 +531,7 @@ void DltDBusPlugin::updateMsg(int /*index*/, QDltMsg &msg)
     segmentedMsg(msg);
 }
 
-void DltDBusPlugin::updateMsgDecoded(int , QDltMsg &){
+void DltDBusPlugin::updateMsgDecoded(qint64 , QDltMsg &){
 //empty. Implemented because derived plugin interface functions are virtual.
 }
 
@@ -657,6 +657,12 @@ bool DltDBusPlugin::decodeMsg(QDltMsg &msg, int triggeredByUser)
     return true;
 }
 
+bool DltDBusPlugin::isThreadSafe()
+{
+    /* segmented messages are collected by updateMsg() and read by decodeMsg() */
+    return false;
+}
+
 QString DltDBusPlugin::stringToHtml(QString str)
 {
     str = str.replace("<","&#60;");
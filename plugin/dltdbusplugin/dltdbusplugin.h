@@ -100,14 +100,14 @@ public:
     QWidget* initViewer();
     void initFileStart(QDltFile *file);
     void initFileFinish();
-    void initMsg(int index, QDltMsg &msg);
-    void initMsgDecoded(int index, QDltMsg &msg);
+    void initMsg(qint64 index, QDltMsg &msg);
+    void initMsgDecoded(qint64 index, QDltMsg &msg);
     void updateFileStart();
-    void updateMsg(int index, QDltMsg &msg);
-    void updateMsgDecoded(int index, QDltMsg &msg);
+    void updateMsg(qint64 index, QDltMsg &msg);
+    void updateMsgDecoded(qint64 index, QDltMsg &msg);
     void updateFileFinish();
-    void selectedIdxMsg(int index, QDltMsg &msg);
-    void selectedIdxMsgDecoded(int index, QDltMsg &msg);
+    void selectedIdxMsg(qint64 index, QDltMsg &msg);
+    void selectedIdxMsgDecoded(qint64 index, QDltMsg &msg);
 
     /* QDltPluginControlInterface */
     bool initControl(QDltControl *control);
@@ -120,6 +120,7 @@ public:
     /* QDltPluginDecoderInterface */
     bool isMsg(QDltMsg &msg, int triggeredByUser);
     bool decodeMsg(QDltMsg &msg, int triggeredByUser);
+    bool isThreadSafe();
 
     /* internal variables */
     Form *form;
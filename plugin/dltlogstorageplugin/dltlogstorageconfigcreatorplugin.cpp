@@ -79,12 +79,12 @@ void DltLogstorageConfigCreatorPlugin::initFileFinish() {
 
 }
 
-void DltLogstorageConfigCreatorPlugin::initMsg(int index, QDltMsg &msg) {
+void DltLogstorageConfigCreatorPlugin::initMsg(qint64 index, QDltMsg &msg) {
     index = index; /* not used */
     msg = msg; /* not used */
 }
 
-void DltLogstorageConfigCreatorPlugin::initMsgDecoded(int index, QDltMsg &msg) {
+void DltLogstorageConfigCreatorPlugin::initMsgDecoded(qint64 index, QDltMsg &msg) {
     index = index; /* not used */
     msg = msg; /* not used */
 }
@@ -93,12 +93,12 @@ void DltLogstorageConfigCreatorPlugin::updateFileStart() {
 
 }
 
-void DltLogstorageConfigCreatorPlugin::updateMsg(int index, QDltMsg &msg) {
+void DltLogstorageConfigCreatorPlugin::updateMsg(qint64 index, QDltMsg &msg) {
     index = index; /* not used */
     msg = msg; /* not used */
 }
 
-void DltLogstorageConfigCreatorPlugin::updateMsgDecoded(int index, QDltMsg &msg) {
+void DltLogstorageConfigCreatorPlugin::updateMsgDecoded(qint64 index, QDltMsg &msg) {
     index = index; /* not used */
     msg = msg; /* not used */
 }
@@ -107,12 +107,12 @@ void DltLogstorageConfigCreatorPlugin::updateFileFinish() {
 
 }
 
-void DltLogstorageConfigCreatorPlugin::selectedIdxMsg(int index, QDltMsg &msg) {
+void DltLogstorageConfigCreatorPlugin::selectedIdxMsg(qint64 index, QDltMsg &msg) {
     index = index; /* not used */
     msg = msg; /* not used */
 }
 
-void DltLogstorageConfigCreatorPlugin::selectedIdxMsgDecoded(int index, QDltMsg &msg) {
+void DltLogstorageConfigCreatorPlugin::selectedIdxMsgDecoded(qint64 index, QDltMsg &msg) {
     index = index; /* not used */
     msg = msg; /* not used */
 }
@@ -56,14 +56,14 @@ public:
     QWidget* initViewer();
     void initFileStart(QDltFile *file);
     void initFileFinish();
-    void initMsg(int index, QDltMsg &msg);
-    void initMsgDecoded(int index, QDltMsg &msg);
+    void initMsg(qint64 index, QDltMsg &msg);
+    void initMsgDecoded(qint64 index, QDltMsg &msg);
     void updateFileStart();
-    void updateMsg(int index, QDltMsg &msg);
-    void updateMsgDecoded(int index, QDltMsg &msg);
+    void updateMsg(qint64 index, QDltMsg &msg);
+    void updateMsgDecoded(qint64 index, QDltMsg &msg);
     void updateFileFinish();
-    void selectedIdxMsg(int index, QDltMsg &msg);
-    void selectedIdxMsgDecoded(int index, QDltMsg &msg);
+    void selectedIdxMsg(qint64 index, QDltMsg &msg);
+    void selectedIdxMsgDecoded(qint64 index, QDltMsg &msg);
 
     /* internal variables */
     LogstorageConfigCreatorForm *ui;
@@ -87,11 +87,11 @@ QWidget* DltSystemViewerPlugin::initViewer()
 }
 
 
-void DltSystemViewerPlugin::selectedIdxMsg(int , QDltMsg &) {
+void DltSystemViewerPlugin::selectedIdxMsg(qint64 , QDltMsg &) {
 //empty. Implemented because derived plugin interface functions are virtual.
 }
 
-void DltSystemViewerPlugin::selectedIdxMsgDecoded(int , QDltMsg &){
+void DltSystemViewerPlugin::selectedIdxMsgDecoded(qint64 , QDltMsg &){
 //empty. Implemented because derived plugin interface functions are virtual.
 }
 
@@ -105,12 +105,12 @@ void DltSystemViewerPlugin::initFileStart(QDltFile *file){
 
 }
 
-void DltSystemViewerPlugin::initMsg(int index, QDltMsg &msg){
+void DltSystemViewerPlugin::initMsg(qint64 index, QDltMsg &msg){
 
     updateProcesses(index, msg);
 
 }
-void DltSystemViewerPlugin::initMsgDecoded(int , QDltMsg &){
+void DltSystemViewerPlugin::initMsgDecoded(qint64 , QDltMsg &){
 //empty. Implemented because derived plugin interface functions are virtual.
 }
 
@@ -121,7 +121,7 @@ void DltSystemViewerPlugin::initFileFinish(){
 void DltSystemViewerPlugin::updateFileStart(){
 
 }
-void DltSystemViewerPlugin::updateMsg(int index, QDltMsg &msg){
+void DltSystemViewerPlugin::updateMsg(qint64 index, QDltMsg &msg){
 
     if(!dltFile)
         return;
@@ -132,7 +132,7 @@ void DltSystemViewerPlugin::updateMsg(int index, QDltMsg &msg){
 
 }
 
-void DltSystemViewerPlugin::updateMsgDecoded(int , QDltMsg &){
+void DltSystemViewerPlugin::updateMsgDecoded(qint64 , QDltMsg &){
 //empty. Implemented because derived plugin interface functions are virtual.
 }
 void DltSystemViewerPlugin::updateFileFinish(){
@@ -161,7 +161,7 @@ void DltSystemViewerPlugin::updateProcesses(int , QDltMsg &msg)
                 counterNonVerboseMessages++;
             }
 
-        if(msg.getApid()=="SYS" && msg.getCtid()=="PROC") {
+        if(msg.getApidId()==QDltId("SYS") && msg.getCtidId()==QDltId("PROC")) {
             msg.getArgument(0,arg);
             pid = arg.toString().toInt();
             msg.getArgument(1,arg);
@@ -170,7 +170,7 @@ void DltSystemViewerPlugin::updateProcesses(int , QDltMsg &msg)
                 form->addProcesses(pid,arg.toString(),msg);
             }
         }        
-        if(msg.getApid()=="SYS" && msg.getCtid()=="STAT") {
+        if(msg.getApidId()==QDltId("SYS") && msg.getCtidId()==QDltId("STAT")) {
             msg.getArgument(0,arg);
             seq = arg.toString().toInt();
             if( seq == PROC_STAT_NODE_1 || seq == PROC_STAT_NODE_UNDEFINE ) {
@@ -67,12 +67,12 @@ QWidget* DltViewerPlugin::initViewer() {
     return form;
 }
 
-void DltViewerPlugin::selectedIdxMsgDecoded(int , QDltMsg &msg){
+void DltViewerPlugin::selectedIdxMsgDecoded(qint64 , QDltMsg &msg){
     /* Show Decoded output */
     form->setTextBrowserMessage(msg.toStringHeader()+"<br><br>"+stringToHtml(msg.toStringPayload()));
 }
 
-void DltViewerPlugin::selectedIdxMsg(int index, QDltMsg &msg) {
+void DltViewerPlugin::selectedIdxMsg(qint64 index, QDltMsg &msg) {
     QString text;
     QDltArgument argument;
 
@@ -167,10 +167,10 @@ void DltViewerPlugin::initFileStart(QDltFile *file){
     dltFile = file;
 }
 
-void DltViewerPlugin::initMsg(int /*index*/, QDltMsg & /*msg*/){
+void DltViewerPlugin::initMsg(qint64 /*index*/, QDltMsg & /*msg*/){
 }
 
-void DltViewerPlugin::initMsgDecoded(int , QDltMsg &){
+void DltViewerPlugin::initMsgDecoded(qint64 , QDltMsg &){
 //empty. Implemented because derived plugin interface functions are virtual.
 }
 
@@ -181,10 +181,10 @@ void DltViewerPlugin::updateFileStart(){
 //empty. Implemented because derived plugin interface functions are virtual.
 }
 
-void DltViewerPlugin::updateMsg(int /*index*/, QDltMsg &/*msg*/){
+void DltViewerPlugin::updateMsg(qint64 /*index*/, QDltMsg &/*msg*/){
 }
 
-void DltViewerPlugin::updateMsgDecoded(int , QDltMsg &){
+void DltViewerPlugin::updateMsgDecoded(qint64 , QDltMsg &){
 //empty. Implemented because derived plugin interface functions are virtual.
 }
 
@@ -120,11 +120,11 @@ bool DummyControlPlugin::autoscrollStateChanged(bool enabled)
     return true;
 }
 
-void DummyControlPlugin::selectedIdxMsg(int , QDltMsg &) {
+void DummyControlPlugin::selectedIdxMsg(qint64 , QDltMsg &) {
 
 }
 
-void DummyControlPlugin::selectedIdxMsgDecoded(int , QDltMsg &){
+void DummyControlPlugin::selectedIdxMsgDecoded(qint64 , QDltMsg &){
 
 }
 
@@ -132,10 +132,10 @@ void DummyControlPlugin::initFileStart(QDltFile *file){
     dltFile = file;
 }
 
-void DummyControlPlugin::initMsg(int , QDltMsg &){
+void DummyControlPlugin::initMsg(qint64 , QDltMsg &){
 
 }
-void DummyControlPlugin::initMsgDecoded(int , QDltMsg &){
+void DummyControlPlugin::initMsgDecoded(qint64 , QDltMsg &){
 
 }
 
@@ -147,11 +147,11 @@ void DummyControlPlugin::updateFileStart(){
 
 }
 
-void DummyControlPlugin::updateMsg(int , QDltMsg &){
+void DummyControlPlugin::updateMsg(qint64 , QDltMsg &){
 
 }
 
-void DummyControlPlugin::updateMsgDecoded(int , QDltMsg &){
+void DummyControlPlugin::updateMsgDecoded(qint64 , QDltMsg &){
 
 }
 void DummyControlPlugin::updateFileFinish(){
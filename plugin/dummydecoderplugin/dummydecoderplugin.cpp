@@ -84,6 +84,11 @@ bool DummyDecoderPlugin::decodeMsg(QDltMsg &msg, int triggeredByUser)
     return false;
 }
 
+bool DummyDecoderPlugin::isThreadSafe()
+{
+    return true;
+}
+
 #ifndef QT5
 Q_EXPORT_PLUGIN2(dummydecoderplugin, DummyDecoderPlugin);
 #endif
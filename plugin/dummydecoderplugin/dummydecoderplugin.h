@@ -51,6 +51,7 @@ public:
     /* QDltPluginDecoderInterface */
     bool isMsg(QDltMsg &msg, int triggeredByUser);
     bool decodeMsg(QDltMsg &msg, int triggeredByUser);
+    bool isThreadSafe();
 
 private:
     QString errorText;
@@ -98,7 +98,7 @@ void DummyViewerPlugin::updateCounters(int , QDltMsg &msg)
 }
 
 
-void DummyViewerPlugin::selectedIdxMsg(int index, QDltMsg &/*msg*/) {
+void DummyViewerPlugin::selectedIdxMsg(qint64 index, QDltMsg &/*msg*/) {
     if(!dltFile)
         return;
 
@@ -107,7 +107,7 @@ void DummyViewerPlugin::selectedIdxMsg(int index, QDltMsg &/*msg*/) {
     form->setSelectedMessage(index);
 }
 
-void DummyViewerPlugin::selectedIdxMsgDecoded(int , QDltMsg &/*msg*/){
+void DummyViewerPlugin::selectedIdxMsgDecoded(qint64 , QDltMsg &/*msg*/){
 
     //qDebug() << "decoded: " << msg.toStringPayload();
 
@@ -125,12 +125,12 @@ void DummyViewerPlugin::initFileStart(QDltFile *file){
     counterVerboseMessages = 0;
 }
 
-void DummyViewerPlugin::initMsg(int index, QDltMsg &msg){
+void DummyViewerPlugin::initMsg(qint64 index, QDltMsg &msg){
 
     updateCounters(index, msg);
 }
 
-void DummyViewerPlugin::initMsgDecoded(int , QDltMsg &){
+void DummyViewerPlugin::initMsgDecoded(qint64 , QDltMsg &){
 //empty. Implemented because derived plugin interface functions are virtual.
 }
 
@@ -144,7 +144,7 @@ void DummyViewerPlugin::updateFileStart(){
 
 }
 
-void DummyViewerPlugin::updateMsg(int index, QDltMsg &msg){
+void DummyViewerPlugin::updateMsg(qint64 index, QDltMsg &msg){
         if(!dltFile)
             return;
 
@@ -153,7 +153,7 @@ void DummyViewerPlugin::updateMsg(int index, QDltMsg &msg){
         counterMessages = dltFile->size();
 }
 
-void DummyViewerPlugin::updateMsgDecoded(int , QDltMsg &){
+void DummyViewerPlugin::updateMsgDecoded(qint64 , QDltMsg &){
 //empty. Implemented because derived plugin interface functions are virtual.
 }
 
@@ -53,24 +53,24 @@ public:
     QWidget* initViewer();
     void initFileStart(QDltFile *file);
     void initFileFinish();
-    void initMsg(int index, QDltMsg &msg);
-    void initMsgDecoded(int index, QDltMsg &msg);
+    void initMsg(qint64 index, QDltMsg &msg);
+    void initMsgDecoded(qint64 index, QDltMsg &msg);
     void updateFileStart();
-    void updateMsg(int index, QDltMsg &msg);
-    void updateMsgDecoded(int index, QDltMsg &msg);
+    void updateMsg(qint64 index, QDltMsg &msg);
+    void updateMsgDecoded(qint64 index, QDltMsg &msg);
     void updateFileFinish();
-    void selectedIdxMsg(int index, QDltMsg &msg);
-    void selectedIdxMsgDecoded(int index, QDltMsg &msg);
+    void selectedIdxMsg(qint64 index, QDltMsg &msg);
+    void selectedIdxMsgDecoded(qint64 index, QDltMsg &msg);
 
 
     /* internal variables */
     Form *form;
-    int counterMessages;
-    int counterNonVerboseMessages;
-    int counterVerboseMessages;
+    qint64 counterMessages;
+    qint64 counterNonVerboseMessages;
+    qint64 counterVerboseMessages;
 
     void show(bool value);
-    void updateCounters(int index, QDltMsg &msg);
+    void updateCounters(qint64 index, QDltMsg &msg);
 
 private:
     QDltFile *dltFile;
@@ -33,22 +33,22 @@ Form::~Form()
     delete ui;
 }
 
-void Form::setMessages(int message)
+void Form::setMessages(qint64 message)
 {
     ui->lineEditMessages->setText(QString("%1").arg(message));
 }
 
-void Form::setSelectedMessage(int message)
+void Form::setSelectedMessage(qint64 message)
 {
     ui->lineEditSelectedMessage->setText(QString("%1").arg(message));
 }
 
-void Form::setVerboseMessages(int message)
+void Form::setVerboseMessages(qint64 message)
 {
     ui->lineEditVerboseMessages->setText(QString("%1").arg(message));
 }
 
-void Form::setNonVerboseMessages(int message)
+void Form::setNonVerboseMessages(qint64 message)
 {
     ui->lineEditNonVerboseMessages->setText(QString("%1").arg(message));
 }
@@ -34,10 +34,10 @@ public:
     explicit Form(QWidget *parent = 0);
     ~Form();
 
-    void setMessages(int message);
-    void setSelectedMessage(int message);
-    void setVerboseMessages(int message);
-    void setNonVerboseMessages(int message);
+    void setMessages(qint64 message);
+    void setSelectedMessage(qint64 message);
+    void setVerboseMessages(qint64 message);
+    void setNonVerboseMessages(qint64 message);
 
 private:
     Ui::Form *ui;
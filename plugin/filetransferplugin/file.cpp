@@ -109,7 +109,7 @@ void File::setFileSerialNumber(QString s){
 
 void File::setPackages(QString p){
     packages = p.toInt();
-    dltFileIndex = new QList<int>[packages];
+    dltFileIndex = new QList<qint64>[packages];
     this->setText(COLUMN_PACKAGES, p);
 }
 void File::increaseReceivedPackages(){
@@ -159,7 +159,7 @@ bool File::isComplete(){
     return receivedPackages == packages;
 }
 
-void File::setQFileIndexForPackage(QString packageNumber, int index){
+void File::setQFileIndexForPackage(QString packageNumber, qint64 index){
     int i = packageNumber.toInt();
     dltFileIndex->insert(i-1,index);
     increaseReceivedPackages();
@@ -210,7 +210,7 @@ QByteArray* File::getFileData(){
    fileData = new QByteArray();
 
     for(unsigned int i=0; i<packages;i++){
-       int qfileIdx = dltFileIndex->value(i);
+       qint64 qfileIdx = dltFileIndex->value(i);
        msgBuffer =  dltFile->getMsg(qfileIdx);
        msg.setMsg(msgBuffer);
        msg.getArgument(PROTOCOL_FLDA_DATA,data);
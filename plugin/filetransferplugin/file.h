@@ -60,7 +60,7 @@ public:
      void errorHappens(QString filename, QString errorCode1, QString errorCode2, QString time);
 
      bool isComplete();
-     void setQFileIndexForPackage(QString packageNumber, int index);
+     void setQFileIndexForPackage(QString packageNumber, qint64 index);
 
      bool saveFile(QString newFile);
 
@@ -75,7 +75,7 @@ private:
     unsigned int sizeInBytes;
     unsigned int buffer;
 
-    QList<int> *dltFileIndex;
+    QList<qint64> *dltFileIndex;
     QDltFile *dltFile;
     QByteArray *fileData;
 };
@@ -158,12 +158,12 @@ QWidget* FiletransferPlugin::initViewer()
     return form;
 }
 
-void FiletransferPlugin::selectedIdxMsg(int , QDltMsg &)
+void FiletransferPlugin::selectedIdxMsg(qint64 , QDltMsg &)
 {
 //empty. Implemented because derived plugin interface functions are virtual.
 }
 
-void FiletransferPlugin::selectedIdxMsgDecoded(int , QDltMsg &)
+void FiletransferPlugin::selectedIdxMsgDecoded(qint64 , QDltMsg &)
 {
 //empty. Implemented because derived plugin interface functions are virtual.
 }
@@ -180,13 +180,13 @@ void FiletransferPlugin::initFileStart(QDltFile *file)
     }
 }
 
-void FiletransferPlugin::initMsg(int index, QDltMsg &msg)
+void FiletransferPlugin::initMsg(qint64 index, QDltMsg &msg)
 {
    // this function is called when live trace is acvtive
    updateFiletransfer(index,msg);
 }
 
-void FiletransferPlugin::initMsgDecoded(int , QDltMsg &)
+void FiletransferPlugin::initMsgDecoded(qint64 , QDltMsg &)
 {
 //empty. Implemented because derived plugin interface functions are virtual.
 }
@@ -201,14 +201,14 @@ void FiletransferPlugin::updateFileStart()
 //empty. Implemented because derived plugin interface functions are virtual.
 }
 
-void FiletransferPlugin::updateMsg(int index, QDltMsg &msg)
+void FiletransferPlugin::updateMsg(qint64 index, QDltMsg &msg)
 {
   // this function is called when a dlt file is read
     updateFiletransfer(index,msg);
   // end of void function
 }
 
-void FiletransferPlugin::updateMsgDecoded(int , QDltMsg &)
+void FiletransferPlugin::updateMsgDecoded(qint64 , QDltMsg &)
 {//empty. Implemented because derived plugin interface functions are virtual.
 }
 
@@ -216,7 +216,7 @@ void FiletransferPlugin::updateFileFinish(){
 
 }
 
-void FiletransferPlugin::updateFiletransfer(int index, QDltMsg &msg)
+void FiletransferPlugin::updateFiletransfer(qint64 index, QDltMsg &msg)
 {
 
 
@@ -352,7 +352,7 @@ void FiletransferPlugin::doFLST(QDltMsg *msg)
   return;
 }
 
-void FiletransferPlugin::doFLDA(int index,QDltMsg *msg)
+void FiletransferPlugin::doFLDA(qint64 index,QDltMsg *msg)
 {
     QDltArgument argument;
     msg->getArgument(PROTOCOL_FLDA_FILEID,argument);
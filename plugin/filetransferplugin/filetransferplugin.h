@@ -57,16 +57,16 @@ public:
     QWidget* initViewer();
     void initFileStart(QDltFile *file);
     void initFileFinish();
-    void initMsg(int index, QDltMsg &msg);
-    void initMsgDecoded(int index, QDltMsg &msg);
+    void initMsg(qint64 index, QDltMsg &msg);
+    void initMsgDecoded(qint64 index, QDltMsg &msg);
     void updateFileStart();
-    void updateMsg(int index, QDltMsg &msg);
-    void updateMsgDecoded(int index, QDltMsg &msg);
+    void updateMsg(qint64 index, QDltMsg &msg);
+    void updateMsgDecoded(qint64 index, QDltMsg &msg);
     void updateFileFinish();
-    void selectedIdxMsg(int index, QDltMsg &msg);
-    void selectedIdxMsgDecoded(int index, QDltMsg &msg);
+    void selectedIdxMsg(qint64 index, QDltMsg &msg);
+    void selectedIdxMsgDecoded(qint64 index, QDltMsg &msg);
 
-    void updateFiletransfer(int index, QDltMsg &msg);
+    void updateFiletransfer(qint64 index, QDltMsg &msg);
     void show(bool value);
 
     /* QDltPluginCommandInterface */
@@ -90,7 +90,7 @@ private:
     bool plugin_is_active = false;
 
     void doFLST(QDltMsg *msg);
-    void doFLDA(int index, QDltMsg *msg);
+    void doFLDA(qint64 index, QDltMsg *msg);
     void doFLFI(QDltMsg *msg);
     void doFLIF(QDltMsg *msg);
     void doFLER(QDltMsg *msg);
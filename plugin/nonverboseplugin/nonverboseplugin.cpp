@@ -377,7 +377,7 @@ bool NonverbosePlugin::parseFile(QString filename)
                   {
                       if (framemap.contains(frame->id))
                       {
-                            if( framemapwithkey.contains(DltFibexKey(frame->id,frame->appid,frame->ctid)))
+                            if( framemapwithkey.contains(DltFibexKey(frame->id,QDltId(frame->appid),QDltId(frame->ctid))))
                             {
                                 // do not add frame, if Id, appid and ctid already exist
                                 // show warning instead
@@ -387,12 +387,12 @@ bool NonverbosePlugin::parseFile(QString filename)
                             }
                             else
                             {
-                                framemapwithkey[DltFibexKey(frame->id,frame->appid,frame->ctid)] = frame;
+                                framemapwithkey[DltFibexKey(frame->id,QDltId(frame->appid),QDltId(frame->ctid))] = frame;
                             }
                       }
                       else
                       {
-                            framemapwithkey[DltFibexKey(frame->id,frame->appid,frame->ctid)] = frame;
+                            framemapwithkey[DltFibexKey(frame->id,QDltId(frame->appid),QDltId(frame->ctid))] = frame;
                             framemap[frame->id] = frame;
                       }
                       frame = 0;
@@ -502,9 +502,9 @@ bool NonverbosePlugin::isMsg(QDltMsg &msg, int triggeredByUser)
 
     QString idtext = QString("ID_%1").arg(msg.getMessageId());
 
-    if(!msg.getApid().isEmpty() && !msg.getCtid().isEmpty())
+    if(!msg.getApidId().isEmpty() && !msg.getCtidId().isEmpty())
         // search in full key, if msg already contains AppId and CtId
-        return framemapwithkey.contains(DltFibexKey(idtext,msg.getApid(),msg.getCtid()));
+        return framemapwithkey.contains(DltFibexKey(idtext,msg.getApidId(),msg.getCtidId()));
     else
         // search only for id
         return framemap.contains(idtext);
@@ -528,15 +528,15 @@ bool NonverbosePlugin::decodeMsg(QDltMsg &msg, int triggeredByUser)
 
     QString idtext = QString("ID_%1").arg(msg.getMessageId());
     DltFibexFrame *frame;
-    if(!msg.getApid().isEmpty() && !msg.getCtid().isEmpty())
+    if(!msg.getApidId().isEmpty() && !msg.getCtidId().isEmpty())
     {
         // search in full key, if msg already contains AppId and CtId
-        frame = framemapwithkey[DltFibexKey(idtext,msg.getApid(),msg.getCtid())];
+        frame = framemapwithkey.value(DltFibexKey(idtext,msg.getApidId(),msg.getCtidId()));
     }
     else
     {
         // search only for id
-        frame = framemap[idtext];
+        frame = framemap.value(idtext);
     }
     if(!frame)
             return false;
@@ -544,11 +544,11 @@ bool NonverbosePlugin::decodeMsg(QDltMsg &msg, int triggeredByUser)
     /* set message data */
 
     // set ApId only if it is empty
-    if(msg.getApid().isEmpty())
+    if(msg.getApidId().isEmpty())
         msg.setApid(frame->appid);
 
     // set Context Id only if it is empty
-    if(msg.getCtid().isEmpty())
+    if(msg.getCtidId().isEmpty())
         msg.setCtid(frame->ctid);
 
     msg.setNumberOfArguments(frame->pdureflist.size());
@@ -604,6 +604,12 @@ bool NonverbosePlugin::decodeMsg(QDltMsg &msg, int triggeredByUser)
     return true;
 }
 
+bool NonverbosePlugin::isThreadSafe()
+{
+    /* the Fibex data is only read while decoding */
+    return true;
+}
+
 #ifndef QT5
 Q_EXPORT_PLUGIN2(nonverboseplugin, NonverbosePlugin);
 #endif
@@ -35,7 +35,7 @@
 class DltFibexKey
 {
 public:
-    DltFibexKey(QString id,QString appid,QString ctid)
+    DltFibexKey(QString id,QDltId appid,QDltId ctid)
     {
         this->id = id;
         this->appid = appid;
@@ -46,8 +46,8 @@ public:
     friend uint qHash(const DltFibexKey &key);
 
     QString id;
-    QString appid;
-    QString ctid;
+    QDltId appid;
+    QDltId ctid;
 };
 
 inline bool operator==(const DltFibexKey &e1, const DltFibexKey &e2)
@@ -126,6 +126,7 @@ public:
     /* QDltPluginDecoderInterface */
     bool isMsg(QDltMsg &msg, int triggeredByUser);
     bool decodeMsg(QDltMsg &msg, int triggeredByUser);
+    bool isThreadSafe();
 
     /* Faster lookup */
     //is it necessary that this is public?
@@ -137,6 +137,8 @@ public:
     //! Decode the message and provide back the decoded message.
     /*!
       The plugin converts the DLT message.
+      If isThreadSafe() returns true, this method and isMsg() are called from
+      several threads at the same time for different messages.
       Errors should be reported by providing an error message.
       \sa QDLTPluginInterface::error()
       \param msg The current DLT message and the decoded message information.
@@ -145,10 +147,18 @@ public:
     */
     virtual bool decodeMsg(QDltMsg &msg, int triggeredByUser) = 0;
 
+    //! Check if messages can be decoded by several threads at the same time.
+    /*!
+      The plugin must not change its state in isMsg() and decodeMsg(), or must
+      protect it, e.g. if it is also changed by updateMsg() of a viewer plugin.
+      \return True if isMsg() and decodeMsg() can be called from several threads at the same time. False if messages are decoded by one thread only.
+    */
+    virtual bool isThreadSafe() = 0;
+
 };
 
 Q_DECLARE_INTERFACE(QDLTPluginDecoderInterface,
-                    "org.genivi.DLT.Plugin.DLTViewerPluginDecoderInterface/1.0");
+                    "org.genivi.DLT.Plugin.DLTViewerPluginDecoderInterface/1.1");
 
 //! Extended DLT Viewer Plugin Interface used by viewer plugins.
 /*!
@@ -187,7 +197,7 @@ public:
       \param index The current DLT message index
       \param msg The current undecoded DLT message
     */
-    virtual void initMsg(int index, QDltMsg &msg ) = 0;
+    virtual void initMsg(qint64 index, QDltMsg &msg ) = 0;
 
     //! A new decoded DLT message is processed after a new log file is opened by the DLT Viewer
     /*! After a new log file is opened this function is called by the viewer every time
@@ -196,7 +206,7 @@ public:
       \param index The current DLT message index
       \param msg The current decoded DLT message
     */
-    virtual void initMsgDecoded(int index, QDltMsg &msg ) = 0;
+    virtual void initMsgDecoded(qint64 index, QDltMsg &msg ) = 0;
 
     //! A new log file was opened by the DLT Viewer.
     /*! This function is called by the the viewer every time a new log file was opened by the viewer
@@ -223,7 +233,7 @@ public:
       \param index The current DLT message index
       \param msg The current undecoded DLT message
     */
-    virtual void updateMsg(int index, QDltMsg &msg ) = 0;
+    virtual void updateMsg(qint64 index, QDltMsg &msg ) = 0;
 
 
     //! New message were added to the log file.
@@ -233,7 +243,7 @@ public:
       \param index The current DLT message index
       \param msg The current decoded DLT message
     */
-    virtual void updateMsgDecoded(int index, QDltMsg &msg ) = 0;
+    virtual void updateMsgDecoded(qint64 index, QDltMsg &msg ) = 0;
 
 
     //! A new message was received after updateMsg and updateMsgDecoded.
@@ -251,7 +261,7 @@ public:
       \param index The current DLT message index
       \param msg The current undecoded DLT message
     */
-    virtual void selectedIdxMsg(int index, QDltMsg &msg) = 0;
+    virtual void selectedIdxMsg(qint64 index, QDltMsg &msg) = 0;
 
 
     //! A decoded log message was selected to show more detailed information.
@@ -260,12 +270,12 @@ public:
       \param index The current DLT message index
       \param msg The current decoded DLT message
     */
-    virtual void selectedIdxMsgDecoded(int index, QDltMsg &msg) = 0;
+    virtual void selectedIdxMsgDecoded(qint64 index, QDltMsg &msg) = 0;
 
 };
 
 Q_DECLARE_INTERFACE(QDltPluginViewerInterface,
-                    "org.genivi.DLT.Plugin.DLTViewerPluginViewerInterface/1.2");
+                    "org.genivi.DLT.Plugin.DLTViewerPluginViewerInterface/1.3");
 
 //! Extended DLT Control Plugin Interface used by control plugins.
 /*!
@@ -25,12 +25,21 @@
 #include <qdltbase.h>
 
 #include <qdltargument.h>
+#include <qdltid.h>
 #include <qdltmsg.h>
+#include <qdltmsgcache.h>
+#include <qdltregexp.h>
+#include <qdltmultimatcher.h>
 #include <qdltfilter.h>
 #include <qdltfilterlist.h>
+#include <qdltindex.h>
+#include <qdltbitmap.h>
 #include <qdltfilterindex.h>
 #include <qdltdefaultfilter.h>
+#include <qdltmetadata.h>
+#include <qdltfilescanner.h>
 #include <qdltfile.h>
+#include <qdltfilecursor.h>
 #include <qdltcontrol.h>
 #include <qdltconnection.h>
 #include <qdltipconnection.h>
@@ -60,8 +60,17 @@ SOURCES +=  \
     qdltudpconnection.cpp \
     qdltserialconnection.cpp \
     qdltmsg.cpp \
+    qdltmsgcache.cpp \
+    qdltregexp.cpp \
+    qdltmultimatcher.cpp \
     qdltfilter.cpp \
     qdltfile.cpp \
+    qdltfilecursor.cpp \
+    qdltfilescanner.cpp \
+    qdltindex.cpp \
+    qdltbitmap.cpp \
+    qdltid.cpp \
+    qdltmetadata.cpp \
     qdltcontrol.cpp \
     qdltconnection.cpp \
     qdltbase.cpp \
@@ -83,8 +92,17 @@ HEADERS += qdlt.h \
     qdltudpconnection.h \
     qdltserialconnection.h \
     qdltmsg.h \
+    qdltmsgcache.h \
+    qdltregexp.h \
+    qdltmultimatcher.h \
     qdltfilter.h \
     qdltfile.h \
+    qdltfilecursor.h \
+    qdltfilescanner.h \
+    qdltindex.h \
+    qdltbitmap.h \
+    qdltid.h \
+    qdltmetadata.h \
     qdltcontrol.h \
     qdltconnection.h \
     qdltbase.h \
@@ -46,6 +46,10 @@ int QDltArgument::getOffsetPayload() const
 
 QByteArray QDltArgument::getData() const
 {
+   /* never hand out a reference to the buffer, it could outlive the argument */
+   if(!buffer.isNull())
+       return QByteArray(data.constData(),data.size());
+
    return data;
 }
 
@@ -77,7 +81,18 @@ QString QDltArgument::getTypeInfoString() const
     return QString(qDltTypeInfo[typeInfo]);
 }
 
-bool QDltArgument::setArgument(QByteArray &payload,unsigned int &offset,DltEndiannessDef _endianess)
+static QByteArray argumentData(const QByteArray &payload,unsigned int offset,int length,const QByteArray &buffer)
+{
+    if(buffer.isNull())
+        return payload.mid(offset,length);
+
+    /* reference the data in the buffer, truncated like mid() */
+    if(offset >= (unsigned int)payload.size())
+        return QByteArray();
+    return QByteArray::fromRawData(payload.constData()+offset,qMin(length,payload.size()-(int)offset));
+}
+
+bool QDltArgument::setArgument(QByteArray &payload,unsigned int &offset,DltEndiannessDef _endianess,const QByteArray &_buffer)
 {
     unsigned short length=0,length2=0,length3=0;
 
@@ -90,6 +105,9 @@ bool QDltArgument::setArgument(QByteArray &payload,unsigned int &offset,DltEndia
     /* store new endianness */
     endianness = _endianess;
 
+    /* keep the referenced buffer */
+    buffer = _buffer;
+
     /* get type info */
     if((unsigned int)payload.size()<(offset+sizeof(unsigned int)))
         return false;
@@ -194,12 +212,12 @@ bool QDltArgument::setArgument(QByteArray &payload,unsigned int &offset,DltEndia
     {
         if((unsigned int)payload.size()<(offset+length))
             return false;
-        data = payload.mid(offset,length);
+        data = argumentData(payload,offset,length,buffer);
         offset += length;
     }
     else if(typeInfo == DltTypeInfoBool)
     {
-        data = payload.mid(offset,1);
+        data = argumentData(payload,offset,1,buffer);
         offset += 1;
     }
     else if(typeInfo == DltTypeInfoSInt || typeInfo == DltTypeInfoUInt)
@@ -208,31 +226,31 @@ bool QDltArgument::setArgument(QByteArray &payload,unsigned int &offset,DltEndia
         {
             case DLT_TYLE_8BIT:
             {
-                data = payload.mid(offset,1);
+                data = argumentData(payload,offset,1,buffer);
                 offset += 1;
                 break;
             }
             case DLT_TYLE_16BIT:
             {
-                data = payload.mid(offset,2);
+                data = argumentData(payload,offset,2,buffer);
                 offset += 2;
                 break;
             }
             case DLT_TYLE_32BIT:
             {
-                data = payload.mid(offset,4);
+                data = argumentData(payload,offset,4,buffer);
                 offset += 4;
                 break;
             }
             case DLT_TYLE_64BIT:
             {
-                data = payload.mid(offset,8);
+                data = argumentData(payload,offset,8,buffer);
                 offset += 8;
                 break;
             }
             case DLT_TYLE_128BIT:
             {
-                data = payload.mid(offset,16);
+                data = argumentData(payload,offset,16,buffer);
                 offset += 16;
                 break;
             }
@@ -249,31 +267,31 @@ bool QDltArgument::setArgument(QByteArray &payload,unsigned int &offset,DltEndia
         {
             case DLT_TYLE_8BIT:
             {
-                data = payload.mid(offset,1);
+                data = argumentData(payload,offset,1,buffer);
                 offset += 1;
                 break;
             }
             case DLT_TYLE_16BIT:
              {
-                data = payload.mid(offset,2);
+                data = argumentData(payload,offset,2,buffer);
                 offset += 2;
                 break;
             }
             case DLT_TYLE_32BIT:
             {
-                data = payload.mid(offset,4);
+                data = argumentData(payload,offset,4,buffer);
                 offset += 4;
                 break;
             }
             case DLT_TYLE_64BIT:
             {
-                data = payload.mid(offset,8);
+                data = argumentData(payload,offset,8,buffer);
                 offset += 8;
                 break;
             }
             case DLT_TYLE_128BIT:
             {
-                data = payload.mid(offset,16);
+                data = argumentData(payload,offset,16,buffer);
                 offset += 16;
                 break;
             }
@@ -372,6 +390,7 @@ void QDltArgument::clear()
     typeInfo = QDltArgument::DltTypeInfoUnknown;
     offsetPayload = 0;
     data.clear();
+    buffer.clear();
     name.clear();
     unit.clear();
     endianness = QDltArgument::DltEndiannessUnknown;
@@ -393,12 +412,12 @@ QString QDltArgument::toString(bool binary) const
         break;
     case DltTypeInfoStrg:
         if(data.size()) {
-            text += QString("%1").arg(QString(getData()));
+            text += QString("%1").arg(QString(data));
         }
         break;
     case DltTypeInfoUtf8:
         if(data.size()) {
-            text += QString::fromUtf8(data.data());
+            text += QString::fromUtf8(data.constData(),qstrnlen(data.constData(),data.size()));
         }
         break;
     case DltTypeInfoBool:
@@ -542,7 +561,7 @@ QVariant QDltArgument::getValue() const
         break;
     case DltTypeInfoUtf8:
         if(data.size()) {
-            return QVariant(QString::fromUtf8(data.data()));
+            return QVariant(QString::fromUtf8(data.constData(),qstrnlen(data.constData(),data.size())));
         }
         break;
     case DltTypeInfoBool:
@@ -626,7 +645,7 @@ QVariant QDltArgument::getValue() const
         }
         break;
     case DltTypeInfoRawd:
-        return QVariant(data);
+        return QVariant(getData());
         break;
     case DltTypeInfoTrai:
         break;
@@ -161,9 +161,11 @@ public:
       \param payload This can be a filename or a directory name.
       \param offset Offset where to start parsing in the payload.
       \param _endianess The new endianness of the argument
+      \param _buffer If not null, the payload references this buffer and the data of the argument
+      references it too without copying.
       \return The name of the unit of the variable.
     */
-    bool setArgument(QByteArray &payload,unsigned int &offset,DltEndiannessDef _endianess);
+    bool setArgument(QByteArray &payload,unsigned int &offset,DltEndiannessDef _endianess,const QByteArray &_buffer = QByteArray());
 
     //! Get argument as byte array and appends it to data.
     /*!
@@ -206,6 +208,9 @@ private:
     //! This data of the argument.
     QByteArray data;
 
+    //! Buffer referenced by data, if the argument was parsed without copying.
+    QByteArray buffer;
+
     //! This name of the argument.
     /*!
       This is an optional parameter.
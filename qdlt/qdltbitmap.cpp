@@ -0,0 +1,457 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltbitmap.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+
+#include <algorithm>
+#include <iterator>
+#include <QtAlgorithms>
+
+#include "qdltbitmap.h"
+
+static int countBits(const QVector<quint64> &bitmap)
+{
+    int count = 0;
+    for(int num=0;num<bitmap.size();num++)
+        count += qPopulationCount(bitmap[num]);
+    return count;
+}
+
+bool QDltBitmap::Container::contains(quint16 value) const
+{
+    if(isBitmap())
+        return (bitmap[value >> 6] >> (value & 63)) & 1;
+    return std::binary_search(array.constBegin(), array.constEnd(), value);
+}
+
+void QDltBitmap::Container::add(quint16 value)
+{
+    if(isBitmap())
+    {
+        quint64 &word = bitmap[value >> 6];
+        quint64 bit = Q_UINT64_C(1) << (value & 63);
+        if(!(word & bit))
+        {
+            word |= bit;
+            count++;
+        }
+        return;
+    }
+
+    if(array.isEmpty() || array.last() < value)
+    {
+        /* values are usually added in increasing order */
+        array.append(value);
+    }
+    else
+    {
+        QVector<quint16>::iterator it = std::lower_bound(array.begin(), array.end(), value);
+        if(*it == value)
+            return;
+        array.insert(it, value);
+    }
+    count++;
+
+    if(count > arrayMaxSize)
+        toBitmap();
+}
+
+void QDltBitmap::Container::optimize()
+{
+    if(isBitmap() && count <= arrayMaxSize)
+        toArray();
+    else if(!isBitmap() && count > arrayMaxSize)
+        toBitmap();
+}
+
+void QDltBitmap::Container::toBitmap()
+{
+    if(isBitmap())
+        return;
+
+    bitmap.fill(0, words);
+    for(int num=0;num<array.size();num++)
+        bitmap[array[num] >> 6] |= Q_UINT64_C(1) << (array[num] & 63);
+    array.clear();
+}
+
+void QDltBitmap::Container::toArray()
+{
+    if(!isBitmap())
+        return;
+
+    array.clear();
+    array.reserve(count);
+    for(int num=0;num<words;num++)
+    {
+        quint64 word = bitmap[num];
+        while(word)
+        {
+            quint64 lowest = word & (~word + 1);
+            array.append(static_cast<quint16>((num << 6) + qPopulationCount(lowest - 1)));
+            word &= word - 1;
+        }
+    }
+    bitmap.clear();
+}
+
+QDltBitmap::QDltBitmap()
+{
+}
+
+qint64 QDltBitmap::cardinality() const
+{
+    qint64 count = 0;
+    for(int num=0;num<containers.size();num++)
+        count += containers[num].count;
+    return count;
+}
+
+void QDltBitmap::clear()
+{
+    containers.clear();
+}
+
+int QDltBitmap::findContainer(quint32 key) const
+{
+    int first = 0;
+    int count = containers.size();
+
+    while(count > 0)
+    {
+        int step = count / 2;
+        if(containers[first + step].key < key)
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+
+    return first;
+}
+
+void QDltBitmap::add(qint64 value)
+{
+    quint32 key = static_cast<quint32>(value >> 16);
+    int pos;
+
+    if(!containers.isEmpty() && containers.last().key == key)
+    {
+        pos = containers.size() - 1;
+    }
+    else if(containers.isEmpty() || containers.last().key < key)
+    {
+        containers.append(Container(key));
+        pos = containers.size() - 1;
+    }
+    else
+    {
+        pos = findContainer(key);
+        if(containers[pos].key != key)
+            containers.insert(pos, Container(key));
+    }
+
+    containers[pos].add(static_cast<quint16>(value & 0xffff));
+}
+
+bool QDltBitmap::contains(qint64 value) const
+{
+    quint32 key = static_cast<quint32>(value >> 16);
+    int pos = findContainer(key);
+
+    if(pos == containers.size() || containers[pos].key != key)
+        return false;
+
+    return containers[pos].contains(static_cast<quint16>(value & 0xffff));
+}
+
+void QDltBitmap::unite(const QDltBitmap &other)
+{
+    QVector<Container> result;
+    int pos = 0, otherPos = 0;
+
+    result.reserve(containers.size() + other.containers.size());
+    while(pos < containers.size() || otherPos < other.containers.size())
+    {
+        if(otherPos == other.containers.size() || (pos < containers.size() && containers[pos].key < other.containers[otherPos].key))
+        {
+            result.append(containers[pos++]);
+            continue;
+        }
+        if(pos == containers.size() || other.containers[otherPos].key < containers[pos].key)
+        {
+            result.append(other.containers[otherPos++]);
+            continue;
+        }
+
+        Container container = containers[pos++];
+        const Container &otherContainer = other.containers[otherPos++];
+
+        if(!container.isBitmap() && !otherContainer.isBitmap() && container.count + otherContainer.count <= arrayMaxSize)
+        {
+            /* merge both sorted arrays */
+            QVector<quint16> array;
+            array.reserve(container.count + otherContainer.count);
+            std::set_union(container.array.constBegin(), container.array.constEnd(),
+                           otherContainer.array.constBegin(), otherContainer.array.constEnd(), std::back_inserter(array));
+            container.array = array;
+            container.count = array.size();
+        }
+        else
+        {
+            container.toBitmap();
+            if(otherContainer.isBitmap())
+            {
+                for(int num=0;num<Container::words;num++)
+                    container.bitmap[num] |= otherContainer.bitmap[num];
+            }
+            else
+            {
+                for(int num=0;num<otherContainer.array.size();num++)
+                    container.bitmap[otherContainer.array[num] >> 6] |= Q_UINT64_C(1) << (otherContainer.array[num] & 63);
+            }
+            container.count = countBits(container.bitmap);
+            container.optimize();
+        }
+        result.append(container);
+    }
+
+    containers = result;
+}
+
+void QDltBitmap::intersect(const QDltBitmap &other)
+{
+    QVector<Container> result;
+    int otherPos = 0;
+
+    for(int pos=0;pos<containers.size();pos++)
+    {
+        const Container &container = containers[pos];
+
+        while(otherPos < other.containers.size() && other.containers[otherPos].key < container.key)
+            otherPos++;
+        if(otherPos == other.containers.size())
+            break;
+        if(other.containers[otherPos].key != container.key)
+            continue;
+
+        const Container &otherContainer = other.containers[otherPos];
+        Container intersection(container.key);
+
+        if(container.isBitmap() && otherContainer.isBitmap())
+        {
+            intersection.bitmap.resize(Container::words);
+            for(int num=0;num<Container::words;num++)
+                intersection.bitmap[num] = container.bitmap[num] & otherContainer.bitmap[num];
+            intersection.count = countBits(intersection.bitmap);
+            intersection.optimize();
+        }
+        else
+        {
+            /* check the values of the array against the other container */
+            const Container &arrayContainer = container.isBitmap() ? otherContainer : container;
+            const Container &checkContainer = container.isBitmap() ? container : otherContainer;
+            for(int num=0;num<arrayContainer.array.size();num++)
+                if(checkContainer.contains(arrayContainer.array[num]))
+                    intersection.array.append(arrayContainer.array[num]);
+            intersection.count = intersection.array.size();
+        }
+
+        if(intersection.count > 0)
+            result.append(intersection);
+    }
+
+    containers = result;
+}
+
+void QDltBitmap::subtract(const QDltBitmap &other)
+{
+    QVector<Container> result;
+    int otherPos = 0;
+
+    result.reserve(containers.size());
+    for(int pos=0;pos<containers.size();pos++)
+    {
+        while(otherPos < other.containers.size() && other.containers[otherPos].key < containers[pos].key)
+            otherPos++;
+        if(otherPos == other.containers.size() || other.containers[otherPos].key != containers[pos].key)
+        {
+            result.append(containers[pos]);
+            continue;
+        }
+
+        Container container = containers[pos];
+        const Container &otherContainer = other.containers[otherPos];
+
+        if(!container.isBitmap())
+        {
+            QVector<quint16> array;
+            for(int num=0;num<container.array.size();num++)
+                if(!otherContainer.contains(container.array[num]))
+                    array.append(container.array[num]);
+            container.array = array;
+            container.count = array.size();
+        }
+        else if(otherContainer.isBitmap())
+        {
+            for(int num=0;num<Container::words;num++)
+                container.bitmap[num] &= ~otherContainer.bitmap[num];
+            container.count = countBits(container.bitmap);
+            container.optimize();
+        }
+        else
+        {
+            for(int num=0;num<otherContainer.array.size();num++)
+                container.bitmap[otherContainer.array[num] >> 6] &= ~(Q_UINT64_C(1) << (otherContainer.array[num] & 63));
+            container.count = countBits(container.bitmap);
+            container.optimize();
+        }
+
+        if(container.count > 0)
+            result.append(container);
+    }
+
+    containers = result;
+}
+
+void QDltBitmap::appendTo(QDltIndex &index) const
+{
+    index.reserve(index.size() + cardinality());
+
+    for(int pos=0;pos<containers.size();pos++)
+    {
+        const Container &container = containers[pos];
+        qint64 base = static_cast<qint64>(container.key) << 16;
+
+        if(!container.isBitmap())
+        {
+            for(int num=0;num<container.array.size();num++)
+                index.append(base + container.array[num]);
+            continue;
+        }
+
+        for(int num=0;num<Container::words;num++)
+        {
+            quint64 word = container.bitmap[num];
+            while(word)
+            {
+                quint64 lowest = word & (~word + 1);
+                index.append(base + (num << 6) + qPopulationCount(lowest - 1));
+                word &= word - 1;
+            }
+        }
+    }
+}
+
+bool QDltBitmap::write(QIODevice &device) const
+{
+    qint32 size = containers.size();
+
+    if(device.write((const char*) &size, sizeof(size)) != sizeof(size))
+        return false;
+
+    for(int pos=0;pos<containers.size();pos++)
+    {
+        const Container &container = containers[pos];
+        qint64 length;
+
+        if(device.write((const char*) &container.key, sizeof(container.key)) != sizeof(container.key))
+            return false;
+        if(device.write((const char*) &container.count, sizeof(container.count)) != sizeof(container.count))
+            return false;
+
+        /* the kind of the container follows from the number of values */
+        if(container.isBitmap())
+        {
+            length = Container::words * sizeof(quint64);
+            if(device.write((const char*) container.bitmap.constData(), length) != length)
+                return false;
+        }
+        else
+        {
+            length = container.count * sizeof(quint16);
+            if(device.write((const char*) container.array.constData(), length) != length)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool QDltBitmap::read(QIODevice &device)
+{
+    qint32 size;
+
+    clear();
+
+    if(device.read((char*) &size, sizeof(size)) != sizeof(size) || size < 0)
+        return false;
+
+    containers.reserve(size);
+    for(int pos=0;pos<size;pos++)
+    {
+        Container container;
+        qint64 length;
+
+        if(device.read((char*) &container.key, sizeof(container.key)) != sizeof(container.key) ||
+           device.read((char*) &container.count, sizeof(container.count)) != sizeof(container.count) ||
+           container.count <= 0 || container.count > 65536 ||
+           (!containers.isEmpty() && containers.last().key >= container.key))
+        {
+            clear();
+            return false;
+        }
+
+        if(container.count > arrayMaxSize)
+        {
+            container.bitmap.resize(Container::words);
+            length = Container::words * sizeof(quint64);
+            if(device.read((char*) container.bitmap.data(), length) != length || countBits(container.bitmap) != container.count)
+            {
+                clear();
+                return false;
+            }
+        }
+        else
+        {
+            container.array.resize(container.count);
+            length = container.count * sizeof(quint16);
+            if(device.read((char*) container.array.data(), length) != length)
+            {
+                clear();
+                return false;
+            }
+        }
+
+        containers.append(container);
+    }
+
+    return true;
+}
+
+qint64 QDltBitmap::memoryUsage() const
+{
+    qint64 usage = containers.capacity() * sizeof(Container);
+    for(int pos=0;pos<containers.size();pos++)
+        usage += containers[pos].array.capacity() * sizeof(quint16) + containers[pos].bitmap.capacity() * sizeof(quint64);
+    return usage;
+}
@@ -0,0 +1,119 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltbitmap.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+
+#ifndef QDLT_BITMAP_H
+#define QDLT_BITMAP_H
+
+#include <QVector>
+#include <QIODevice>
+
+#include "export_rules.h"
+#include "qdltindex.h"
+
+//! Compressed set of message numbers.
+/*!
+  The bitmap is split into containers of 65536 numbers, like a roaring bitmap.
+  Containers with few numbers store them as a sorted array of 16 bit values,
+  containers with more than arrayMaxSize numbers as a bitmap of 8 KByte.
+  Sparse and dense sets both need much less memory than a list of 64 bit numbers,
+  and sets can be combined container by container.
+  Const functions can be called from several threads at once.
+*/
+class QDLT_EXPORT QDltBitmap
+{
+public:
+    //! Maximum number of values of an array container.
+    static const int arrayMaxSize = 4096;
+
+    //! The constructor.
+    QDltBitmap();
+
+    //! Check if the bitmap is empty.
+    bool isEmpty() const { return containers.isEmpty(); }
+
+    //! Get the number of values in the bitmap.
+    qint64 cardinality() const;
+
+    //! Remove all values.
+    void clear();
+
+    //! Add a value, adding values in increasing order is fastest.
+    /*!
+      \param value The value, must not be negative.
+    */
+    void add(qint64 value);
+
+    //! Check if the bitmap contains a value.
+    bool contains(qint64 value) const;
+
+    //! Add all values of another bitmap.
+    void unite(const QDltBitmap &other);
+
+    //! Remove all values which are not in another bitmap.
+    void intersect(const QDltBitmap &other);
+
+    //! Remove all values which are in another bitmap.
+    void subtract(const QDltBitmap &other);
+
+    //! Append all values in increasing order to an index.
+    void appendTo(QDltIndex &index) const;
+
+    //! Write the bitmap to a cache file.
+    bool write(QIODevice &device) const;
+
+    //! Read the bitmap from a cache file.
+    bool read(QIODevice &device);
+
+    //! Get the memory used by the bitmap in bytes.
+    qint64 memoryUsage() const;
+
+private:
+    //! Values with the same upper bits.
+    class Container
+    {
+    public:
+        static const int words = 65536 / 64;
+
+        Container() : key(0), count(0) {}
+        explicit Container(quint32 key) : key(key), count(0) {}
+
+        bool isBitmap() const { return !bitmap.isEmpty(); }
+        bool contains(quint16 value) const;
+        void add(quint16 value);
+
+        //! Convert between array and bitmap depending on the number of values.
+        void optimize();
+
+        void toBitmap();
+        void toArray();
+
+        quint32 key;
+        int count;
+        QVector<quint16> array;
+        QVector<quint64> bitmap;
+    };
+
+    int findContainer(quint32 key) const;
+
+    //! Sorted by key.
+    QVector<Container> containers;
+};
+
+#endif // QDLT_BITMAP_H
@@ -65,6 +65,7 @@ void QDltConnection::clear()
 {
     data.clear();
     dataView.align(data);
+    scanPosition = 0;
     bytesReceived = 0;
     bytesError = 0;
     syncFound = 0;
@@ -74,123 +75,148 @@ void QDltConnection::add(const QByteArray &bytes)
 {
     bytesReceived += bytes.size();
 
-    data = dataView + bytes;
+    int consumed = data.size() - dataView.size();
+    int remaining = dataView.size();
 
-    dataView.align(data);
+    /* drop the parsed data, when there is not less of it than data left */
+    if(consumed > 0 && consumed >= remaining)
+    {
+        if(remaining > 0)
+            memmove(data.data(), data.constData() + consumed, remaining);
+        data.resize(remaining);
+        consumed = 0;
+    }
+
+    /* grows the buffer geometrically, messages parsed before are invalid now */
+    data.append(bytes);
+
+    dataView.align(data, consumed);
 }
 
-bool QDltConnection::parse(QDltMsg &msg)
+int QDltConnection::findSerialHeader(int from, int to)
 {
-    /* if sync to serial header search for header */
-    int found = 0;
-    int firstPos = 0;
-    int secondPos = 0;
+    const char *cbuf = dataView.constData();
 
-    char lastFound = 0;
+    if(from < 0)
+        from = 0;
 
-    /* Use primitive buffer for faster access */
-    int cbuf_sz = dataView.size();
-    const char *cbuf = dataView.constData();
+    for(int num=from;num+4<=to;num++)
+    {
+        if(cbuf[num] == 'D' && cbuf[num+1] == 'L' && cbuf[num+2] == 'S' && cbuf[num+3] == 0x01)
+            return num;
+    }
 
-    /* find marker in buffer */
-    for(int num=0;num<cbuf_sz;num++) {
-        if(cbuf[num] == 'D')
-        {
-            lastFound = 'D';
-        }
-        else if(lastFound == 'D' && cbuf[num] == 'L')
-        {
-            lastFound = 'L';
-        }
-        else if(lastFound == 'L' && cbuf[num] == 'S')
-        {
-            lastFound = 'S';
-        }
-        else if(lastFound == 'S' && cbuf[num] == 0x01)
-        {
-            /* header found */
-            found++;
-            if(found==1)
-            {
-                firstPos = num+1;
-                syncFound++;
-            }
-            if(found==2)
-            {
-                secondPos = num+1;
-                break;
-            }
-            lastFound = 0;
-        }
-        else
+    return -1;
+}
+
+/* Size of a message starting with the standard header, -1 if the standard header is not complete */
+static int messageSize(const char *cbuf, int cbuf_sz)
+{
+    if(cbuf_sz < (int)sizeof(DltStandardHeader))
+        return -1;
+
+    const DltStandardHeader *standardheader = (const DltStandardHeader*) cbuf;
+    int headersize = sizeof(DltStandardHeader) + DLT_STANDARD_HEADER_EXTRA_SIZE(standardheader->htyp) +
+            (DLT_IS_HTYP_UEH(standardheader->htyp) ? sizeof(DltExtendedHeader) : 0);
+    int len = DLT_SWAP_16(standardheader->len);
+
+    /* a length smaller than the header is handled like QDltMsg::setMsg() */
+    return qMax(len, headersize);
+}
+
+bool QDltConnection::parse(QDltMsg &msg)
+{
+    if(!syncSerialHeader)
+    {
+        /* optional serial header */
+        int firstPos = 0;
+        if(dataView.size() >= 4 && findSerialHeader(0, 4) == 0)
+            firstPos = 4;
+
+        int size = messageSize(dataView.constData() + firstPos, dataView.size() - firstPos);
+        if(size < 0 || dataView.size() < firstPos + size)
         {
-            lastFound = 0;
+            /* no complete msg found */
+            /* perhaps not completely received */
+            return false;
         }
-        if((!syncSerialHeader) && num==3)
-            break;
-    }
 
-    if(syncSerialHeader && !found)
-    {
-        /* complete sync header not found */
-        if(!lastFound)
+        /* reference the message in the buffer */
+        if(!msg.setMsg(dataView.mid(firstPos, size), false, false, true))
         {
-            /* clear buffer if even not start of sync header found */
+            /* no valid msg found, without serial header there is nothing to sync to */
             bytesError += dataView.size();
             dataView.clear();
+            return false;
         }
-        return false;
-    }
 
-    //qDebug() << "found " << found << " firstPos " << firstPos << " secondPos " << secondPos;
+        if(firstPos)
+            syncFound++;
 
-    if(found==2)
+        /* msg read successful */
+        dataView.advance(firstPos + size);
+        return true;
+    }
+
+    for(;;)
     {
-        /* two sync headers found */
-        /* try to read msg */
-        if(!msg.setMsg(dataView.mid(firstPos,secondPos-firstPos-4),false))
+        /* the view starts with a serial header after it was found */
+        if(dataView.size() < 4 || findSerialHeader(0, 4) != 0)
         {
-            /* no valid msg found, perhaps to short */
-            dataView.advance(secondPos-4);
+            int pos = findSerialHeader(scanPosition, dataView.size());
+            if(pos < 0)
+            {
+                /* keep only what could be the start of a serial header */
+                int keep = qMin(dataView.size(), 3);
+                bytesError += dataView.size() - keep;
+                dataView.advance(dataView.size() - keep);
+                scanPosition = 0;
+                return false;
+            }
+
             /* errors found */
-            bytesError += secondPos-4;
-            return false;
+            bytesError += pos;
+            dataView.advance(pos);
+            scanPosition = 4;
         }
-        else
+
+        /* the message ends at the next serial header, if it is shorter than its length */
+        int size = messageSize(dataView.constData() + 4, dataView.size() - 4);
+        int end = (size < 0) ? dataView.size() : qMin(dataView.size(), 4 + size);
+        int next = findSerialHeader(qMax(4, scanPosition), end);
+        if(next >= 0)
         {
-            /* msg read successful */
-            dataView.advance(secondPos-4);
-            if(firstPos>4)
-                /* errors found */
-                bytesError += firstPos-4;
-            return true;
+            /* no valid msg found, perhaps to short */
+            bytesError += next;
+            dataView.advance(next);
+            scanPosition = 4;
+            syncFound++;
+            continue;
         }
 
-    }
+        /* a serial header could start in the last three bytes */
+        scanPosition = qMax(4, end - 3);
 
-    if(firstPos>4)
-        /* errors found */
-        bytesError += firstPos-4;
+        if(size < 0 || end < 4 + size)
+        {
+            /* msg not completely received */
+            return false;
+        }
 
-    /* try to read msg */
-    if(!msg.setMsg(dataView.mid(firstPos),false))
-    {
-        /* no complete msg found */
-        /* perhaps not completely received */
-        /* check valid size */
-        if(dataView.size()>DLT_MAX_MESSAGE_LEN)
+        syncFound++;
+        scanPosition = 0;
+
+        /* reference the message in the buffer */
+        if(!msg.setMsg(dataView.mid(4, size), false, false, true))
         {
-            /* size exceeds max DLT message size */
-            /* clear buffer */
-            /* errors found */
-            bytesError += dataView.size();
-            dataView.clear();
+            /* no valid msg found, skip to the next serial header */
+            bytesError += 4 + size;
+            dataView.advance(4 + size);
+            continue;
         }
-        return false;
-    }
 
-    /* msg read successful */
-    dataView.advance(firstPos+msg.getHeaderSize()+msg.getPayloadSize());
-    return true;
+        /* msg read successful */
+        dataView.advance(4 + size);
+        return true;
+    }
 }
-
@@ -99,11 +99,27 @@ public:
     void setSyncSerialHeader(bool _syncSerialHeader);
     bool getSyncSerialHeader() const;
 
+    //! Get the next complete message from the received data.
+    /*!
+      Parsing resumes where the last incomplete message stopped.
+      The message references the received data without copying it,
+      it is only valid until add() or clear() is called.
+      \param msg The parsed message.
+      \return true if a message was parsed, false if more data is needed.
+    */
     bool parse(QDltMsg &msg);
 
     void clear();
+
+    //! Add received data.
+    /*!
+      The data is appended behind the data not parsed yet. The parsed data is
+      dropped, when it is not less than the data left, so each byte is moved
+      at most once on average.
+    */
     void add(const QByteArray &bytes);
 
+    //! Received data, the data not parsed yet starts at the beginning of dataView.
     QByteArray data;
     QDltDataView dataView = {data};
 
@@ -116,7 +132,17 @@ protected:
     bool sendSerialHeader;
     bool syncSerialHeader;
 
-
+private:
+    //! Find a serial header in the data not parsed yet.
+    /*!
+      \param from Position where the search starts.
+      \param to Position where the search ends.
+      \return Position of the serial header, -1 if it was not found.
+    */
+    int findSerialHeader(int from, int to);
+
+    //! Position in the data not parsed yet, where the search for the next serial header continues.
+    int scanPosition;
 
 };
 
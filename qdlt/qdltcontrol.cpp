@@ -34,8 +34,8 @@ QDltControl::QDltControl(QObject *_server)
 
     connect(this, SIGNAL(sendInjectionSignal(int,QString,QString,int,QByteArray)),
             server, SLOT(sendInjection(int,QString,QString,int,QByteArray)));
-    connect(this, SIGNAL(jumpToMsgSignal(int)),
-            server, SLOT(jumpToMsgSignal(int)));
+    connect(this, SIGNAL(jumpToMsgSignal(qint64)),
+            server, SLOT(jumpToMsgSignal(qint64)));
     connect(this, SIGNAL(markerSignal()),
             server, SLOT(markerSignal()));
     connect(this, SIGNAL(connectEcuSignal(int)),
@@ -66,7 +66,7 @@ void QDltControl::sendInjection(int index,QString applicationId,QString contextI
     emit sendInjectionSignal(index,applicationId,contextId,serviceId,data);
 }
 
-void QDltControl::jumpToMsg(int index)
+void QDltControl::jumpToMsg(qint64 index)
 {
     emit jumpToMsgSignal(index);
 }
@@ -40,7 +40,7 @@ public:
     ~QDltControl();
 
     void sendInjection(int index,QString applicationId,QString contextId,int serviceId,QByteArray data);
-    void jumpToMsg(int index);
+    void jumpToMsg(qint64 index);
 
     void newFile(QString filename);
     void openFile(QStringList filenames);
@@ -56,7 +56,7 @@ public:
 
 signals:
     void sendInjectionSignal(int index,QString applicationId,QString contextId,int serviceId,QByteArray data);
-    void jumpToMsgSignal(int index);
+    void jumpToMsgSignal(qint64 index);
     void newFileSignal(QString filename);
     void openFileSignal(QStringList filenames);
     void saveAsFileSignal(QString filename);
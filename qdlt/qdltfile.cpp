@@ -24,6 +24,13 @@
 
 #include "qdlt.h"
 
+#ifdef Q_OS_UNIX
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
 extern "C"
 {
 #include "dlt_common.h"
@@ -33,6 +40,7 @@ QDltFile::QDltFile()
 {
     filterFlag = false;
     sortByTimeFlag = false;
+    memoryMappingFlag = false;
 }
 
 QDltFile::~QDltFile()
@@ -44,12 +52,19 @@ void QDltFile::clear()
 {
     for(int num=0;num<files.size();num++)
     {
+        if(files[num]->mapping) {
+            files[num]->infile.unmap(files[num]->mapping);
+            files[num]->mapping = 0;
+        }
         if(files[num]->infile.isOpen()) {
              files[num]->infile.close();
         }
         delete(files[num]);
     }
     files.clear();
+
+    /* message numbers are not valid anymore */
+    msgCache.clear();
 }
 
 int QDltFile::getNumberOfFiles() const
@@ -57,16 +72,34 @@ int QDltFile::getNumberOfFiles() const
     return files.size();
 }
 
-void QDltFile::setDltIndex(QVector<qint64> &_indexAll, int num){
+void QDltFile::setDltIndex(const QDltIndex &_indexAll, int num){
     if(num<0 || num>=files.size())
         return;
 
     files[num]->indexAll = _indexAll;
 }
 
-int QDltFile::size() const
+void QDltFile::setDltMetadata(const QDltFileMetadata &_metadata, int num){
+    if(num<0 || num>=files.size())
+        return;
+
+    files[num]->metadata = _metadata;
+}
+
+bool QDltFile::hasMetadata() const
 {
-    int size=0;
+    for(int num=0;num<files.size();num++)
+    {
+        if(files[num]->metadata.size() != files[num]->indexAll.size())
+            return false;
+    }
+
+    return true;
+}
+
+qint64 QDltFile::size() const
+{
+    qint64 size=0;
 
     for(int num=0;num<files.size();num++)
     {
@@ -88,7 +121,7 @@ qint64 QDltFile::fileSize() const
     return size;
 }
 
-int QDltFile::sizeFilter() const
+qint64 QDltFile::sizeFilter() const
 {
     if(filterFlag)
         return indexFilter.size();
@@ -118,6 +151,15 @@ bool QDltFile::open(QString _filename, bool append) {
         return false;
     }
 
+    /* map the log file, if mapping fails the file is read */
+    if(memoryMappingFlag && item->infile.size() > 0) {
+        item->mapping = item->infile.map(0,item->infile.size());
+        if(item->mapping)
+            item->mappingSize = item->infile.size();
+        else
+            qDebug() << "mapping of file" << _filename << "failed";
+    }
+
     //qDebug() << "Open file" << _filename << "finished";
 
     return true;
@@ -128,6 +170,7 @@ void QDltFile::clearIndex()
     for(int num=0;num<files.size();num++)
     {
         files[num]->indexAll.clear();
+        files[num]->metadata.clear();
     }
 }
 
@@ -152,8 +195,7 @@ bool QDltFile::createIndex()
 
 bool QDltFile::updateIndex()
 {
-    QByteArray buf;
-    qint64 pos = 0;
+    QDltFileScanner scanner;
 
     mutexQDlt.lock();
 
@@ -166,63 +208,17 @@ bool QDltFile::updateIndex()
             return false;
         }
 
+        /* keep metadata only if it is complete */
+        QDltFileMetadata *metadata = 0;
+        if(files[numFile]->metadata.size() == files[numFile]->indexAll.size())
+            metadata = &files[numFile]->metadata;
 
-        /* start at last found position */
-        if(files[numFile]->indexAll.size()) {
-            /* move behind last found position */
-            const QVector<qint64>* const_indexAll = &(files[numFile]->indexAll);
-            pos = (*const_indexAll)[files[numFile]->indexAll.size()-1] + 4;
-            files[numFile]->infile.seek(pos);
-        }
-        else {
-            /* the file was empty the last call */
-            files[numFile]->infile.seek(0);
-        }
+        /* continue at the last found message */
+        scanner.reset(QDltFileScanner::resumeIndex(files[numFile]->indexAll, metadata));
 
-        /* Align kbytes, 1MB read at a time */
-        static const int READ_BUF_SZ = 1024 * 1024;
-
-        /* walk through the whole file and find all DLT0x01 markers */
+        /* walk through the rest of the file and find all DLT0x01 markers */
         /* store the found positions in the indexAll */
-        char lastFound = 0;
-
-        while(true) {
-
-            /* read buffer from file */
-            buf = files[numFile]->infile.read(READ_BUF_SZ);
-            if(buf.isEmpty())
-                break; // EOF
-
-            /* Use primitive buffer for faster access */
-            int cbuf_sz = buf.size();
-            const char *cbuf = buf.constData();
-
-            /* find marker in buffer */
-            for(int num=0;num<cbuf_sz;num++) {
-                if(cbuf[num] == 'D')
-                {
-                    lastFound = 'D';
-                }
-                else if(lastFound == 'D' && cbuf[num] == 'L')
-                {
-                    lastFound = 'L';
-                }
-                else if(lastFound == 'L' && cbuf[num] == 'T')
-                {
-                    lastFound = 'T';
-                }
-                else if(lastFound == 'T' && cbuf[num] == 0x01)
-                {
-                    files[numFile]->indexAll.append(pos+num-3);
-                    lastFound = 0;
-                }
-                else
-                {
-                    lastFound = 0;
-                }
-            }
-            pos += cbuf_sz;
-        }
+        while(scanner.scanFile(files[numFile]->infile, files[numFile]->indexAll, metadata));
     }
 
     mutexQDlt.unlock();
@@ -231,6 +227,68 @@ bool QDltFile::updateIndex()
     return true;
 }
 
+qint64 QDltFile::appendMsg(qint64 position, const QByteArray &buf)
+{
+    QMutexLocker locker(&mutexQDlt);
+
+    if(files.isEmpty() || !files.last()->infile.isOpen())
+        return -1;
+
+    QDltFileItem *file = files.last();
+
+    /* the message must follow the last message in the index, else messages would be missing */
+    qint64 end = indexedEnd(file);
+    if(position != end)
+        return -1;
+
+    /* keep metadata only if it is complete */
+    if(file->metadata.size() == file->indexAll.size())
+        file->metadata.append(buf.constData(),buf.size());
+
+    file->indexAll.append(position);
+    file->appendPosition = position;
+    file->appendEnd = position + buf.size();
+
+    return size() - 1;
+}
+
+qint64 QDltFile::indexedFileSize(int num) const
+{
+    QMutexLocker locker(&mutexQDlt);
+
+    if(num<0 || num>=files.size())
+        return -1;
+
+    return indexedEnd(files[num]);
+}
+
+qint64 QDltFile::indexedEnd(QDltFileItem *file) const
+{
+    if(file->indexAll.size() == 0)
+        return 0;
+
+    qint64 last = file->indexAll.last();
+    if(last == file->appendPosition)
+        return file->appendEnd;
+
+    /* the last message was found by updateIndex(), get its size from the headers */
+    char buffer[sizeof(DltStorageHeader) + sizeof(DltStandardHeader)];
+    const char *header = buffer;
+    if(file->mapping && last + (qint64)sizeof(buffer) <= file->mappingSize)
+    {
+        header = (const char*)file->mapping + last;
+    }
+    else
+    {
+        file->infile.seek(last);
+        if(file->infile.read(buffer, sizeof(buffer)) != sizeof(buffer))
+            return -1;
+    }
+    const DltStandardHeader *standardheader = (const DltStandardHeader *) (header + sizeof(DltStorageHeader));
+
+    return last + sizeof(DltStorageHeader) + DLT_SWAP_16(standardheader->len);
+}
+
 bool QDltFile::createIndexFilter()
 {
     /* clear old index */
@@ -243,22 +301,25 @@ bool QDltFile::updateIndexFilter()
 {
     QDltMsg msg;
     QByteArray buf;
-    int index;
+    qint64 index;
 
     /* update index filter by starting from last found index in list */
 
     /* get lattest found index in filter list */
     if(indexFilter.size()>0) {
-        index = indexFilter[indexFilter.size()-1] + 1;
+        index = indexFilter.last() + 1;
     }
     else {
         index = 0;
     }
 
-    for(int num=index;num<size();num++) {
-        buf = getMsg(num);
+    /* new messages are read in order */
+    QDltFileCursor cursor(this);
+    qint64 count = size();
+    for(qint64 num=index;num<count;num++) {
+        buf = cursor.getMsg(num);
         if(!buf.isEmpty()) {
-            msg.setMsg(buf);
+            msg.setMsg(buf,true,true,true);
             if(checkFilter(msg)) {
                 indexFilter.append(num);
             }
@@ -296,7 +357,7 @@ void QDltFile::clearFilterIndex()
 
 }
 
-void QDltFile::addFilterIndex (int index)
+void QDltFile::addFilterIndex (qint64 index)
 {
     indexFilter.append(index);
 
@@ -312,6 +373,16 @@ QString QDltFile::checkMarker(QDltMsg &msg)
     return filterList.checkMarker(msg);
 }
 
+QString QDltFile::checkMarker(QDltMsgCacheEntry &entry)
+{
+    if(!filterFlag)
+    {
+        return QString(DEFAULT_COLOR);
+    }
+
+    return filterList.checkMarker(entry);
+}
+
 QString QDltFile::getFileName(int num)
 {
     if(num<0 || num>=files.size())
@@ -320,24 +391,78 @@ QString QDltFile::getFileName(int num)
     return files[num]->infile.fileName();
 }
 
+void QDltFile::enableMemoryMapping(bool state)
+{
+    memoryMappingFlag = state;
+}
+
+bool QDltFile::isMemoryMapping() const
+{
+    return memoryMappingFlag;
+}
+
+void QDltFile::setAccessHint(AccessHint hint)
+{
+#ifdef Q_OS_UNIX
+    int advice = POSIX_MADV_NORMAL;
+    if(hint == AccessSequential)
+        advice = POSIX_MADV_SEQUENTIAL;
+    else if(hint == AccessRandom)
+        advice = POSIX_MADV_RANDOM;
+
+#ifdef Q_OS_LINUX
+    int fileAdvice = POSIX_FADV_NORMAL;
+    if(hint == AccessSequential)
+        fileAdvice = POSIX_FADV_SEQUENTIAL;
+    else if(hint == AccessRandom)
+        fileAdvice = POSIX_FADV_RANDOM;
+#endif
+
+    for(int num=0;num<files.size();num++)
+    {
+        if(files[num]->mapping)
+            posix_madvise(files[num]->mapping, files[num]->mappingSize, advice);
+#ifdef Q_OS_LINUX
+        if(files[num]->infile.isOpen())
+            posix_fadvise(files[num]->infile.handle(), 0, 0, fileAdvice);
+#endif
+    }
+#else
+    Q_UNUSED(hint);
+#endif
+}
+
 void QDltFile::close()
 {
     /* close file */
     clear();
 }
 
-QByteArray QDltFile::getMsg(int index) const
+QByteArray QDltFile::getMsg(qint64 index) const
 {
-    QByteArray buf;
-    int num;
+    QDltFileItem *file;
+    qint64 position, size;
+
+    if(!findMsg(index, file, position, size))
+        /* return empty data buffer */
+        return QByteArray();
+
+    /* return DLT message from the mapping without copying */
+    if(file->mapping && position + size <= file->mappingSize)
+        return QByteArray::fromRawData((const char*)file->mapping + position, size);
 
+    /* read DLT message from file */
+    return readMsg(file, position, size);
+}
+
+bool QDltFile::findMsg(qint64 index, QDltFileItem *&file, qint64 &position, qint64 &size) const
+{
+    int num;
 
     /* check if index is in range */
     if(index<0 ) {
         qDebug() << "getMsg: Index is out of range";
-
-        /* return empty data buffer */
-        return QByteArray();
+        return false;
     }
 
     for(num=0;num<files.size();num++)
@@ -351,54 +476,116 @@ QByteArray QDltFile::getMsg(int index) const
     if(num>=files.size())
     {
         qDebug() << "getMsg: Index is out of range";
-
-        /* return empty data buffer */
-        return QByteArray();
+        return false;
     }
 
     /* check if file is already opened */
     if(!files[num]->infile.isOpen()) {
-        /* return empty buffer */
         qDebug() << "getMsg: Infile is not open";
-
-        /* return empty data buffer */
-        return QByteArray();
+        return false;
     }
 
-    mutexQDlt.lock();
-
-    QDltFileItem* file = files[num];
+    file = files[num];
     const QDltFileItem* const_file = file;
-    qint64 positionForIndex = const_file->indexAll[index];
+    qint64 positionNext;
 
-    /* move to file position selected by index */
-    file->infile.seek(positionForIndex);
+    position = const_file->indexAll[index];
 
-    /* read DLT message from file */
     if(index == (file->indexAll.size()-1))
         /* last message in file */
-        buf = file->infile.read(file->infile.size() - positionForIndex);
+        positionNext = file->infile.size();
     else
         /* any other file position */
-        buf = file->infile.read(const_file->indexAll[index+1] - positionForIndex);
+        positionNext = const_file->indexAll[index+1];
 
-    mutexQDlt.unlock();
+    size = positionNext - position;
+
+    return true;
+}
+
+QByteArray QDltFile::readMsg(QDltFileItem *file, qint64 position, qint64 size) const
+{
+    QByteArray buf;
+
+    buf.resize(static_cast<int>(size));
+    qint64 length = readData(file, position, buf.data(), size);
+    if(length < 0) {
+        qDebug() << "getMsg: Read failed";
+        return QByteArray();
+    }
+    buf.resize(static_cast<int>(length));
 
     /* return DLT message buffer */
     return buf;
 }
 
-bool QDltFile::getMsg(int index,QDltMsg &msg) const
+qint64 QDltFile::readData(QDltFileItem *file, qint64 position, char *data, qint64 size) const
+{
+#ifdef Q_OS_UNIX
+    /* positioned read does not change the file position, no locking needed */
+    qint64 length = 0;
+
+    /* pread may return less than requested or be interrupted, read until end of file */
+    while(length < size)
+    {
+        ssize_t bytes = ::pread(file->infile.handle(), data + length, size - length, position + length);
+        if(bytes < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            return -1;
+        }
+        if(bytes == 0)
+            break;
+        length += bytes;
+    }
+
+    return length;
+#else
+    mutexQDlt.lock();
+
+    /* move to file position and read data from file */
+    file->infile.seek(position);
+    qint64 length = file->infile.read(data, size);
+
+    mutexQDlt.unlock();
+
+    return length;
+#endif
+}
+
+bool QDltFile::getMsgMetadata(qint64 index,QDltMsgMetadata &metadata) const
+{
+    int num;
+
+    if(index<0)
+        return false;
+
+    for(num=0;num<files.size();num++)
+    {
+        if(index<files[num]->indexAll.size())
+            break;
+        else
+            index -= files[num]->indexAll.size();
+    }
+
+    if(num>=files.size())
+        return false;
+
+    return files[num]->metadata.getMetadata(index, metadata);
+}
+
+bool QDltFile::getMsg(qint64 index,QDltMsg &msg,bool lazyArguments,bool zeroCopy) const
 {
     QByteArray data = getMsg(index);
 
     if(data.isEmpty())
         return false;
 
-    return msg.setMsg(data);
+    return msg.setMsg(data,true,lazyArguments,zeroCopy);
 }
 
-QByteArray QDltFile::getMsgFilter(int index) const
+QByteArray QDltFile::getMsgFilter(qint64 index) const
 {
     if(filterFlag) {
         /* check if index is in range */
@@ -422,7 +609,7 @@ QByteArray QDltFile::getMsgFilter(int index) const
     }
 }
 
-int QDltFile::getMsgFilterPos(int index) const
+qint64 QDltFile::getMsgFilterPos(qint64 index) const
 {
     if(filterFlag) {
         /* check if index is in range */
@@ -476,12 +663,12 @@ void QDltFile::enableSortByTime(bool state)
     sortByTimeFlag = state;
 }
 
-QVector<qint64> QDltFile::getIndexFilter() const
+QDltIndex QDltFile::getIndexFilter() const
 {
     return indexFilter;
 }
 
-void QDltFile::setIndexFilter(QVector<qint64> _indexFilter)
+void QDltFile::setIndexFilter(const QDltIndex &_indexFilter)
 {
     indexFilter = _indexFilter;
 }
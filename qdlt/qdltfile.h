@@ -31,29 +31,58 @@
 #include <time.h>
 
 #include "export_rules.h"
+#include "qdltindex.h"
+#include "qdltmetadata.h"
+#include "qdltmsgcache.h"
 
 class QDLT_EXPORT QDltFileItem
 {
 public:
+    QDltFileItem() : mapping(0), mappingSize(0), appendPosition(-1), appendEnd(0) {}
+
     //! DLT log file.
     QFile infile;
 
+    //! Memory mapping of the DLT log file, 0 if the file is not mapped.
+    uchar *mapping;
+
+    //! Size of the memory mapping.
+    /*!
+      Messages appended to the file after it was mapped are read from the file.
+    */
+    qint64 mappingSize;
+
     //! Index of all DLT messages.
     /*!
       Index contains positions of beginning of DLT messages in DLT log file.
     */
-    QVector<qint64> indexAll;
+    QDltIndex indexAll;
+
+    //! Header metadata of all DLT messages.
+    /*!
+      Metadata contains one entry for each entry in indexAll, or is empty if not available.
+    */
+    QDltFileMetadata metadata;
+
+    //! Position and end of the message last added by QDltFile::appendMsg(), -1 if none.
+    qint64 appendPosition;
+    qint64 appendEnd;
 
 };
 
 //! Access to a DLT log file.
 /*!
   This class provide access to DLT log file.
-  This class is currently not thread safe.
+  This class is currently not thread safe, except reading messages with getMsg(),
+  which can be done from several threads at once, if the file is memory mapped
+  or on Unix systems.
 */
 class QDLT_EXPORT QDltFile : public QDlt
 {
 public:
+    //! Access pattern hints given to the operating system.
+    typedef enum { AccessNormal, AccessSequential, AccessRandom } AccessHint;
+
     //! The constructor.
     /*!
     */
@@ -73,7 +102,7 @@ public:
     /*!
       \return the number of all DLT messages in the currently opened DLT file.
     */
-    int size() const;
+    qint64 size() const;
 
     //! Get the file size of the DLT log file.
     /*!
@@ -81,11 +110,19 @@ public:
     */
     qint64 fileSize() const;
 
+    //! Get the size of the part of a DLT log file which is indexed.
+    /*!
+      A file which is still written may already be larger.
+      \param num The number of the file.
+      \return the end of the last indexed message, -1 if the file does not exist or cannot be read.
+    */
+    qint64 indexedFileSize(int num) const;
+
     //! Get the number of filtered DLT message in the DLT log file.
     /*!
       \return the number of filtered DLT messages in the currently opened DLT file.
     */
-    int sizeFilter() const;
+    qint64 sizeFilter() const;
 
     //! Open a DLT log file.
     /*!
@@ -95,6 +132,28 @@ public:
     */
     bool open(QString _filename,bool append = false);
 
+    //! Enable or disable memory mapping of files opened afterwards.
+    /*!
+      If a file is memory mapped, getMsg() returns byte arrays which reference the mapping
+      without copying the data. These are only valid as long as the file is opened.
+      Files which cannot be mapped are read with positioned reads instead.
+      The file must not be truncated while it is mapped.
+      \param state true if memory mapping is enabled, false if disabled
+    */
+    void enableMemoryMapping(bool state);
+
+    //! Get the status of memory mapping.
+    /*!
+      \return true if memory mapping is enabled, false if disabled
+    */
+    bool isMemoryMapping() const;
+
+    //! Give a hint to the operating system how the messages will be accessed.
+    /*!
+      \param hint AccessSequential before walking through all messages, AccessRandom for random access.
+    */
+    void setAccessHint(AccessHint hint);
+
     //! Close teh currently opened DLT log file.
     /*!
     */
@@ -104,7 +163,19 @@ public:
     /*!
       \param New index list of all DLT messages
     */
-    void setDltIndex(QVector<qint64> &_indexAll, int num = 0);
+    void setDltIndex(const QDltIndex &_indexAll, int num = 0);
+
+    //! Sets the header metadata of all DLT messages.
+    /*!
+      \param _metadata New metadata with one entry for each message in the index
+    */
+    void setDltMetadata(const QDltFileMetadata &_metadata, int num = 0);
+
+    //! Check if the header metadata is available for all DLT messages.
+    /*!
+      \return true if getMsgMetadata() can be used for all messages.
+    */
+    bool hasMetadata() const;
 
     //! Clears the internal index of all DLT messages.
     /*!
@@ -123,6 +194,18 @@ public:
     */
     bool updateIndex();
 
+    //! Add a message to the index, which was written to the last opened DLT log file.
+    /*!
+      Used instead of updateIndex() by the writer of the file, which knows the position
+      of each written message, so the file is not read again.
+      The message must already be written to the file and must follow the last message
+      in the index directly, otherwise updateIndex() must be used to find the messages in between.
+      \param position The position of the message in the file.
+      \param buf The message beginning with the storage header.
+      \return The number of the message, -1 if the message does not follow the last message in the index or no file is opened.
+    */
+    qint64 appendMsg(qint64 position, const QByteArray &buf);
+
     //! Create an internal index of all filtered DLT messages of the currently opened DLT log file.
     /*!
       \return true if the operation was successful, false if an error occurred.
@@ -137,33 +220,45 @@ public:
 
     //! Get one message of the DLT log file.
     /*!
-      This function retrieves on DLT message of the log file
+      This function retrieves on DLT message of the log file.
+      Use QDltFileCursor to read many messages in order.
       \param index The number of the DLT message in the DLT file starting from zero.
       \param msg The message which contains the DLT message after the function returns.
+      \param lazyArguments decode the arguments on first access, see QDltMsg::setMsg().
+      \param zeroCopy reference the message data instead of copying it, see QDltMsg::setMsg().
+      If the file is memory mapped, the message is only valid as long as the file is opened.
       \return true if the message is valid, false if an error occurred.
     */
-    bool getMsg(int index,QDltMsg &msg) const;
+    bool getMsg(qint64 index,QDltMsg &msg,bool lazyArguments = false,bool zeroCopy = false) const;
 
     //! Get one DLT message of the DLT log file selected by index
     /*!
       \param index position of the DLT message in the log file up to the number DLT messages in the file
       \return Byte array containing the complete DLT message.
     */
-    QByteArray getMsg(int index) const;
+    QByteArray getMsg(qint64 index) const;
+
+    //! Get the header information of one DLT message without reading the DLT log file.
+    /*!
+      \param index The number of the DLT message in the DLT file starting from zero.
+      \param metadata The header information of the DLT message.
+      \return true if the metadata is available, false if the message has to be read with getMsg().
+    */
+    bool getMsgMetadata(qint64 index,QDltMsgMetadata &metadata) const;
 
     //! Get one DLT message of the filtered DLT log file selected by index
     /*!
       \param index position of the DLT message in the log file up to the number of DLT messages in the file
       \return Byte array containing the complete DLT message.
     */
-    QByteArray getMsgFilter(int index) const;
+    QByteArray getMsgFilter(qint64 index) const;
 
     //! Get the position in the log file of the filtered DLT log file selected by index
     /*!
       \param index position of the DLT message in the log file up to the number of DLT messages in the file
       \return real position in log file, -1 if invalid.
     */
-    int getMsgFilterPos(int index) const;
+    qint64 getMsgFilterPos(qint64 index) const;
 
     //! Delete all filters and markers.
     /*!
@@ -228,7 +323,7 @@ public:
     /*!
       \param index The position of the message in the allIndex to be added
     */
-    void addFilterIndex (int index);
+    void addFilterIndex (qint64 index);
 
     //! Check if message will be marked.
     /*!
@@ -244,6 +339,20 @@ public:
     */
     QString checkMarker(QDltMsg &msg);
 
+    //! Check if a message with already printed header and payload text will be marked.
+    /*!
+      \param entry The message to be marked
+      \return 0 if message will not be marked, colour if message will be marked
+    */
+    QString checkMarker(QDltMsgCacheEntry &entry);
+
+    //! Get the cache of decoded messages of the opened files.
+    /*!
+      The cache is cleared when the files are closed.
+      \return the cache, which can be used from several threads at once.
+    */
+    QDltMsgCache &getMsgCache() const { return msgCache; }
+
     //! Get file name of the underlying file object
     /*!
      * \return File name
@@ -254,20 +363,40 @@ public:
     /*!
      * \return List of file positions
      **/
-    QVector<qint64> getIndexFilter() const;
+    QDltIndex getIndexFilter() const;
 
     //! Set Index of all DLT messages matching filter
     /*!
      * \param _indexFilter List of file positions
      **/
-    void setIndexFilter(QVector<qint64> _indexFilter);
+    void setIndexFilter(const QDltIndex &_indexFilter);
 
 protected:
 
 private:
+    friend class QDltFileCursor;
+
+    //! Find the file, position and size of a DLT message.
+    bool findMsg(qint64 index, QDltFileItem *&file, qint64 &position, qint64 &size) const;
+
+    //! Read a DLT message from a file which is not memory mapped.
+    QByteArray readMsg(QDltFileItem *file, qint64 position, qint64 size) const;
+
+    //! Read data from a file which is not memory mapped.
+    /*!
+      \return Number of bytes read, -1 if an error occurred.
+    */
+    qint64 readData(QDltFileItem *file, qint64 position, char *data, qint64 size) const;
+
+    //! Get the end of the last indexed message of a file, mutexQDlt must be locked.
+    qint64 indexedEnd(QDltFileItem *file) const;
+
     //! Mutex to lock critical path for infile
     mutable QMutex mutexQDlt;
 
+    //! Recently used decoded messages.
+    mutable QDltMsgCache msgCache;
+
     //!all files including indexes
     QList<QDltFileItem*> files;
 
@@ -275,7 +404,7 @@ private:
     /*!
       Index contains positions of DLT messages in indexAll.
     */
-    QVector<qint64> indexFilter;
+    QDltIndex indexFilter;
 
     //! This contains the list of filters.
     QDltFilterList filterList;
@@ -293,6 +422,13 @@ private:
       false sorting is disabled.
     */
     bool sortByTimeFlag;
+
+    //! Enabling memory mapping.
+    /*!
+      true memory mapping is enabled.
+      false memory mapping is disabled.
+    */
+    bool memoryMappingFlag;
 };
 
 
@@ -0,0 +1,120 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltfilecursor.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+
+#include <QtDebug>
+
+#include "qdlt.h"
+
+QDltFileCursor::QDltFileCursor(const QDltFile *file, qint64 blockSize)
+    : file(file),
+      blockSize(blockSize),
+      blockFile(0),
+      blockPosition(0),
+      blockReads(0)
+{
+}
+
+void QDltFileCursor::reset()
+{
+    block.clear();
+    blockFile = 0;
+    blockPosition = 0;
+}
+
+QByteArray QDltFileCursor::getMsg(qint64 index)
+{
+    QDltFileItem *item;
+    qint64 position, size;
+
+    if(!file->findMsg(index, item, position, size))
+        return QByteArray();
+
+    /* return DLT message from the mapping without copying */
+    if(item->mapping && position + size <= item->mappingSize)
+        return QByteArray::fromRawData((const char*)item->mapping + position, size);
+
+    /* read the next block, if the message is not in the current one */
+    if(item != blockFile || position < blockPosition || position + size > blockPosition + block.size())
+    {
+        if(!readBlock(item, position, size))
+            return QByteArray();
+    }
+
+    /* the block is overwritten by the next read, the message is copied */
+    return QByteArray(block.constData() + (position - blockPosition), static_cast<int>(size));
+}
+
+bool QDltFileCursor::getMsg(qint64 index, QDltMsg &msg, bool lazyArguments, bool zeroCopy)
+{
+    QByteArray data = getMsg(index);
+
+    if(data.isEmpty())
+        return false;
+
+    return msg.setMsg(data,true,lazyArguments,zeroCopy);
+}
+
+QByteArray QDltFileCursor::getMsgFilter(qint64 index)
+{
+    if(file->filterFlag) {
+        /* check if index is in range */
+        if(index<0 || index>=file->indexFilter.size()) {
+            qDebug() << "getMsgFilter: Index is out of range";
+            return QByteArray();
+        }
+        return getMsg(file->indexFilter[index]);
+    }
+
+    return getMsg(index);
+}
+
+bool QDltFileCursor::readBlock(QDltFileItem *item, qint64 position, qint64 size)
+{
+    qint64 begin = position;
+    qint64 length = qMax(blockSize, size);
+
+    /* walking backwards, read the block in front of the message */
+    if(item == blockFile && position < blockPosition)
+        begin = qMax((qint64) 0, position + size - length);
+
+    length = qMin(length, item->infile.size() - begin);
+    if(length < position + size - begin)
+    {
+        qDebug() << "getMsg: Read failed";
+        reset();
+        return false;
+    }
+
+    block.resize(static_cast<int>(length));
+    length = file->readData(item, begin, block.data(), length);
+    if(length < position + size - begin)
+    {
+        qDebug() << "getMsg: Read failed";
+        reset();
+        return false;
+    }
+
+    block.resize(static_cast<int>(length));
+    blockFile = item;
+    blockPosition = begin;
+    blockReads++;
+
+    return true;
+}
@@ -0,0 +1,98 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltfilecursor.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+
+#ifndef QDLT_FILE_CURSOR_H
+#define QDLT_FILE_CURSOR_H
+
+#include <QByteArray>
+
+#include "export_rules.h"
+
+class QDltFile;
+class QDltFileItem;
+class QDltMsg;
+
+//! Sequential read access to the messages of a DLT log file.
+/*!
+  QDltFile::getMsg() reads each message with its own system call. The cursor
+  reads large blocks instead and slices the messages out of the current block,
+  so walking through all messages in order, forward or backward, needs only
+  one read per block. Messages of memory mapped files are taken from the mapping
+  as with QDltFile::getMsg().
+  A cursor must only be used by one thread and not after the file was closed.
+*/
+class QDLT_EXPORT QDltFileCursor
+{
+public:
+    //! Default number of bytes read at once.
+    static const qint64 defaultBlockSize = 4 * 1024 * 1024;
+
+    //! The constructor.
+    /*!
+      \param file The DLT log file to be read.
+      \param blockSize Number of bytes read at once.
+    */
+    QDltFileCursor(const QDltFile *file, qint64 blockSize = defaultBlockSize);
+
+    //! Get one DLT message of the DLT log file selected by index.
+    /*!
+      \param index The number of the DLT message in the DLT file starting from zero.
+      \return Byte array containing the complete DLT message, empty if an error occurred.
+    */
+    QByteArray getMsg(qint64 index);
+
+    //! Get one message of the DLT log file.
+    /*!
+      \param index The number of the DLT message in the DLT file starting from zero.
+      \param msg The message which contains the DLT message after the function returns.
+      \param lazyArguments decode the arguments on first access, see QDltMsg::setMsg().
+      \param zeroCopy reference the message data instead of copying it, see QDltMsg::setMsg().
+      \return true if the message is valid, false if an error occurred.
+    */
+    bool getMsg(qint64 index, QDltMsg &msg, bool lazyArguments = false, bool zeroCopy = false);
+
+    //! Get one DLT message of the filtered DLT log file selected by index.
+    /*!
+      \param index The number of the DLT message in the filter index.
+      \return Byte array containing the complete DLT message, empty if an error occurred.
+    */
+    QByteArray getMsgFilter(qint64 index);
+
+    //! Drop the current block, e.g. after the file was appended.
+    void reset();
+
+    //! Number of blocks read so far.
+    qint64 getBlockReads() const { return blockReads; }
+
+private:
+    bool readBlock(QDltFileItem *item, qint64 position, qint64 size);
+
+    const QDltFile *file;
+    qint64 blockSize;
+
+    //! The current block, read from blockFile at blockPosition.
+    QByteArray block;
+    QDltFileItem *blockFile;
+    qint64 blockPosition;
+
+    qint64 blockReads;
+};
+
+#endif // QDLT_FILE_CURSOR_H
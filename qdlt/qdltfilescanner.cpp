@@ -0,0 +1,391 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltfilescanner.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <string.h>
+
+#include "qdltfilescanner.h"
+
+extern "C"
+{
+#include "dlt_common.h"
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define QDLT_SCANNER_X86
+#define QDLT_SCANNER_TARGET(arch) __attribute__((target(arch)))
+#include <immintrin.h>
+static inline int scannerFirstBit(unsigned int mask) { return __builtin_ctz(mask); }
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define QDLT_SCANNER_X86
+#define QDLT_SCANNER_TARGET(arch)
+#include <intrin.h>
+#include <immintrin.h>
+static inline int scannerFirstBit(unsigned int mask) { unsigned long bit; _BitScanForward(&bit, mask); return (int)bit; }
+#endif
+
+static inline bool isMarker(const char *data)
+{
+    return data[0] == 'D' && data[1] == 'L' && data[2] == 'T' && data[3] == 0x01;
+}
+
+static const char *findMarkerScalar(const char *data, const char *end)
+{
+    while(end - data >= 4)
+    {
+        /* memchr is vectorised by most C libraries */
+        const char *found = (const char *) memchr(data, 'D', end - data - 3);
+        if(!found)
+            return 0;
+        if(isMarker(found))
+            return found;
+        data = found + 1;
+    }
+    return 0;
+}
+
+#ifdef QDLT_SCANNER_X86
+
+QDLT_SCANNER_TARGET("sse2")
+static const char *findMarkerSse2(const char *data, const char *end)
+{
+    const __m128i patternD = _mm_set1_epi8('D');
+    const __m128i patternL = _mm_set1_epi8('L');
+    const __m128i patternT = _mm_set1_epi8('T');
+    const __m128i pattern1 = _mm_set1_epi8(0x01);
+
+    /* compare 16 candidate positions at once, each with all four pattern bytes */
+    while(end - data >= 16 + 3)
+    {
+        __m128i matchD = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) data), patternD);
+        __m128i matchL = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (data + 1)), patternL);
+        __m128i matchT = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (data + 2)), patternT);
+        __m128i match1 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (data + 3)), pattern1);
+        unsigned int mask = (unsigned int) _mm_movemask_epi8(_mm_and_si128(_mm_and_si128(matchD, matchL), _mm_and_si128(matchT, match1)));
+        if(mask)
+            return data + scannerFirstBit(mask);
+        data += 16;
+    }
+
+    return findMarkerScalar(data, end);
+}
+
+QDLT_SCANNER_TARGET("avx2")
+static const char *findMarkerAvx2(const char *data, const char *end)
+{
+    const __m256i patternD = _mm256_set1_epi8('D');
+    const __m256i patternL = _mm256_set1_epi8('L');
+    const __m256i patternT = _mm256_set1_epi8('T');
+    const __m256i pattern1 = _mm256_set1_epi8(0x01);
+
+    /* compare 32 candidate positions at once, each with all four pattern bytes */
+    while(end - data >= 32 + 3)
+    {
+        __m256i matchD = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *) data), patternD);
+        __m256i matchL = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *) (data + 1)), patternL);
+        __m256i matchT = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *) (data + 2)), patternT);
+        __m256i match1 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *) (data + 3)), pattern1);
+        unsigned int mask = (unsigned int) _mm256_movemask_epi8(_mm256_and_si256(_mm256_and_si256(matchD, matchL), _mm256_and_si256(matchT, match1)));
+        if(mask)
+            return data + scannerFirstBit(mask);
+        data += 32;
+    }
+
+    return findMarkerScalar(data, end);
+}
+
+static bool cpuHasSse2()
+{
+#if defined(__GNUC__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2");
+#elif defined(_M_X64)
+    return true;
+#else
+    int info[4];
+    __cpuid(info, 1);
+    return (info[3] & (1 << 26)) != 0;
+#endif
+}
+
+static bool cpuHasAvx2()
+{
+#if defined(__GNUC__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#else
+    int info[4];
+    __cpuid(info, 0);
+    if(info[0] < 7)
+        return false;
+
+    /* AVX must be supported by the CPU and enabled by the OS */
+    __cpuid(info, 1);
+    if(!(info[2] & (1 << 27)) || !(info[2] & (1 << 28)))
+        return false;
+    if((_xgetbv(0) & 6) != 6)
+        return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#endif
+}
+
+#endif // QDLT_SCANNER_X86
+
+typedef const char *(*FindMarkerFunction)(const char *data, const char *end);
+
+struct QDltFileScannerKernel
+{
+    FindMarkerFunction function;
+    const char *name;
+};
+
+static QDltFileScannerKernel selectKernel()
+{
+    QDltFileScannerKernel kernel = { findMarkerScalar, "scalar" };
+
+#ifdef QDLT_SCANNER_X86
+    if(cpuHasAvx2())
+    {
+        kernel.function = findMarkerAvx2;
+        kernel.name = "avx2";
+    }
+    else if(cpuHasSse2())
+    {
+        kernel.function = findMarkerSse2;
+        kernel.name = "sse2";
+    }
+#endif
+
+    return kernel;
+}
+
+static const QDltFileScannerKernel &scannerKernel()
+{
+    /* selected once, initialisation of static locals is thread safe */
+    static const QDltFileScannerKernel kernel = selectKernel();
+    return kernel;
+}
+
+QDltFileScanner::QDltFileScanner(ScanMode mode)
+    : mode(mode)
+{
+    reset(0);
+}
+
+void QDltFileScanner::reset(qint64 position, qint64 limit)
+{
+    pos = position;
+    limitPos = limit;
+    last = -1;
+    expected = -1;
+    resyncPos = -1;
+    handoffPos = -1;
+    finished = false;
+}
+
+qint64 QDltFileScanner::resumeIndex(QDltIndex &index, QDltFileMetadata *metadata)
+{
+    qint64 begin = 0;
+
+    if(!index.isEmpty())
+    {
+        begin = index.last();
+        index.truncate(index.size() - 1);
+    }
+    if(metadata)
+        metadata->truncate(index.size());
+
+    return begin;
+}
+
+bool QDltFileScanner::scanFile(QIODevice &file, QDltIndex &index, QDltFileMetadata *metadata)
+{
+    if(finished)
+        return false;
+
+    if(buffer.size() != blockSize)
+        buffer.resize(blockSize);
+
+    /* a read error is handled like the end of the file */
+    qint64 length = -1;
+    if(file.seek(pos))
+        length = file.read(buffer.data(), blockSize);
+    scan(buffer.constData(), length, index, length < blockSize, metadata);
+
+    return !finished;
+}
+
+const char *QDltFileScanner::findMarker(const char *data, const char *end)
+{
+    return scannerKernel().function(data, end);
+}
+
+QString QDltFileScanner::kernelName()
+{
+    return QString(scannerKernel().name);
+}
+
+bool QDltFileScanner::append(qint64 offset, QDltIndex &index, QDltFileMetadata *metadata, const char *data, qint64 size)
+{
+    /* message already in index */
+    if(offset <= last)
+        return true;
+
+    /* message belongs to the next range */
+    if(limitPos >= 0 && offset >= limitPos)
+    {
+        handoffPos = offset;
+        finished = true;
+        return false;
+    }
+
+    index.append(offset);
+    if(metadata)
+        metadata->append(data, size);
+    last = offset;
+
+    return true;
+}
+
+void QDltFileScanner::scan(const char *data, qint64 size, QDltIndex &index, bool endOfFile, QDltFileMetadata *metadata)
+{
+    const qint64 base = pos;
+    const char *end = data + size;
+    const char *current = data;
+    const int neededHeaderSize = metadata ? static_cast<int>(QDltFileMetadata::maxHeaderSize) : headerSize;
+
+    if(finished)
+        return;
+
+    if(size <= 0)
+    {
+        if(endOfFile)
+            finished = true;
+        return;
+    }
+
+    /* check storage header expected from the length of the last message in the previous block */
+    if(expected >= 0)
+    {
+        qint64 relative = expected - base;
+
+        if(relative >= 0 && relative + 4 > size)
+        {
+            if(endOfFile)
+            {
+                /* last message is incomplete */
+                finished = true;
+                pos = base + size;
+            }
+            else
+            {
+                pos = expected;
+            }
+            return;
+        }
+
+        expected = -1;
+
+        if(relative >= 0 && isMarker(data + relative))
+        {
+            current = data + relative;
+        }
+        else if(resyncPos < base)
+        {
+            /* no storage header found, search again behind the last message */
+            pos = resyncPos;
+            return;
+        }
+        else
+        {
+            current = data + (resyncPos - base);
+        }
+    }
+
+    for(;;)
+    {
+        const char *found = findMarker(current, end);
+        if(!found)
+            break;
+
+        qint64 offset = base + (found - data);
+
+        if((mode == ModeLengthGuided || metadata) && end - found < neededHeaderSize && !endOfFile)
+        {
+            /* read header completely with the next block */
+            pos = offset;
+            return;
+        }
+
+        if(!append(offset, index, metadata, found, end - found))
+        {
+            pos = offset;
+            return;
+        }
+
+        current = found + 4;
+
+        if(mode == ModeLengthGuided && end - found >= headerSize)
+        {
+            const DltStandardHeader *standardheader = (const DltStandardHeader *) (found + sizeof(DltStorageHeader));
+            unsigned int length = DLT_SWAP_16(standardheader->len);
+            unsigned int minimumLength = sizeof(DltStandardHeader) + DLT_STANDARD_HEADER_EXTRA_SIZE(standardheader->htyp) +
+                    (DLT_IS_HTYP_UEH(standardheader->htyp) ? sizeof(DltExtendedHeader) : 0);
+
+            if(length >= minimumLength)
+            {
+                qint64 next = offset + sizeof(DltStorageHeader) + length;
+                qint64 relative = next - base;
+
+                if(relative + 4 <= size)
+                {
+                    /* skip payload, if there is no storage header behind search again */
+                    if(isMarker(data + relative))
+                        current = data + relative;
+                }
+                else if(endOfFile)
+                {
+                    /* last message in file */
+                    finished = true;
+                    pos = base + size;
+                    return;
+                }
+                else
+                {
+                    /* next storage header is in one of the next blocks */
+                    expected = next;
+                    resyncPos = offset + 4;
+                    pos = next;
+                    return;
+                }
+            }
+        }
+    }
+
+    if(endOfFile)
+    {
+        finished = true;
+        pos = base + size;
+        return;
+    }
+
+    /* the last three bytes could be the beginning of a pattern crossing the block border */
+    pos = base + qMax(size - 3, (qint64) (current - data));
+}
@@ -0,0 +1,147 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltfilescanner.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef QDLT_FILE_SCANNER_H
+#define QDLT_FILE_SCANNER_H
+
+#include <QVector>
+#include <QString>
+#include <QByteArray>
+#include <QIODevice>
+
+#include "export_rules.h"
+#include "qdltindex.h"
+#include "qdltmetadata.h"
+
+//! Scanner for DLT storage headers in a DLT log file.
+/*!
+  The scanner finds the positions of all messages in a DLT log file by searching
+  the storage header pattern 'D','L','T',0x01. It is fed with consecutive blocks
+  read from the file and tells the caller from which file position the next block
+  has to be read, so patterns and headers crossing block borders are handled here
+  and not in every caller.
+
+  The pattern search itself uses SSE2 or AVX2 if the CPU supports it, the kernel
+  is selected once at runtime. On other platforms a scalar version is used.
+
+  In length guided mode the length field of the standard header is used to jump
+  directly to the next expected storage header, without searching the payload.
+  This removes false matches of the pattern inside payloads. If no storage header
+  is found at the expected position, the scanner falls back to search the pattern
+  behind the last found message.
+*/
+class QDLT_EXPORT QDltFileScanner
+{
+public:
+
+    typedef enum { ModeMarker, ModeLengthGuided } ScanMode;
+
+    //! The constructor.
+    /*!
+      \param mode The scan mode.
+    */
+    QDltFileScanner(ScanMode mode = ModeLengthGuided);
+
+    //! Restart scanning at a file position.
+    /*!
+      \param position The file position where the next block has to be read from.
+      \param limit Messages starting at or behind this file position are not added, -1 for no limit.
+    */
+    void reset(qint64 position, qint64 limit = -1);
+
+    //! Prepare an index to be continued by scanning the rest of the file.
+    /*!
+      The last message is removed from the index and the metadata and is scanned again,
+      it could have been incomplete or a false match when it was found. All callers which
+      continue an index use this, so they resync on a bad storage header the same way.
+      \param index The index to be continued.
+      \param metadata If not 0, the metadata of the messages in the index.
+      \return The file position scanning has to be restarted at with reset().
+    */
+    static qint64 resumeIndex(QDltIndex &index, QDltFileMetadata *metadata = 0);
+
+    //! Read the next block at position() from a file and scan it.
+    /*!
+      This is the loop body of all callers which index a file, they only add progress and stop handling:
+      while(scanner.scanFile(file, index)) { ... }
+      \param file The DLT log file.
+      \param index The index the found file positions are appended to.
+      \param metadata If not 0, the headers of all found messages are appended to the metadata.
+      \return false if scanning is finished.
+    */
+    bool scanFile(QIODevice &file, QDltIndex &index, QDltFileMetadata *metadata = 0);
+
+    //! Scan one block read from the file position returned by position().
+    /*!
+      The positions of all found messages are appended to the index.
+      \param data The block read from the file.
+      \param size The size of the block.
+      \param index The index the found file positions are appended to.
+      \param endOfFile true if the block ends at the end of the file.
+      \param metadata If not 0, the headers of all found messages are appended to the metadata.
+    */
+    void scan(const char *data, qint64 size, QDltIndex &index, bool endOfFile, QDltFileMetadata *metadata = 0);
+
+    //! The file position the next block has to be read from.
+    qint64 position() const { return pos; }
+
+    //! Check if scanning is finished.
+    /*!
+      \return true if the end of the file or the limit was reached.
+    */
+    bool isFinished() const { return finished; }
+
+    //! The first message found at or behind the limit.
+    /*!
+      \return File position of the message, -1 if there is none until the end of the file.
+    */
+    qint64 handoff() const { return handoffPos; }
+
+    //! Search the next storage header pattern.
+    /*!
+      \param data Start of the data to be searched.
+      \param end End of the data to be searched.
+      \return Pointer to the first complete pattern, 0 if no pattern was found.
+    */
+    static const char *findMarker(const char *data, const char *end);
+
+    //! Name of the pattern search kernel selected for this CPU.
+    static QString kernelName();
+
+    //! Size of storage header and standard header needed to follow the length field.
+    static const int headerSize = 20;
+
+    //! Size of the blocks read by scanFile().
+    static const int blockSize = 1024 * 1024;
+
+private:
+    bool append(qint64 offset, QDltIndex &index, QDltFileMetadata *metadata, const char *data, qint64 size);
+
+    ScanMode mode;
+    qint64 pos;
+    qint64 limitPos;
+    qint64 last;
+    qint64 expected;
+    qint64 resyncPos;
+    qint64 handoffPos;
+    bool finished;
+    QByteArray buffer;
+};
+
+#endif // QDLT_FILE_SCANNER_H
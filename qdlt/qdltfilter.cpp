@@ -20,6 +20,7 @@
  */
 
 #include <QtDebug>
+#include <QDataStream>
 
 #include "qdlt.h"
 
@@ -28,6 +29,80 @@ extern "C"
 #include "dlt_common.h"
 }
 
+QDltFilterInput::QDltFilterInput(QDltMsg &msg)
+    : msg(msg),
+      header(0),
+      payload(0),
+      headerMatcher(0),
+      payloadMatcher(0),
+      headerMatched(false),
+      payloadMatched(false)
+{
+}
+
+QDltFilterInput::QDltFilterInput(QDltMsgCacheEntry &entry)
+    : msg(entry.msg),
+      header(&entry.header),
+      payload(&entry.payload),
+      headerMatcher(0),
+      payloadMatcher(0),
+      headerMatched(false),
+      payloadMatched(false)
+{
+}
+
+const QString &QDltFilterInput::getHeader()
+{
+    if(!header)
+    {
+        headerText = msg.toStringHeader();
+        header = &headerText;
+    }
+    return *header;
+}
+
+const QString &QDltFilterInput::getPayload()
+{
+    if(!payload)
+    {
+        payloadText = msg.toStringPayload();
+        payload = &payloadText;
+    }
+    return *payload;
+}
+
+void QDltFilterInput::setMatchers(const QDltMultiMatcher *headerMatcher, const QDltMultiMatcher *payloadMatcher)
+{
+    if(this->headerMatcher == headerMatcher && this->payloadMatcher == payloadMatcher)
+        return;
+
+    this->headerMatcher = headerMatcher;
+    this->payloadMatcher = payloadMatcher;
+    headerMatched = false;
+    payloadMatched = false;
+}
+
+bool QDltFilterInput::headerContains(int pattern)
+{
+    /* all literal texts are searched at once, when the first one is needed */
+    if(!headerMatched)
+    {
+        headerMatcher->match(getHeader(), headerMatches);
+        headerMatched = true;
+    }
+    return headerMatches.at(pattern);
+}
+
+bool QDltFilterInput::payloadContains(int pattern)
+{
+    if(!payloadMatched)
+    {
+        payloadMatcher->match(getPayload(), payloadMatches);
+        payloadMatched = true;
+    }
+    return payloadMatches.at(pattern);
+}
+
 QDltFilter::QDltFilter()
 {
     clear();
@@ -75,6 +150,22 @@ QDltFilter& QDltFilter::operator= (QDltFilter const& _filter)
     payloadRegexp = _filter.payloadRegexp;
     contextRegexp = _filter.contextRegexp;
 
+    // generated from ecuid, apid and ctid
+    ecuidId = _filter.ecuidId;
+    apidId = _filter.apidId;
+    ctidId = _filter.ctidId;
+    ecuidIsId = _filter.ecuidIsId;
+    apidIsId = _filter.apidIsId;
+    ctidIsId = _filter.ctidIsId;
+
+    // the pattern numbers belong to the filter list of the source filter
+    headerPattern = -1;
+    payloadPattern = -1;
+
+    // generated from the enabled criteria
+    plan = _filter.plan;
+    planCompiled = _filter.planCompiled;
+
     return *this;
 }
 
@@ -87,6 +178,11 @@ void QDltFilter::clear()
     apid.clear();
     ctid.clear();
     header.clear();
+    ecuidIsId = false;
+    apidIsId = false;
+    ctidIsId = false;
+    headerPattern = -1;
+    payloadPattern = -1;
     payload.clear();
 
     enableRegexp_Context = false;
@@ -105,6 +201,9 @@ void QDltFilter::clear()
     enableLogLevelMin = false;
     enableMarker = false;
 
+    plan.clear();
+    planCompiled = false;
+
     filterColour = "#000000"; // QColor() default contructor initializes to an invalid color RGB 0,0,0
     logLevelMax = 6;
     logLevelMin = 0;
@@ -127,74 +226,202 @@ bool QDltFilter::isNegative() const
 
 bool QDltFilter::compileRegexps()
 {
-    headerRegexp.setPattern(header);
-    payloadRegexp.setPattern(payload);
+    headerRegexp.setPattern(header,ignoreCase_Header?Qt::CaseInsensitive:Qt::CaseSensitive);
+    payloadRegexp.setPattern(payload,ignoreCase_Payload?Qt::CaseInsensitive:Qt::CaseSensitive);
     contextRegexp.setPattern(ctid);
-    headerRegexp.setCaseSensitivity(ignoreCase_Header?Qt::CaseInsensitive:Qt::CaseSensitive);
-    payloadRegexp.setCaseSensitivity(ignoreCase_Payload?Qt::CaseInsensitive:Qt::CaseSensitive);
     return (headerRegexp.isValid() && payloadRegexp.isValid() && contextRegexp.isValid());
 }
 
-bool QDltFilter::match(QDltMsg &msg) const
+void QDltFilter::compileIds()
 {
-    if(enableEcuid && (msg.getEcuid() != ecuid)) {
-        return false;
-    }
-    if(enableApid && (msg.getApid() != apid)) {
-        return false;
-    }
+    ecuidId = QDltId(ecuid);
+    apidId = QDltId(apid);
+    ctidId = QDltId(ctid);
+
+    /* strings which are no valid id are compared as strings */
+    ecuidIsId = (ecuidId.toString() == ecuid);
+    apidIsId = (apidId.toString() == apid);
+
+    /* a context id with four characters is only contained in an equal context id */
+    ctidIsId = (ctid.size() == 4 && ctidId.toString() == ctid);
+}
+
+void QDltFilter::compilePlan()
+{
+    plan.clear();
 
-    if(enableRegexp_Context)
+    /* the criteria are numbered by cost, so the plan is ordered by cost */
+    for(int criterion=0;criterion<criterionCount;criterion++)
     {
-        if(enableCtid && contextRegexp.indexIn(msg.getCtid()) < 0) {
-            return false;
-        }
+        if(isEnabled(criterion))
+            plan.append(static_cast<quint8>(criterion));
     }
-    else
+
+    planCompiled = true;
+}
+
+int QDltFilter::getCost() const
+{
+    if(planCompiled)
+        return plan.isEmpty() ? 0 : plan.last();
+
+    int cost = 0;
+    for(int criterion=0;criterion<criterionCount;criterion++)
     {
-        if(enableCtid && !(msg.getCtid().contains(ctid))) {
-            return false;
-        }
+        if(isEnabled(criterion))
+            cost = criterion;
     }
 
-    if(enableRegexp_Header)
-    {
-        if(enableHeader && headerRegexp.indexIn(msg.toStringHeader()) < 0) {
-            return false;
-        }
+    return cost;
+}
+
+bool QDltFilter::isEnabled(int criterion) const
+{
+    switch(criterion)
+    {
+    case criterionCtrlMsgs:
+        return enableCtrlMsgs;
+    case criterionLogLevelMax:
+        return enableLogLevelMax;
+    case criterionLogLevelMin:
+        return enableLogLevelMin;
+    case criterionEcuid:
+        return enableEcuid;
+    case criterionApid:
+        return enableApid;
+    case criterionCtid:
+        return enableCtid;
+    case criterionHeader:
+        return enableHeader;
+    case criterionPayload:
+        return enablePayload;
+    default:
+        return false;
     }
-    else
-    {
-        if(enableHeader && !(msg.toStringHeader().contains(header,ignoreCase_Header?Qt::CaseInsensitive:Qt::CaseSensitive))) {
-            return false;
-        }
+}
+
+bool QDltFilter::matchHeaderCriterion(int criterion, QDltMsg::DltTypeDef type, int subtype, QDltId ecuid, QDltId apid, QDltId ctid) const
+{
+    switch(criterion)
+    {
+    case criterionCtrlMsgs:
+        return type == QDltMsg::DltTypeControl;
+    case criterionLogLevelMax:
+        return (type == QDltMsg::DltTypeLog) && (subtype <= logLevelMax);
+    case criterionLogLevelMin:
+        return (type == QDltMsg::DltTypeLog) && (subtype >= logLevelMin);
+    case criterionEcuid:
+        return ecuidIsId ? ecuid == ecuidId : ecuid.toString() == this->ecuid;
+    case criterionApid:
+        return apidIsId ? apid == apidId : apid.toString() == this->apid;
+    case criterionCtid:
+        if(enableRegexp_Context)
+            return contextRegexp.contains(ctid.toString());
+        return ctidIsId ? ctid == ctidId : ctid.toString().contains(this->ctid);
+    default:
+        return true;
+    }
+}
+
+bool QDltFilter::matchCriterion(int criterion, QDltFilterInput &input) const
+{
+    QDltMsg &msg = input.getMsg();
+
+    switch(criterion)
+    {
+    case criterionHeader:
+        if(enableRegexp_Header)
+            return headerRegexp.contains(input.getHeader());
+        if(headerPattern >= 0 && input.hasMatchers())
+            return input.headerContains(headerPattern);
+        return input.getHeader().contains(header,ignoreCase_Header?Qt::CaseInsensitive:Qt::CaseSensitive);
+    case criterionPayload:
+        if(enableRegexp_Payload)
+            return payloadRegexp.contains(input.getPayload());
+        if(payloadPattern >= 0 && input.hasMatchers())
+            return input.payloadContains(payloadPattern);
+        return input.getPayload().contains(payload,ignoreCase_Payload?Qt::CaseInsensitive:Qt::CaseSensitive);
+    default:
+        return matchHeaderCriterion(criterion, msg.getType(), msg.getSubtype(), msg.getEcuidId(), msg.getApidId(), msg.getCtidId());
     }
-    if(enableRegexp_Payload)
+}
+
+bool QDltFilter::match(QDltMsg &msg) const
+{
+    QDltFilterInput input(msg);
+    return match(input);
+}
+
+bool QDltFilter::match(QDltMsgCacheEntry &entry) const
+{
+    QDltFilterInput input(entry);
+    return match(input);
+}
+
+bool QDltFilter::match(QDltFilterInput &input) const
+{
+    if(planCompiled)
     {
-        if(enablePayload && payloadRegexp.indexIn(msg.toStringPayload()) < 0) {
-            return false;
+        for(int num=0;num<plan.size();num++)
+        {
+            if(!matchCriterion(plan.at(num), input))
+                return false;
         }
+        return true;
     }
-    else
+
+    for(int criterion=0;criterion<criterionCount;criterion++)
     {
-        if(enablePayload && !(msg.toStringPayload().contains(payload,ignoreCase_Payload?Qt::CaseInsensitive:Qt::CaseSensitive))) {
+        if(isEnabled(criterion) && !matchCriterion(criterion, input))
             return false;
-        }
     }
 
-    if(enableCtrlMsgs && !((msg.getType() == QDltMsg::DltTypeControl))) {
-        return false;
-    }
-    if(enableLogLevelMax && !((msg.getType() == QDltMsg::DltTypeLog) && (msg.getSubtype() <= logLevelMax))) {
-        return false;
-    }
-    if(enableLogLevelMin && !((msg.getType() == QDltMsg::DltTypeLog) && (msg.getSubtype() >= logLevelMin))) {
-        return false;
+    return true;
+}
+
+bool QDltFilter::match(const QDltMsgMetadata &metadata) const
+{
+    for(int criterion=0;criterion<criterionHeader;criterion++)
+    {
+        if(isEnabled(criterion) &&
+           !matchHeaderCriterion(criterion, metadata.type, metadata.subtype, metadata.ecuid, metadata.apid, metadata.ctid))
+            return false;
     }
 
     return true;
 }
 
+bool QDltFilter::isHeaderOnly() const
+{
+    return getCost() < criterionHeader;
+}
+
+QByteArray QDltFilter::matchKey() const
+{
+    QByteArray key;
+    QDataStream stream(&key, QIODevice::WriteOnly);
+
+    /* only the criteria which are enabled change the result */
+    stream << enableEcuid << enableApid << enableCtid << enableHeader << enablePayload
+           << enableCtrlMsgs << enableLogLevelMax << enableLogLevelMin;
+    if(enableEcuid)
+        stream << ecuid;
+    if(enableApid)
+        stream << apid;
+    if(enableCtid)
+        stream << enableRegexp_Context << ctid;
+    if(enableHeader)
+        stream << enableRegexp_Header << ignoreCase_Header << header;
+    if(enablePayload)
+        stream << enableRegexp_Payload << ignoreCase_Payload << payload;
+    if(enableLogLevelMax)
+        stream << logLevelMax;
+    if(enableLogLevelMin)
+        stream << logLevelMin;
+
+    return key;
+}
+
 void QDltFilter::LoadFilterItem(QXmlStreamReader &xml)
 {
     if(xml.name() == QString("type"))
@@ -24,6 +24,7 @@
 
 #include <QObject>
 #include <QString>
+#include <QVector>
 #include <QFile>
 #include <QDateTime>
 //#include <QColor>
@@ -33,7 +34,65 @@
 #include <QXmlStreamWriter>
 
 #include "export_rules.h"
+#include "qdltid.h"
+#include "qdltregexp.h"
+#include "qdltmultimatcher.h"
+#include "qdltmsgcache.h"
+#include "qdltmetadata.h"
 
+//! A message checked by one or more filters.
+/*!
+  The header and payload text is printed at most once, and only if a filter
+  needs it, however many filters check the message.
+*/
+class QDLT_EXPORT QDltFilterInput
+{
+public:
+    //! Check a message, the text is printed when it is needed.
+    QDltFilterInput(QDltMsg &msg);
+
+    //! Check a message with already printed header and payload text.
+    QDltFilterInput(QDltMsgCacheEntry &entry);
+
+    //! Get the message.
+    QDltMsg &getMsg() { return msg; }
+
+    //! Get the text of msg.toStringHeader().
+    const QString &getHeader();
+
+    //! Get the text of msg.toStringPayload().
+    const QString &getPayload();
+
+    //! Search the literal texts of a filter list in the header and payload text.
+    /*!
+      \param headerMatcher The literal texts searched in the header text.
+      \param payloadMatcher The literal texts searched in the payload text.
+    */
+    void setMatchers(const QDltMultiMatcher *headerMatcher, const QDltMultiMatcher *payloadMatcher);
+
+    //! Check if matchers are set.
+    bool hasMatchers() const { return headerMatcher != 0; }
+
+    //! Check if the header text contains a literal text of the header matcher.
+    bool headerContains(int pattern);
+
+    //! Check if the payload text contains a literal text of the payload matcher.
+    bool payloadContains(int pattern);
+
+private:
+    QDltMsg &msg;
+    QString headerText;
+    QString payloadText;
+    const QString *header;
+    const QString *payload;
+
+    const QDltMultiMatcher *headerMatcher;
+    const QDltMultiMatcher *payloadMatcher;
+    QVector<bool> headerMatches;
+    QVector<bool> payloadMatches;
+    bool headerMatched;
+    bool payloadMatched;
+};
 
 class QDLT_EXPORT QDltFilter
 {
@@ -73,9 +132,22 @@ public:
     int logLevelMin;
 
     // generated from header and payload string
-    QRegExp headerRegexp;
-    QRegExp payloadRegexp;
-    QRegExp contextRegexp;
+    QDltRegExp headerRegexp;
+    QDltRegExp payloadRegexp;
+    QDltRegExp contextRegexp;
+
+    // generated from ecuid, apid and ctid, used if the string is a valid id
+    QDltId ecuidId;
+    QDltId apidId;
+    QDltId ctidId;
+    bool ecuidIsId;
+    bool apidIsId;
+    bool ctidIsId;
+
+    // generated by QDltFilterList::updateSortedFilter(), number of the header and payload text
+    // in the multi pattern matchers of the filter list, -1 if the text is searched alone
+    int headerPattern;
+    int payloadPattern;
 
     //! Constructor.
     /*!
@@ -117,12 +189,65 @@ public:
     */
     bool compileRegexps();
 
+    //! Create ids from ecu id, application id and context id.
+    /*!
+      The ids are compared as integers, if possible.
+      Must be called again if one of the strings is changed.
+    */
+    void compileIds();
+
+    //! Create the evaluation plan from the enabled criteria.
+    /*!
+      The criteria are checked ordered by cost, the header fields first and the
+      printed header and payload text last. Must be called again if one of the
+      criteria is changed, else all criteria are checked in the same order.
+    */
+    void compilePlan();
+
+    //! Get the cost of checking this filter.
+    /*!
+      \return the most expensive criterion which is checked, 0 for header fields only
+    */
+    int getCost() const;
+
     //! Check if filter matches.
     /*!
       \return true if filter matches the message, else false
     */
     bool match(QDltMsg &msg) const;
 
+    //! Check if filter matches a message, the text is shared with other filters.
+    /*!
+      \return true if filter matches the message, else false
+    */
+    bool match(QDltFilterInput &input) const;
+
+    //! Check if filter matches a message with already printed header and payload text.
+    /*!
+      \return true if filter matches the message, else false
+    */
+    bool match(QDltMsgCacheEntry &entry) const;
+
+    //! Check if filter matches the header metadata of a message.
+    /*!
+      Must only be used if isHeaderOnly() is true, the header and payload text is not checked.
+      \return true if filter matches the message, else false
+    */
+    bool match(const QDltMsgMetadata &metadata) const;
+
+    //! Check if the filter checks header fields only.
+    /*!
+      \return true if the filter does not need the printed header or payload text
+    */
+    bool isHeaderOnly() const;
+
+    //! Get a key which is equal for all filters matching the same messages.
+    /*!
+      Type, name, colour and the enable flag of the filter are not part of the key.
+      \return the key
+    */
+    QByteArray matchKey() const;
+
     //! Save filter parameters in XML file.
     /*!
     */
@@ -135,6 +260,18 @@ public:
 
 protected:
 private:
+    //! Criteria of a filter, ordered by the cost of checking them.
+    typedef enum { criterionCtrlMsgs = 0, criterionLogLevelMax, criterionLogLevelMin,
+                   criterionEcuid, criterionApid, criterionCtid,
+                   criterionHeader, criterionPayload, criterionCount } Criterion;
+
+    bool isEnabled(int criterion) const;
+    bool matchCriterion(int criterion, QDltFilterInput &input) const;
+    bool matchHeaderCriterion(int criterion, QDltMsg::DltTypeDef type, int subtype, QDltId ecuid, QDltId apid, QDltId ctid) const;
+
+    //! Enabled criteria ordered by cost, valid if planCompiled is set.
+    QVector<quint8> plan;
+    bool planCompiled;
 };
 
 #endif // QDLT_FILTER_H
@@ -28,7 +28,7 @@ extern "C"
 #include "dlt_common.h"
 }
 
-void QDltFilterIndex::setIndexFilter(QVector<qint64> _indexFilter)
+void QDltFilterIndex::setIndexFilter(const QDltIndex &_indexFilter)
 {
     indexFilter = _indexFilter;
 }
@@ -38,7 +38,7 @@ void QDltFilterIndex::setDltFileName(QString _dltFileName)
     dltFileName = _dltFileName;
 }
 
-void QDltFilterIndex::setAllIndexSize(int _allIndexSize)
+void QDltFilterIndex::setAllIndexSize(qint64 _allIndexSize)
 {
     allIndexSize = _allIndexSize;
 }
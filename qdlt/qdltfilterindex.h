@@ -31,13 +31,14 @@
 #include <time.h>
 
 #include "export_rules.h"
+#include "qdltindex.h"
 
 class QDLT_EXPORT QDltFilterIndex
 {
 public:
 
     QString dltFileName;
-    int allIndexSize;
+    qint64 allIndexSize;
 
     QDltFilterList filterList;
 
@@ -45,12 +46,12 @@ public:
     /*!
       Index contains positions of DLT messages in indexAll.
     */
-    QVector<qint64> indexFilter;
+    QDltIndex indexFilter;
 
     //! Set the filter index cache.
     /*!
     */
-    void setIndexFilter(QVector<qint64> _indexFilter);
+    void setIndexFilter(const QDltIndex &_indexFilter);
 
     //! Set filename for plausibility check.
     /*!
@@ -60,7 +61,7 @@ public:
     //! Set the dlt file messages size for plausibility check.
     /*!
     */
-    void setAllIndexSize(int _allIndexSize);
+    void setAllIndexSize(qint64 _allIndexSize);
 
 protected:
 
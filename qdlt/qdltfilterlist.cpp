@@ -19,6 +19,8 @@
  * @licence end@
  */
 
+#include <algorithm>
+
 #include <QtDebug>
 //#include <QMessageBox>
 #include <QCryptographicHash>
@@ -31,6 +33,11 @@ extern "C"
 #include "dlt_common.h"
 }
 
+static bool filterCostLessThan(const QDltFilter *filter1, const QDltFilter *filter2)
+{
+    return filter1->getCost() < filter2->getCost();
+}
+
 QDltFilterList::QDltFilterList()
 {
 
@@ -83,15 +90,29 @@ void QDltFilterList::addFilter(QDltFilter *_filter)
 }
 
 QString QDltFilterList::checkMarker(QDltMsg &msg)
+{
+    QDltFilterInput input(msg);
+    return checkMarker(input);
+}
+
+QString QDltFilterList::checkMarker(QDltMsgCacheEntry &entry)
+{
+    QDltFilterInput input(entry);
+    return checkMarker(input);
+}
+
+QString QDltFilterList::checkMarker(QDltFilterInput &input)
 {
     QDltFilter *filter;
     QString color=DEFAULT_COLOR;
 
+    prepareInput(input);
+
     for(int numfilter=0;numfilter<mfilters.size();numfilter++)
     {
         filter = mfilters[numfilter];
 
-        if(filter->match(msg))
+        if(filter->match(input))
         {
             color = filter->filterColour;
             //qDebug() << "Filter color " << filter->filterColour;
@@ -102,6 +123,12 @@ QString QDltFilterList::checkMarker(QDltMsg &msg)
 }
 
 bool QDltFilterList::checkFilter(QDltMsg &msg)
+{
+    QDltFilterInput input(msg);
+    return checkFilter(input);
+}
+
+bool QDltFilterList::checkFilter(QDltFilterInput &input)
 {
     QDltFilter *filter;
     bool found = false;
@@ -118,11 +145,13 @@ bool QDltFilterList::checkFilter(QDltMsg &msg)
     else
         found = false;
 
+    prepareInput(input);
 
+    /* the header and payload text is printed at most once for all filters */
     for(int numfilter=0;numfilter<pfilters.size();numfilter++)
     {
         filter = pfilters[numfilter];
-        found = filter->match(msg);
+        found = filter->match(input);
         if (found)
           break;
     }
@@ -136,7 +165,7 @@ bool QDltFilterList::checkFilter(QDltMsg &msg)
         for(int numfilter=0;numfilter<nfilters.size();numfilter++)
         {
             filter = nfilters[numfilter];
-            if (filter->match(msg))
+            if (filter->match(input))
             {
                 // a negative filter has matched -> found = false
                 found = false;
@@ -148,6 +177,32 @@ bool QDltFilterList::checkFilter(QDltMsg &msg)
     return found;
 }
 
+bool QDltFilterList::checkFilter(const QDltMsgMetadata &metadata) const
+{
+    bool found = (pfilters.size() == 0);
+
+    for(int numfilter=0;numfilter<pfilters.size() && !found;numfilter++)
+        found = pfilters[numfilter]->match(metadata);
+
+    for(int numfilter=0;numfilter<nfilters.size() && found;numfilter++)
+        found = !nfilters[numfilter]->match(metadata);
+
+    return found;
+}
+
+bool QDltFilterList::isHeaderOnly() const
+{
+    QList<QDltFilter*> matchFilters = getMatchFilters();
+
+    for(int numfilter=0;numfilter<matchFilters.size();numfilter++)
+    {
+        if(!matchFilters[numfilter]->isHeaderOnly())
+            return false;
+    }
+
+    return true;
+}
+
 bool QDltFilterList::SaveFilter(QString _filename)
 {
     QFile file(_filename);
@@ -283,6 +338,14 @@ void QDltFilterList::updateSortedFilter()
     {
         filter = filters[numfilter];
 
+        /* compare ids as integers while filtering and check cheap criteria first */
+        filter->compileIds();
+        filter->compilePlan();
+        if(filter->enableRegexp_Context || filter->enableRegexp_Header || filter->enableRegexp_Payload)
+            filter->compileRegexps();
+        filter->headerPattern = -1;
+        filter->payloadPattern = -1;
+
         if(filter->isMarker() && filter->enableFilter)
         {
             /* add to marker list */
@@ -302,4 +365,47 @@ void QDltFilterList::updateSortedFilter()
         }
     }
 
+    /* the result does not depend on the order, so check the cheapest filters first */
+    std::stable_sort(pfilters.begin(), pfilters.end(), filterCostLessThan);
+    std::stable_sort(nfilters.begin(), nfilters.end(), filterCostLessThan);
+
+    updateMatchers();
+}
+
+void QDltFilterList::updateMatchers()
+{
+    QList<QDltFilter*> enabledFilters = mfilters + pfilters + nfilters;
+    QDltFilter *filter;
+    int headerCount = 0;
+    int payloadCount = 0;
+
+    headerMatcher.clear();
+    payloadMatcher.clear();
+
+    for(int numfilter=0;numfilter<enabledFilters.size();numfilter++)
+    {
+        filter = enabledFilters[numfilter];
+        if(filter->enableHeader && !filter->enableRegexp_Header)
+            headerCount++;
+        if(filter->enablePayload && !filter->enableRegexp_Payload)
+            payloadCount++;
+    }
+
+    /* a few texts are found faster one by one */
+    for(int numfilter=0;numfilter<enabledFilters.size();numfilter++)
+    {
+        filter = enabledFilters[numfilter];
+        if(headerCount >= minMultiMatchPatterns && filter->enableHeader && !filter->enableRegexp_Header)
+            filter->headerPattern = headerMatcher.addPattern(filter->header, filter->ignoreCase_Header?Qt::CaseInsensitive:Qt::CaseSensitive);
+        if(payloadCount >= minMultiMatchPatterns && filter->enablePayload && !filter->enableRegexp_Payload)
+            filter->payloadPattern = payloadMatcher.addPattern(filter->payload, filter->ignoreCase_Payload?Qt::CaseInsensitive:Qt::CaseSensitive);
+    }
+
+    headerMatcher.build();
+    payloadMatcher.build();
+}
+
+void QDltFilterList::prepareInput(QDltFilterInput &input) const
+{
+    input.setMatchers(&headerMatcher, &payloadMatcher);
 }
@@ -39,6 +39,9 @@ class QDLT_EXPORT QDltFilterList
 {
 public:
 
+    //! Minimum number of literal header or payload texts which are searched with one multi pattern matcher.
+    static const int minMultiMatchPatterns = 4;
+
     //! List of filters.
     QList<QDltFilter*> filters;
 
@@ -83,6 +86,20 @@ public:
     */
     QString checkMarker(QDltMsg &msg);
 
+    //! Check if a message with already printed header and payload text will be marked.
+    /*!
+      \param entry The message to be marked
+      \return 0 if message will not be marked, colour if message will be marked
+    */
+    QString checkMarker(QDltMsgCacheEntry &entry);
+
+    //! Check if a message will be marked, the text is shared with other checks of the message.
+    /*!
+      \param input The message to be marked
+      \return 0 if message will not be marked, colour if message will be marked
+    */
+    QString checkMarker(QDltFilterInput &input);
+
     //! Check if message matches the filter.
     /*!
       \param msg The message to be checked
@@ -90,6 +107,35 @@ public:
     */
     bool checkFilter(QDltMsg &msg);
 
+    //! Check if message matches the filter, the text is shared with other checks of the message.
+    /*!
+      \param input The message to be checked
+      \return true if message will be displayed, false if message will be filtered out
+    */
+    bool checkFilter(QDltFilterInput &input);
+
+    //! Check if the header metadata of a message matches the filter.
+    /*!
+      Must only be used if isHeaderOnly() is true.
+      \param metadata The header metadata of the message to be checked
+      \return true if message will be displayed, false if message will be filtered out
+    */
+    bool checkFilter(const QDltMsgMetadata &metadata) const;
+
+    //! Check if the enabled positive and negative filters check header fields only.
+    /*!
+      \return true if checkFilter() can be used with the header metadata
+    */
+    bool isHeaderOnly() const;
+
+    //! Prepare a message to be checked by the filters of this list.
+    /*!
+      The literal header and payload texts of all filters are searched with one pass
+      over the text. Must be used if the filters of getMatchFilters() check the message.
+      \param input The message to be checked
+    */
+    void prepareInput(QDltFilterInput &input) const;
+
     //! Save the filter.
     /*!
     */
@@ -112,9 +158,24 @@ public:
 
     //! Update the presorted list for performance improvement.
     /*!
+      Each enabled filter is compiled into its evaluation plan. Positive and
+      negative filters are ordered by cost, so cheap filters on header fields
+      are checked before filters which need the printed text. Markers keep
+      their order, the first matching marker gives the colour.
+      If there are many literal header or payload texts, they are compiled into
+      multi pattern matchers.
     */
     void updateSortedFilter();
 
+    //! Get the enabled positive filters followed by the enabled negative filters.
+    /*!
+      These are the filters used by checkFilter(), in the same order, which is ordered by cost.
+    */
+    QList<QDltFilter*> getMatchFilters() const { return pfilters + nfilters; }
+
+    //! Get the number of enabled positive filters.
+    int getPositiveFilterCount() const { return pfilters.size(); }
+
 protected:
 private:
 
@@ -130,6 +191,13 @@ private:
     //! List of nfilters.
     QList<QDltFilter*> nfilters;
 
+    //! Literal header and payload texts of the enabled filters and markers.
+    QDltMultiMatcher headerMatcher;
+    QDltMultiMatcher payloadMatcher;
+
+    //! Compile the literal texts into the matchers.
+    void updateMatchers();
+
 };
 
 #endif // QDLT_FILTER_LIST_H
@@ -0,0 +1,47 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltid.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include "qdltid.h"
+
+QDltId::QDltId(const QString &id)
+    : value(0)
+{
+    QByteArray latin = id.toLatin1();
+
+    for(int num=0;num<4 && num<latin.size() && latin.at(num);num++)
+        value |= static_cast<quint32>(static_cast<unsigned char>(latin.at(num))) << (24 - 8 * num);
+}
+
+QString QDltId::toString() const
+{
+    char id[4];
+    int length = 0;
+
+    toChars(id);
+    while(length<4 && id[length])
+        length++;
+
+    return QString::fromLatin1(id, length);
+}
+
+void QDltId::toChars(char *id) const
+{
+    for(int num=0;num<4;num++)
+        id[num] = static_cast<char>((value >> (24 - 8 * num)) & 0xff);
+}
@@ -0,0 +1,89 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltid.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef QDLT_ID_H
+#define QDLT_ID_H
+
+#include <QString>
+#include <QHash>
+
+#include "export_rules.h"
+
+//! A DLT id, e.g. an ECU id, application id or context id.
+/*!
+  The up to four characters of the id are stored in one 32 bit value,
+  the first character in the highest byte. Ids are compared as one integer
+  and the order is the same as the alphabetical order of the ids.
+  Characters behind the first zero character are ignored, like in the DLT headers.
+*/
+class QDLT_EXPORT QDltId
+{
+public:
+    //! Create an empty id.
+    QDltId() : value(0) {}
+
+    //! Create an id from a DLT header field.
+    /*!
+      \param id Pointer to the four characters of the id, does not need to be zero terminated.
+    */
+    explicit QDltId(const char *id) : value(0)
+    {
+        for(int num=0;num<4 && id[num];num++)
+            value |= static_cast<quint32>(static_cast<unsigned char>(id[num])) << (24 - 8 * num);
+    }
+
+    //! Create an id from a string.
+    /*!
+      Only the first four characters are used.
+      \param id The id as string.
+    */
+    explicit QDltId(const QString &id);
+
+    //! Create an id from the value returned by toValue().
+    static QDltId fromValue(quint32 value) { QDltId id; id.value = value; return id; }
+
+    //! Get the id as 32 bit value.
+    quint32 toValue() const { return value; }
+
+    //! Check if the id is empty.
+    bool isEmpty() const { return value == 0; }
+
+    //! Get the id as string.
+    QString toString() const;
+
+    //! Write the id into a DLT header field.
+    /*!
+      \param id Pointer to the four characters of the id, unused characters are set to zero.
+    */
+    void toChars(char *id) const;
+
+    bool operator==(const QDltId &other) const { return value == other.value; }
+    bool operator!=(const QDltId &other) const { return value != other.value; }
+    bool operator<(const QDltId &other) const { return value < other.value; }
+
+private:
+    quint32 value;
+};
+
+inline uint qHash(const QDltId &id, uint seed = 0)
+{
+    return qHash(id.toValue(), seed);
+}
+
+#endif // QDLT_ID_H
@@ -0,0 +1,286 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltindex.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "qdltindex.h"
+
+QDltIndexData::QDltIndexData()
+    : count(0),
+      capacity(0),
+      deltas(0)
+{
+}
+
+QDltIndexData::QDltIndexData(const QDltIndexData &other)
+    : QSharedData(other),
+      count(other.count),
+      capacity(other.count),
+      deltas(0),
+      bases(other.bases),
+      wideValues(other.wideValues)
+{
+    if(count > 0)
+    {
+        deltas = (qint32 *) malloc(count * sizeof(qint32));
+        Q_CHECK_PTR(deltas);
+        memcpy(deltas, other.deltas, count * sizeof(qint32));
+    }
+}
+
+QDltIndexData::~QDltIndexData()
+{
+    free(deltas);
+}
+
+QDltIndex::QDltIndex()
+    : d(new QDltIndexData())
+{
+}
+
+QDltIndex::QDltIndex(const QVector<qint64> &vector)
+    : d(new QDltIndexData())
+{
+    reserve(vector.size());
+    for(int num=0;num<vector.size();num++)
+        append(vector[num]);
+}
+
+void QDltIndex::reserve(qint64 size)
+{
+    if(size <= d->capacity)
+        return;
+
+    qint32 *deltas = (qint32 *) realloc(d->deltas, size * sizeof(qint32));
+    Q_CHECK_PTR(deltas);
+    d->deltas = deltas;
+    d->capacity = size;
+    d->bases.reserve(static_cast<int>((size + blockSize - 1) >> blockShift));
+}
+
+void QDltIndex::append(qint64 value)
+{
+    QDltIndexData *data = d.data();
+    qint64 i = data->count;
+    int offset = static_cast<int>(i & (blockSize - 1));
+
+    if(i == data->capacity)
+        reserve(qMax(static_cast<qint64>(blockSize), data->capacity * 2));
+
+    if(offset == 0)
+    {
+        /* first value of a new block */
+        if(value >= 0)
+        {
+            data->bases.append(value);
+        }
+        else
+        {
+            data->bases.append(-static_cast<qint64>(data->wideValues.size() >> blockShift) - 1);
+            data->wideValues.resize(data->wideValues.size() + blockSize);
+            data->wideValues[data->wideValues.size() - blockSize] = value;
+        }
+        data->deltas[i] = 0;
+        data->count++;
+        return;
+    }
+
+    qint64 base = data->bases.last();
+    if(base >= 0)
+    {
+        qint64 delta = value - base;
+        if(delta >= INT_MIN && delta <= INT_MAX)
+        {
+            data->deltas[i] = static_cast<qint32>(delta);
+            data->count++;
+            return;
+        }
+
+        /* value does not fit, store block with full values */
+        qint64 slot = static_cast<qint64>(data->wideValues.size() >> blockShift);
+        data->wideValues.resize(data->wideValues.size() + blockSize);
+        qint64 *wide = data->wideValues.data() + (slot << blockShift);
+        for(int num=0;num<offset;num++)
+            wide[num] = base + data->deltas[i - offset + num];
+        base = -slot - 1;
+        data->bases.last() = base;
+    }
+
+    data->wideValues[((-base - 1) << blockShift) + offset] = value;
+    data->deltas[i] = 0;
+    data->count++;
+}
+
+void QDltIndex::append(const QDltIndex &other, qint64 from)
+{
+    qint64 size = other.size();
+
+    if(from >= size)
+        return;
+
+    reserve(d->count + size - from);
+    for(qint64 num=from;num<size;num++)
+        append(other.at(num));
+}
+
+void QDltIndex::clear()
+{
+    d = new QDltIndexData();
+}
+
+void QDltIndex::truncate(qint64 size)
+{
+    if(size < 0 || size >= d->count)
+        return;
+
+    QDltIndexData *data = d.data();
+    int blocks = static_cast<int>((size + blockSize - 1) >> blockShift);
+
+    /* blocks with full values are allocated in the order of the blocks */
+    while(data->bases.size() > blocks)
+    {
+        if(data->bases.last() < 0)
+            data->wideValues.resize(data->wideValues.size() - blockSize);
+        data->bases.removeLast();
+    }
+    data->count = size;
+}
+
+qint64 QDltIndex::lowerBound(qint64 value) const
+{
+    qint64 first = 0;
+    qint64 count = d->count;
+
+    while(count > 0)
+    {
+        qint64 step = count / 2;
+        if(at(first + step) < value)
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+
+    return first;
+}
+
+QVector<qint64> QDltIndex::toVector() const
+{
+    QVector<qint64> vector;
+
+    vector.reserve(static_cast<int>(d->count));
+    for(qint64 num=0;num<d->count;num++)
+        vector.append(at(num));
+
+    return vector;
+}
+
+qint64 QDltIndex::memoryUsage() const
+{
+    return d->capacity * sizeof(qint32) + d->bases.capacity() * sizeof(qint64) + static_cast<qint64>(d->wideValues.capacity()) * sizeof(qint64);
+}
+
+bool QDltIndex::write(QIODevice &device) const
+{
+    const QDltIndexData *data = d.constData();
+    qint64 count = data->count;
+    qint32 baseCount = data->bases.size();
+    qint64 wideCount = static_cast<qint64>(data->wideValues.size());
+    qint64 length;
+
+    if(device.write((const char*) &count, sizeof(count)) != sizeof(count) ||
+       device.write((const char*) &baseCount, sizeof(baseCount)) != sizeof(baseCount) ||
+       device.write((const char*) &wideCount, sizeof(wideCount)) != sizeof(wideCount))
+        return false;
+
+    length = baseCount * static_cast<qint64>(sizeof(qint64));
+    if(device.write((const char*) data->bases.constData(), length) != length)
+        return false;
+    length = wideCount * static_cast<qint64>(sizeof(qint64));
+    if(length > 0 && device.write((const char*) data->wideValues.data(), length) != length)
+        return false;
+    length = count * static_cast<qint64>(sizeof(qint32));
+    if(length > 0 && device.write((const char*) data->deltas, length) != length)
+        return false;
+
+    return true;
+}
+
+bool QDltIndex::read(QIODevice &device)
+{
+    qint64 count;
+    qint32 baseCount;
+    qint64 wideCount;
+    qint64 length;
+
+    clear();
+
+    if(device.read((char*) &count, sizeof(count)) != sizeof(count) ||
+       device.read((char*) &baseCount, sizeof(baseCount)) != sizeof(baseCount) ||
+       device.read((char*) &wideCount, sizeof(wideCount)) != sizeof(wideCount))
+        return false;
+
+    /* check the layout before memory is allocated */
+    if(count < 0 || baseCount != (count + blockSize - 1) >> blockShift || wideCount < 0 || (wideCount & (blockSize - 1)) != 0 ||
+       device.size() - device.pos() < (baseCount + wideCount) * static_cast<qint64>(sizeof(qint64)) + count * static_cast<qint64>(sizeof(qint32)))
+        return false;
+
+    QDltIndexData *data = d.data();
+
+    data->bases.resize(baseCount);
+    length = baseCount * static_cast<qint64>(sizeof(qint64));
+    if(device.read((char*) data->bases.data(), length) != length)
+    {
+        clear();
+        return false;
+    }
+    for(int num=0;num<baseCount;num++)
+    {
+        if(data->bases[num] < 0 && -data->bases[num] - 1 >= (wideCount >> blockShift))
+        {
+            clear();
+            return false;
+        }
+    }
+
+    data->wideValues.resize(static_cast<size_t>(wideCount));
+    length = wideCount * static_cast<qint64>(sizeof(qint64));
+    if(length > 0 && device.read((char*) data->wideValues.data(), length) != length)
+    {
+        clear();
+        return false;
+    }
+
+    reserve(count);
+    length = count * static_cast<qint64>(sizeof(qint32));
+    if(length > 0 && device.read((char*) data->deltas, length) != length)
+    {
+        clear();
+        return false;
+    }
+    data->count = count;
+
+    return true;
+}
@@ -0,0 +1,162 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltindex.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef QDLT_INDEX_H
+#define QDLT_INDEX_H
+
+#include <QVector>
+#include <QSharedData>
+#include <QSharedDataPointer>
+#include <QIODevice>
+
+#include <vector>
+
+#include "export_rules.h"
+
+//! Data of a message index, shared between copies of the index.
+class QDLT_EXPORT QDltIndexData : public QSharedData
+{
+public:
+    QDltIndexData();
+    QDltIndexData(const QDltIndexData &other);
+    ~QDltIndexData();
+
+    //! Number of values.
+    qint64 count;
+
+    //! Number of values the deltas buffer can hold.
+    qint64 capacity;
+
+    //! Value of each entry relative to the base of its block.
+    qint32 *deltas;
+
+    //! First value of each block, or -(slot+1) if the block is stored in wideValues.
+    QVector<qint64> bases;
+
+    //! Blocks whose values do not fit into deltas, e.g. unsorted indexes.
+    /*!
+      Not limited by the size of Qt containers, all blocks may be stored here.
+    */
+    std::vector<qint64> wideValues;
+};
+
+//! Compact index of DLT messages.
+/*!
+  The index stores file positions or message numbers, like a QVector<qint64>,
+  but needs about half of the memory. Values are stored in blocks of blockSize
+  entries as a 64 bit base per block and a 32 bit delta per entry. Blocks with
+  values which are too far apart, e.g. in an index sorted by time, are stored
+  with full 64 bit values. Access by position and appending are O(1).
+  The index is implicitly shared, copies are cheap until one of them is modified.
+*/
+class QDLT_EXPORT QDltIndex
+{
+public:
+    //! Number of entries of each block as power of two.
+    static const int blockShift = 10;
+    static const int blockSize = 1 << blockShift;
+
+    //! The constructor.
+    QDltIndex();
+
+    //! Create an index from a vector.
+    /*!
+      \param vector The values of the index.
+    */
+    QDltIndex(const QVector<qint64> &vector);
+
+    //! Get the number of entries.
+    qint64 size() const { return d->count; }
+
+    //! Check if the index is empty.
+    bool isEmpty() const { return d->count == 0; }
+
+    //! Get one entry.
+    /*!
+      \param i Position of the entry, must be valid.
+      \return The value of the entry.
+    */
+    inline qint64 at(qint64 i) const
+    {
+        const QDltIndexData *data = d.constData();
+        qint64 base = data->bases.at(static_cast<int>(i >> blockShift));
+        if(base >= 0)
+            return base + data->deltas[i];
+        return data->wideValues[((-base - 1) << blockShift) + (i & (blockSize - 1))];
+    }
+
+    //! Get one entry.
+    qint64 operator[](qint64 i) const { return at(i); }
+
+    //! Get the last entry, the index must not be empty.
+    qint64 last() const { return at(d->count - 1); }
+
+    //! Append an entry.
+    /*!
+      \param value The value to be appended.
+    */
+    void append(qint64 value);
+
+    //! Append entries of another index.
+    /*!
+      \param other The index with the entries to be appended.
+      \param from Position of the first entry to be appended.
+    */
+    void append(const QDltIndex &other, qint64 from = 0);
+
+    //! Remove all entries.
+    void clear();
+
+    //! Remove the entries behind a position.
+    /*!
+      \param size The new number of entries, the index is not changed if it is not smaller.
+    */
+    void truncate(qint64 size);
+
+    //! Reserve memory for a number of entries.
+    void reserve(qint64 size);
+
+    //! Find the first entry which is not less than a value, the index must be sorted.
+    /*!
+      \param value The value to search.
+      \return Position of the entry, size() if all entries are less.
+    */
+    qint64 lowerBound(qint64 value) const;
+
+    //! Convert the index into a vector.
+    QVector<qint64> toVector() const;
+
+    //! Get the memory used by the index in bytes.
+    qint64 memoryUsage() const;
+
+    //! Write the index to a cache file.
+    /*!
+      The bases and deltas are written as they are stored in memory,
+      so writing and reading needs only a few large transfers.
+    */
+    bool write(QIODevice &device) const;
+
+    //! Read the index from a cache file.
+    bool read(QIODevice &device);
+
+private:
+    QSharedDataPointer<QDltIndexData> d;
+};
+
+#endif // QDLT_INDEX_H
@@ -0,0 +1,264 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltmetadata.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <string.h>
+
+#include "qdltmetadata.h"
+
+extern "C"
+{
+#include "dlt_common.h"
+}
+
+QDltIdTable::QDltIdTable()
+{
+    clear();
+}
+
+void QDltIdTable::clear()
+{
+    ids.clear();
+    lookup.clear();
+
+    /* number 0 is always the empty id */
+    ids.append(QDltId());
+    lookup.insert(QDltId(), 0);
+}
+
+quint16 QDltIdTable::intern(QDltId id)
+{
+    QHash<QDltId,quint16>::const_iterator it = lookup.constFind(id);
+    if(it != lookup.constEnd())
+        return it.value();
+
+    if(ids.size() >= overflowId)
+        return overflowId;
+
+    quint16 num = static_cast<quint16>(ids.size());
+    ids.append(id);
+    lookup.insert(id, num);
+
+    return num;
+}
+
+QDltFileMetadata::QDltFileMetadata()
+{
+}
+
+void QDltFileMetadata::clear()
+{
+    ids.clear();
+    seconds.clear();
+    micros.clear();
+    timestamps.clear();
+    ecuids.clear();
+    apids.clear();
+    ctids.clear();
+    htyps.clear();
+    msins.clear();
+    counters.clear();
+    lengths.clear();
+}
+
+void QDltFileMetadata::truncate(qint64 size)
+{
+    seconds.truncate(size);
+    micros.truncate(size);
+    timestamps.truncate(size);
+    ecuids.truncate(size);
+    apids.truncate(size);
+    ctids.truncate(size);
+    htyps.truncate(size);
+    msins.truncate(size);
+    counters.truncate(size);
+    lengths.truncate(size);
+}
+
+void QDltFileMetadata::appendColumns(quint32 time, quint32 microseconds, quint32 timestamp, quint16 ecuid, quint16 apid, quint16 ctid,
+                                     quint8 htyp, quint8 msin, quint8 counter, quint16 length)
+{
+    seconds.append(time);
+    micros.append(microseconds);
+    timestamps.append(timestamp);
+    ecuids.append(ecuid);
+    apids.append(apid);
+    ctids.append(ctid);
+    htyps.append(htyp);
+    msins.append(msin);
+    counters.append(counter);
+    lengths.append(length);
+}
+
+void QDltFileMetadata::append(const char *data, qint64 size)
+{
+    const DltStorageHeader *storageheader = (const DltStorageHeader*) data;
+    const DltStandardHeader *standardheader = (const DltStandardHeader*) (data + sizeof(DltStorageHeader));
+    const char *extra = data + sizeof(DltStorageHeader) + sizeof(DltStandardHeader);
+    quint32 timestamp = 0;
+    quint16 ecuid, apid = 0, ctid = 0;
+    quint8 msin = 0;
+
+    /* keep columns in line with the index, even if the header is truncated */
+    if(size < (qint64) (sizeof(DltStorageHeader) + sizeof(DltStandardHeader)))
+    {
+        appendColumns(0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+        return;
+    }
+
+    qint64 headersize = sizeof(DltStorageHeader) + sizeof(DltStandardHeader) + DLT_STANDARD_HEADER_EXTRA_SIZE(standardheader->htyp) +
+            (DLT_IS_HTYP_UEH(standardheader->htyp) ? sizeof(DltExtendedHeader) : 0);
+    if(size < headersize)
+    {
+        appendColumns(storageheader->seconds, storageheader->microseconds, 0, ids.intern(QDltId(storageheader->ecu)), 0, 0,
+                      0, 0, standardheader->mcnt, DLT_SWAP_16(standardheader->len));
+        return;
+    }
+
+    /* extract ecu id */
+    if(DLT_IS_HTYP_WEID(standardheader->htyp))
+        ecuid = ids.intern(QDltId(extra));
+    else
+        ecuid = ids.intern(QDltId(storageheader->ecu));
+
+    /* extract timestamp */
+    if(DLT_IS_HTYP_WTMS(standardheader->htyp))
+    {
+        memcpy(&timestamp, extra + (DLT_IS_HTYP_WEID(standardheader->htyp) ? DLT_SIZE_WEID : 0)
+               + (DLT_IS_HTYP_WSID(standardheader->htyp) ? DLT_SIZE_WSID : 0), DLT_SIZE_WTMS);
+        timestamp = DLT_BETOH_32(timestamp);
+    }
+
+    /* extract application id, context id and message info */
+    if(DLT_IS_HTYP_UEH(standardheader->htyp))
+    {
+        const DltExtendedHeader *extendedheader = (const DltExtendedHeader*) (extra + DLT_STANDARD_HEADER_EXTRA_SIZE(standardheader->htyp));
+        apid = ids.intern(QDltId(extendedheader->apid));
+        ctid = ids.intern(QDltId(extendedheader->ctid));
+        msin = extendedheader->msin;
+    }
+
+    appendColumns(storageheader->seconds, storageheader->microseconds, timestamp, ecuid, apid, ctid,
+                  standardheader->htyp, msin, standardheader->mcnt, DLT_SWAP_16(standardheader->len));
+}
+
+void QDltFileMetadata::append(const QDltFileMetadata &other, qint64 from)
+{
+    QVector<quint16> mapping(other.ids.size());
+
+    /* map the ids of the other table to this table */
+    for(int num=0;num<other.ids.size();num++)
+        mapping[num] = ids.intern(other.ids.id(static_cast<quint16>(num)));
+
+    for(qint64 num=from;num<other.size();num++)
+    {
+        appendColumns(other.seconds.at(num), other.micros.at(num), other.timestamps.at(num),
+                      mapping.value(other.ecuids.at(num), QDltIdTable::overflowId),
+                      mapping.value(other.apids.at(num), QDltIdTable::overflowId),
+                      mapping.value(other.ctids.at(num), QDltIdTable::overflowId),
+                      other.htyps.at(num), other.msins.at(num), other.counters.at(num), other.lengths.at(num));
+    }
+}
+
+bool QDltFileMetadata::getMetadata(qint64 index, QDltMsgMetadata &metadata) const
+{
+    if(index < 0 || index >= size())
+        return false;
+
+    unsigned char htyp = htyps.at(index);
+    unsigned char msin = msins.at(index);
+
+    metadata.time = seconds.at(index);
+    metadata.microseconds = micros.at(index);
+    metadata.timestamp = timestamps.at(index);
+    metadata.ecuid = ids.id(ecuids.at(index));
+    metadata.apid = ids.id(apids.at(index));
+    metadata.ctid = ids.id(ctids.at(index));
+    metadata.messageCounter = counters.at(index);
+    metadata.length = lengths.at(index);
+
+    if(DLT_IS_HTYP_UEH(htyp))
+    {
+        metadata.type = (QDltMsg::DltTypeDef) DLT_GET_MSIN_MSTP(msin);
+        metadata.subtype = DLT_GET_MSIN_MTIN(msin);
+        metadata.mode = DLT_IS_MSIN_VERB(msin) ? QDltMsg::DltModeVerbose : QDltMsg::DltModeNonVerbose;
+    }
+    else
+    {
+        metadata.type = QDltMsg::DltTypeUnknown;
+        metadata.subtype = QDltMsg::DltLogUnknown;
+        metadata.mode = QDltMsg::DltModeNonVerbose;
+    }
+
+    return true;
+}
+
+bool QDltFileMetadata::write(QIODevice &device) const
+{
+    qint64 count = size();
+    qint32 idCount = ids.size();
+
+    if(device.write((const char*) &count, sizeof(count)) != sizeof(count))
+        return false;
+    if(device.write((const char*) &idCount, sizeof(idCount)) != sizeof(idCount))
+        return false;
+    for(int num=0;num<idCount;num++)
+    {
+        quint32 value = ids.id(static_cast<quint16>(num)).toValue();
+        if(device.write((const char*) &value, sizeof(value)) != sizeof(value))
+            return false;
+    }
+
+    return seconds.write(device) && micros.write(device) && timestamps.write(device) &&
+            ecuids.write(device) && apids.write(device) && ctids.write(device) &&
+            htyps.write(device) && msins.write(device) && counters.write(device) && lengths.write(device);
+}
+
+bool QDltFileMetadata::read(QIODevice &device)
+{
+    qint64 count;
+    qint32 idCount;
+
+    clear();
+
+    if(device.read((char*) &count, sizeof(count)) != sizeof(count) || count < 0)
+        return false;
+    if(device.read((char*) &idCount, sizeof(idCount)) != sizeof(idCount) || idCount < 1 || idCount > QDltIdTable::overflowId)
+        return false;
+
+    /* the ids are interned in the same order, so the numbers stay the same */
+    for(int num=0;num<idCount;num++)
+    {
+        quint32 value;
+        if(device.read((char*) &value, sizeof(value)) != sizeof(value))
+            return false;
+        if(ids.intern(QDltId::fromValue(value)) != num)
+        {
+            clear();
+            return false;
+        }
+    }
+
+    if(seconds.read(device, count) && micros.read(device, count) && timestamps.read(device, count) &&
+       ecuids.read(device, count) && apids.read(device, count) && ctids.read(device, count) &&
+       htyps.read(device, count) && msins.read(device, count) && counters.read(device, count) && lengths.read(device, count))
+        return true;
+
+    clear();
+    return false;
+}
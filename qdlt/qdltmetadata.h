@@ -0,0 +1,264 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltmetadata.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef QDLT_METADATA_H
+#define QDLT_METADATA_H
+
+#include <QVector>
+#include <QString>
+#include <QHash>
+#include <QIODevice>
+#include <time.h>
+
+#include "export_rules.h"
+#include "qdltid.h"
+#include "qdltmsg.h"
+
+//! Header information of one DLT message stored in the metadata of a DLT log file.
+struct QDLT_EXPORT QDltMsgMetadata
+{
+    //! Time of the storage header in seconds.
+    time_t time;
+
+    //! Microseconds of the storage header.
+    unsigned int microseconds;
+
+    //! Timestamp of the ECU in 0.1 milliseconds, 0 if not sent.
+    unsigned int timestamp;
+
+    //! ECU id, application id and context id.
+    QDltId ecuid;
+    QDltId apid;
+    QDltId ctid;
+
+    //! Type, subtype and mode of the message.
+    QDltMsg::DltTypeDef type;
+    int subtype;
+    QDltMsg::DltModeDef mode;
+
+    //! Message counter of the standard header.
+    unsigned char messageCounter;
+
+    //! Length of the message without storage header.
+    unsigned short length;
+};
+
+//! Table of interned DLT ids.
+/*!
+  Each ECU id, application id and context id is stored once and referenced by
+  a small number. Number 0 is the empty id.
+*/
+class QDLT_EXPORT QDltIdTable
+{
+public:
+    //! Number used for ids which do not fit into the table anymore.
+    static const quint16 overflowId = 0xffff;
+
+    //! The constructor.
+    QDltIdTable();
+
+    //! Get the number of an id, add the id if it is not in the table yet.
+    /*!
+      \param id The id.
+      \return The number of the id, overflowId if the table is full.
+    */
+    quint16 intern(QDltId id);
+
+    //! Get the number of an id without adding it.
+    /*!
+      \param id The id.
+      \return The number of the id, overflowId if the id is not in the table.
+    */
+    quint16 find(QDltId id) const { return lookup.value(id, overflowId); }
+
+    //! Get the id with a number.
+    QDltId id(quint16 num) const { return num < ids.size() ? ids.at(num) : QDltId(); }
+
+    //! Number of ids in the table.
+    int size() const { return ids.size(); }
+
+    //! Remove all ids except the empty id.
+    void clear();
+
+private:
+    QVector<QDltId> ids;
+    QHash<QDltId,quint16> lookup;
+};
+
+//! One column of the metadata, split into blocks so it can hold more than 2^31 values.
+template <typename T>
+class QDltMetadataColumn
+{
+public:
+    static const int blockShift = 16;
+    static const int blockSize = 1 << blockShift;
+
+    QDltMetadataColumn() : count(0) {}
+
+    qint64 size() const { return count; }
+
+    T at(qint64 i) const { return blocks.at(static_cast<int>(i >> blockShift)).at(static_cast<int>(i & (blockSize - 1))); }
+
+    void append(T value)
+    {
+        if((count & (blockSize - 1)) == 0)
+        {
+            blocks.append(QVector<T>());
+            blocks.last().reserve(blockSize);
+        }
+        blocks.last().append(value);
+        count++;
+    }
+
+    void clear() { blocks.clear(); count = 0; }
+
+    void truncate(qint64 size)
+    {
+        if(size < 0 || size >= count)
+            return;
+        blocks.resize(static_cast<int>((size + blockSize - 1) >> blockShift));
+        if(size & (blockSize - 1))
+            blocks.last().resize(static_cast<int>(size & (blockSize - 1)));
+        count = size;
+    }
+
+    bool write(QIODevice &device) const
+    {
+        for(int num=0;num<blocks.size();num++)
+        {
+            qint64 length = blocks.at(num).size() * static_cast<qint64>(sizeof(T));
+            if(device.write((const char*)blocks.at(num).constData(), length) != length)
+                return false;
+        }
+        return true;
+    }
+
+    bool read(QIODevice &device, qint64 size)
+    {
+        clear();
+        while(count < size)
+        {
+            int length = static_cast<int>(qMin(size - count, static_cast<qint64>(blockSize)));
+            QVector<T> block(length);
+            if(device.read((char*)block.data(), length * static_cast<qint64>(sizeof(T))) != length * static_cast<qint64>(sizeof(T)))
+            {
+                clear();
+                return false;
+            }
+            blocks.append(block);
+            count += length;
+        }
+        return true;
+    }
+
+private:
+    QVector<QVector<T> > blocks;
+    qint64 count;
+};
+
+//! Header metadata of all messages of a DLT log file.
+/*!
+  The metadata is filled while the file is indexed, in the same order as the index
+  of all messages. The header fields are stored column by column and ids are
+  interned, so filtering by header fields and sorting by time does not need to
+  read and parse the messages from the log file again.
+*/
+class QDLT_EXPORT QDltFileMetadata
+{
+public:
+    //! Maximum size of storage header, standard header with extra fields and extended header.
+    static const int maxHeaderSize = 16 + 4 + 12 + 10;
+
+    //! The constructor.
+    QDltFileMetadata();
+
+    //! Number of messages.
+    qint64 size() const { return lengths.size(); }
+
+    //! Remove all messages.
+    void clear();
+
+    //! Remove the messages behind a position, the interned ids are kept.
+    /*!
+      \param size The new number of messages.
+    */
+    void truncate(qint64 size);
+
+    //! Add the header of a message.
+    /*!
+      \param data The message beginning with the storage header.
+      \param size The number of bytes available at data.
+    */
+    void append(const char *data, qint64 size);
+
+    //! Add messages of another metadata, ids are mapped to this table.
+    /*!
+      \param other The metadata with the messages to be added.
+      \param from Number of the first message to be added.
+    */
+    void append(const QDltFileMetadata &other, qint64 from = 0);
+
+    //! Get the header information of a message.
+    /*!
+      \param index The number of the message.
+      \param metadata The header information.
+      \return false if the index is out of range.
+    */
+    bool getMetadata(qint64 index, QDltMsgMetadata &metadata) const;
+
+    //! Columns of the metadata.
+    time_t getTime(qint64 index) const { return seconds.at(index); }
+    unsigned int getMicroseconds(qint64 index) const { return micros.at(index); }
+    unsigned int getTimestamp(qint64 index) const { return timestamps.at(index); }
+    quint16 getEcuidNumber(qint64 index) const { return ecuids.at(index); }
+    quint16 getApidNumber(qint64 index) const { return apids.at(index); }
+    quint16 getCtidNumber(qint64 index) const { return ctids.at(index); }
+    unsigned char getHtyp(qint64 index) const { return htyps.at(index); }
+    unsigned char getMsin(qint64 index) const { return msins.at(index); }
+    unsigned char getMessageCounter(qint64 index) const { return counters.at(index); }
+    unsigned short getLength(qint64 index) const { return lengths.at(index); }
+
+    //! The table of interned ids.
+    const QDltIdTable &getIds() const { return ids; }
+
+    //! Write the metadata to a cache file.
+    bool write(QIODevice &device) const;
+
+    //! Read the metadata from a cache file.
+    bool read(QIODevice &device);
+
+private:
+    void appendColumns(quint32 time, quint32 microseconds, quint32 timestamp, quint16 ecuid, quint16 apid, quint16 ctid,
+                       quint8 htyp, quint8 msin, quint8 counter, quint16 length);
+
+    QDltIdTable ids;
+
+    QDltMetadataColumn<quint32> seconds;
+    QDltMetadataColumn<quint32> micros;
+    QDltMetadataColumn<quint32> timestamps;
+    QDltMetadataColumn<quint16> ecuids;
+    QDltMetadataColumn<quint16> apids;
+    QDltMetadataColumn<quint16> ctids;
+    QDltMetadataColumn<quint8> htyps;
+    QDltMetadataColumn<quint8> msins;
+    QDltMetadataColumn<quint8> counters;
+    QDltMetadataColumn<quint16> lengths;
+};
+
+#endif // QDLT_METADATA_H
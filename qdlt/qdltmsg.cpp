@@ -20,6 +20,7 @@
  */
 
 #include <QtDebug>
+#include <QThread>
 
 #include "qdlt.h"
 
@@ -33,11 +34,56 @@ QDltMsg::QDltMsg()
     clear();
 }
 
+QDltMsg::QDltMsg(const QDltMsg &other)
+    : QDlt(other)
+{
+    *this = other;
+}
+
 QDltMsg::~QDltMsg()
 {
 
 }
 
+QDltMsg& QDltMsg::operator= (const QDltMsg &other)
+{
+    if(this == &other)
+        return *this;
+
+    /* the arguments of the other message must not be decoded while they are copied */
+    int state = other.lockArguments();
+
+    QDlt::operator=(other);
+    ecuid = other.ecuid;
+    apid = other.apid;
+    ctid = other.ctid;
+    type = other.type;
+    subtype = other.subtype;
+    mode = other.mode;
+    endianness = other.endianness;
+    time = other.time;
+    microseconds = other.microseconds;
+    timestamp = other.timestamp;
+    sessionid = other.sessionid;
+    sessionName = other.sessionName;
+    messageCounter = other.messageCounter;
+    numberOfArguments = other.numberOfArguments;
+    buffer = other.buffer;
+    header = other.header;
+    headerSize = other.headerSize;
+    payload = other.payload;
+    payloadSize = other.payloadSize;
+    messageId = other.messageId;
+    ctrlServiceId = other.ctrlServiceId;
+    ctrlReturnType = other.ctrlReturnType;
+    arguments = other.arguments;
+    argumentsState.storeRelease(state);
+
+    other.unlockArguments(state);
+
+    return *this;
+}
+
 QString QDltMsg::getTypeString() const
 {
     return QString((type>=0 && type<=7)?qDltMessageType[type]:"");
@@ -138,10 +184,8 @@ QString QDltMsg::getGmTimeWithOffsetString(qlonglong offset, bool dst)
 }
 
 
-bool QDltMsg::setMsg(const QByteArray& buf, bool withStorageHeader)
+bool QDltMsg::setMsg(const QByteArray& buf, bool withStorageHeader, bool lazyArguments, bool zeroCopy)
 {
-    unsigned int offset;
-    QDltArgument argument;
     const DltStorageHeader *storageheader = 0;
     const DltStandardHeader *standardheader = 0;
     const DltExtendedHeader *extendedheader = 0;
@@ -191,8 +235,14 @@ bool QDltMsg::setMsg(const QByteArray& buf, bool withStorageHeader)
     /* store header size */
     headerSize = headersize;
 
-    /* copy header */
-    header = buf.mid(0,headersize);
+    /* copy header, or share the buffer and reference it */
+    if(zeroCopy) {
+        buffer = buf;
+        header = QByteArray::fromRawData(buffer.constData(),headersize);
+    }
+    else {
+        header = buf.mid(0,headersize);
+    }
 
     /* load standard header extra parameters and Extended header if used */
     if (extra_size>0)
@@ -230,24 +280,24 @@ bool QDltMsg::setMsg(const QByteArray& buf, bool withStorageHeader)
     /* extract ecu id */
     if ( DLT_IS_HTYP_WEID(standardheader->htyp) )
     {
-        ecuid = QString(QByteArray(headerextra.ecu,4));
+        ecuid = QDltId(headerextra.ecu);
     }
     else
     {
         if(storageheader)
-            ecuid = QString(QByteArray(storageheader->ecu,4));
+            ecuid = QDltId(storageheader->ecu);
     }
 
     /* extract application id */
     if ((DLT_IS_HTYP_UEH(standardheader->htyp)) && (extendedheader->apid[0]!=0))
     {
-        apid = QString(QByteArray(extendedheader->apid,4));
+        apid = QDltId(extendedheader->apid);
     }
 
     /* extract context id */
     if ((DLT_IS_HTYP_UEH(standardheader->htyp)) && (extendedheader->ctid[0]!=0))
     {
-        ctid = QString(QByteArray(extendedheader->ctid,4));
+        ctid = QDltId(extendedheader->ctid);
     }
 
     /* extract type */
@@ -317,8 +367,12 @@ bool QDltMsg::setMsg(const QByteArray& buf, bool withStorageHeader)
     }
 
     /* copy payload */
-    if(payloadSize>0)
-        payload = buf.mid(headersize,payloadSize);
+    if(payloadSize>0) {
+        if(zeroCopy)
+            payload = QByteArray::fromRawData(buffer.constData()+headersize,payloadSize);
+        else
+            payload = buf.mid(headersize,payloadSize);
+    }
 
     /* set messageid if non verbose */
     if((mode == DltModeNonVerbose) && payload.size()>=4) {
@@ -346,20 +400,59 @@ bool QDltMsg::setMsg(const QByteArray& buf, bool withStorageHeader)
 
     /* get the arguments of the payload */
     if(mode==DltModeVerbose) {
-        offset = 0;
-        arguments.clear();
-        for(int num=0;num<numberOfArguments;num++) {
-            if(argument.setArgument(payload,offset,endianness)==false) {
-                /* There was an error parsing the arguments */
-                return false;
-            }
-            arguments.append(argument);
-        }
+        argumentsState.storeRelease(ArgumentsPending);
+        if(!lazyArguments)
+            return decodeArguments();
     }
 
     return true;
 }
 
+bool QDltMsg::decodeArguments() const
+{
+    unsigned int offset = 0;
+    QDltArgument argument;
+    QByteArray data = payload;
+
+    /* decoded arguments are not changed anymore by const functions */
+    if(argumentsState.loadAcquire() == ArgumentsDecoded)
+        return true;
+
+    /* another thread could decode the arguments at the same time */
+    if(lockArguments() != ArgumentsPending)
+    {
+        unlockArguments(ArgumentsDecoded);
+        return true;
+    }
+
+    bool success = true;
+    arguments.clear();
+    for(int num=0;num<numberOfArguments;num++) {
+        if(argument.setArgument(data,offset,endianness,buffer)==false) {
+            /* There was an error parsing the arguments */
+            success = false;
+            break;
+        }
+        arguments.append(argument);
+    }
+
+    unlockArguments(ArgumentsDecoded);
+
+    return success;
+}
+
+int QDltMsg::lockArguments() const
+{
+    /* the arguments are locked only while they are decoded or copied, so wait shortly */
+    for(;;)
+    {
+        int state = argumentsState.loadAcquire();
+        if(state != ArgumentsLocked && argumentsState.testAndSetAcquire(state, ArgumentsLocked))
+            return state;
+        QThread::yieldCurrentThread();
+    }
+}
+
 bool QDltMsg::getMsg(QByteArray &buf,bool withStorageHeader) {
     DltStorageHeader storageheader;
     DltStandardHeader standardheader;
@@ -370,6 +463,7 @@ bool QDltMsg::getMsg(QByteArray &buf,bool withStorageHeader) {
     buf.clear();
 
     /* prepare payload */
+    decodeArguments();
     payload.clear();
     for (int num = 0;num<arguments.size();num++)
     {
@@ -384,7 +478,7 @@ bool QDltMsg::getMsg(QByteArray &buf,bool withStorageHeader) {
         storageheader.pattern[1] = 'L';
         storageheader.pattern[2] = 'T';
         storageheader.pattern[3] = 0x01;
-        strncpy(storageheader.ecu,ecuid.toLatin1().constData(),ecuid.size()>3?4:ecuid.size()+1);
+        ecuid.toChars(storageheader.ecu);
         storageheader.microseconds = microseconds;
         storageheader.seconds = time;
         buf += QByteArray((const char *)&storageheader,sizeof(DltStorageHeader));
@@ -411,7 +505,7 @@ bool QDltMsg::getMsg(QByteArray &buf,bool withStorageHeader) {
 
     /* write standard header extra */
     if(mode == DltModeVerbose) {
-        strncpy(headerextra.ecu,ecuid.toLatin1().constData(),ecuid.size()>3?4:ecuid.size()+1);
+        ecuid.toChars(headerextra.ecu);
         buf += QByteArray((const char *)&(headerextra.ecu),sizeof(headerextra.ecu));
         headerextra.seid = DLT_SWAP_32(sessionid);
         buf += QByteArray((const char *)&(headerextra.seid),sizeof(headerextra.seid));
@@ -421,8 +515,8 @@ bool QDltMsg::getMsg(QByteArray &buf,bool withStorageHeader) {
 
     /* write extendedheader */
     if(mode == DltModeVerbose) {
-        strncpy(extendedheader.apid,apid.toLatin1().constData(),apid.size()>3?4:apid.size()+1);
-        strncpy(extendedheader.ctid,ctid.toLatin1().constData(),ctid.size()>3?4:ctid.size()+1);
+        apid.toChars(extendedheader.apid);
+        ctid.toChars(extendedheader.ctid);
         extendedheader.msin = 0;
         if(mode == DltModeVerbose) {
             extendedheader.msin |= DLT_MSIN_VERB;
@@ -442,9 +536,9 @@ bool QDltMsg::getMsg(QByteArray &buf,bool withStorageHeader) {
 
 void QDltMsg::clear()
 {
-    ecuid.clear();
-    apid.clear();
-    ctid.clear();
+    ecuid = QDltId();
+    apid = QDltId();
+    ctid = QDltId();
     type = DltTypeUnknown;
     subtype = DltLogUnknown;
     mode = DltModeUnknown;
@@ -459,24 +553,31 @@ void QDltMsg::clear()
     ctrlServiceId = 0;
     ctrlReturnType = 0;
     arguments.clear();
+    argumentsState.storeRelease(ArgumentsDecoded);
     payload.clear();
     payloadSize = 0;
     header.clear();
     headerSize = 0;
+    buffer.clear();
 }
 
 void QDltMsg::clearArguments()
 {
+    argumentsState.storeRelease(ArgumentsDecoded);
     arguments.clear();
 }
 
 int QDltMsg::sizeArguments() const
 {
+    decodeArguments();
+
     return arguments.size();
 }
 
 bool QDltMsg::getArgument(int index,QDltArgument &argument) const
 {
+      decodeArguments();
+
       if(index<0 || index>=arguments.size())
           return false;
 
@@ -487,6 +588,8 @@ bool QDltMsg::getArgument(int index,QDltArgument &argument) const
 
 void QDltMsg::addArgument(QDltArgument argument, int index)
 {
+    decodeArguments();
+
     if(index == -1)
         arguments.append(argument);
     else
@@ -495,6 +598,8 @@ void QDltMsg::addArgument(QDltArgument argument, int index)
 
 void QDltMsg::removeArgument(int index)
 {
+    decodeArguments();
+
     arguments.removeAt(index);
 }
 
@@ -616,6 +721,7 @@ QString QDltMsg::toStringPayload() const
         return text;
     }
 
+    decodeArguments();
     for(int num=0;num<arguments.size();num++) {
         if(getArgument(num,argument)) {
             if(num!=0) {
@@ -28,14 +28,18 @@
 #include <QDateTime>
 //#include <QColor>
 #include <QMutex>
+#include <QAtomicInt>
 #include <time.h>
 
 #include "export_rules.h"
+#include "qdltid.h"
 
 //! Access to a DLT message.
 /*!
   This class provide access to a single DLT message from a DLT log file.
-  This class is currently not thread safe.
+  This class is currently not thread safe, except that const functions and copying
+  a message can be used from several threads at once, also if the arguments are decoded
+  on first access.
 */
 class QDLT_EXPORT QDltMsg : public QDlt
 {
@@ -46,11 +50,23 @@ public:
     */
     QDltMsg();
 
+    //! Copy constructor.
+    /*!
+      The other message can be accessed by other threads while it is copied.
+    */
+    QDltMsg(const QDltMsg &other);
+
     //! Destructor.
     /*!
     */
     ~QDltMsg();
 
+    //! Copy operator.
+    /*!
+      The other message can be accessed by other threads while it is copied.
+    */
+    QDltMsg& operator= (const QDltMsg &other);
+
     //! The type of the DLT message.
     typedef enum { DltTypeUnknown = -2, DltTypeLog = 0,DltTypeAppTrace,DltTypeNwTrace,DltTypeControl } DltTypeDef;
 
@@ -161,37 +177,58 @@ public:
     /*!
       \return The ecu id of the DLT message.
     */
-    QString getEcuid() const { return ecuid; }
+    QString getEcuid() const { return ecuid.toString(); }
+
+    //! Get the ecu id of the DLT message for comparison.
+    /*!
+      \return The ecu id of the DLT message.
+    */
+    QDltId getEcuidId() const { return ecuid; }
 
     //! Set the ecu id of the DLT message.
     /*!
       \param _ecuid The ecu id of the DLT message.
     */
-    void setEcuid(QString _ecuid) { ecuid = _ecuid; }
+    void setEcuid(QString _ecuid) { ecuid = QDltId(_ecuid); }
+    void setEcuid(QDltId _ecuid) { ecuid = _ecuid; }
 
     //! Get the application id of the DLT message.
     /*!
       \return The application id.
     */
-    QString getApid() const { return apid; }
+    QString getApid() const { return apid.toString(); }
+
+    //! Get the application id of the DLT message for comparison.
+    /*!
+      \return The application id.
+    */
+    QDltId getApidId() const { return apid; }
 
     //! Set the application id of the DLT message.
     /*!
       \param id The application id.
     */
-    void setApid(QString id) { apid = id; }
+    void setApid(QString id) { apid = QDltId(id); }
+    void setApid(QDltId id) { apid = id; }
 
     //! Get the context id of the DLT message.
     /*!
       \return The contex id.
     */
-    QString getCtid() const { return ctid; }
+    QString getCtid() const { return ctid.toString(); }
+
+    //! Get the context id of the DLT message for comparison.
+    /*!
+      \return The contex id.
+    */
+    QDltId getCtidId() const { return ctid; }
 
     //! Set the context id of the DLT message.
     /*!
       \param id The context id.
     */
-    void setCtid(QString id) { ctid = id; }
+    void setCtid(QString id) { ctid = QDltId(id); }
+    void setCtid(QDltId id) { ctid = id; }
 
     //! Get the type of the DLT message.
     /*!
@@ -227,7 +264,7 @@ public:
       \sa DltEndiannessDef
       \param _endianness The endianness of the DLT message.
     */
-    void setEndianness(DltEndiannessDef _endianness) { endianness = _endianness; }
+    void setEndianness(DltEndiannessDef _endianness) { decodeArguments(); endianness = _endianness; }
 
     //! Get the text of the endianness of the DLT message.
     /*!
@@ -273,7 +310,7 @@ public:
       DLT Ctrl messages are also in non-verbose mode.
       \param _mode The mode of the DLT message.
     */
-    void setMode(DltModeDef _mode) { mode = _mode; }
+    void setMode(DltModeDef _mode) { decodeArguments(); mode = _mode; }
 
     //! Get the text of the mode (verbose or non-verbose).
     /*!
@@ -297,13 +334,13 @@ public:
       E.g. if a non-verbose message is decoded these two parameters are different.
       \param noargs The number of arguments in the payload.
     */
-    void setNumberOfArguments(unsigned char noargs) { numberOfArguments = noargs; }
+    void setNumberOfArguments(unsigned char noargs) { decodeArguments(); numberOfArguments = noargs; }
 
     //! Get the complete header of the DLT message.
     /*!
       \return Byte Array containing the complete header of the DLT message.
     */
-    QByteArray getHeader() const { return header; }
+    QByteArray getHeader() const { return buffer.isNull() ? header : QByteArray(header.constData(),header.size()); }
 
     //! Get the size of the header.
     /*!
@@ -316,7 +353,7 @@ public:
     /*!
       \return Byte Array containing the complete payload of the DLT message.
     */
-    QByteArray getPayload() const { return payload; }
+    QByteArray getPayload() const { return buffer.isNull() ? payload : QByteArray(payload.constData(),payload.size()); }
 
     //! Get the size of the payload.
     /*!
@@ -403,11 +440,20 @@ public:
       corresponding buffers. If it fails, but at least the header can be read, the payload
       size can be retrieved, which is perhaps wrong.
       This function returns false, if an error in the decoded message was found.
+      If lazyArguments is set, only the header is parsed. The arguments of a verbose message
+      are decoded on first access, e.g. by getArgument(), sizeArguments() or toStringPayload(),
+      and errors in the arguments are not reported by this function.
+      If zeroCopy is set, the header, the payload and the argument data are not copied, but
+      reference buf, which is shared with the message. Data is only copied when the message is
+      changed. If buf itself references external memory, e.g. a memory mapped file,
+      the message is only valid as long as this memory.
       \param buf the buffer containing the DLT messages.
       \param withSH message to be parsed contains storage header, default true.
+      \param lazyArguments decode the arguments on first access, default false.
+      \param zeroCopy reference buf instead of copying the data, default false.
       \return True if the operation was successful, false if there was an error.
     */
-    bool setMsg(const QByteArray& buf,bool withStorageHeader = true);
+    bool setMsg(const QByteArray& buf,bool withStorageHeader = true,bool lazyArguments = false,bool zeroCopy = false);
 
     //! Get the message written into a byte array containing the DLT message.
     /*!
@@ -436,14 +482,35 @@ protected:
 
 private:
 
+    //! Decode the arguments of the payload, if this was deferred by setMsg().
+    /*!
+      \return True if the arguments were decoded successfully or there was nothing to decode.
+    */
+    bool decodeArguments() const;
+
+    //! State of the arguments.
+    typedef enum { ArgumentsDecoded = 0, ArgumentsPending, ArgumentsLocked } ArgumentsState;
+
+    //! Lock the arguments, so they are not decoded or copied by another thread.
+    /*!
+      \return The state of the arguments before they were locked.
+    */
+    int lockArguments() const;
+
+    //! Unlock the arguments.
+    /*!
+      \param state The new state of the arguments.
+    */
+    void unlockArguments(int state) const { argumentsState.storeRelease(state); }
+
     //! The header parameter ECU Id.
-    QString ecuid;
+    QDltId ecuid;
 
     //! The header parameter application Id.
-    QString apid;
+    QDltId apid;
 
     //! The header parameter context Id.
-    QString ctid;
+    QDltId ctid;
 
     //! The header parameter type of the message.
     DltTypeDef type;
@@ -478,6 +545,9 @@ private:
     //! The number of arguments of the DLT message.
     unsigned char numberOfArguments;
 
+    //! The buffer referenced by header, payload and arguments, if the message was set without copying.
+    QByteArray buffer;
+
     //! The complete header of the DLT message.
     QByteArray header;
     int headerSize;
@@ -495,8 +565,11 @@ private:
     //! The return type if the message is a ctrl response message.
     unsigned char ctrlReturnType;
 
-    //! List of arguments of the DLT message.
-    QList<QDltArgument> arguments;
+    //! List of arguments of the DLT message, filled on first access if the arguments are pending.
+    mutable QList<QDltArgument> arguments;
+
+    //! ArgumentsPending if the arguments of the payload are not decoded yet.
+    mutable QAtomicInt argumentsState;
 };
 
 #endif // QDLT_MSG_H
@@ -0,0 +1,141 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltmsgcache.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+
+#include <QMutexLocker>
+
+#include "qdltmsgcache.h"
+#include "qdltfile.h"
+#include "qdltpluginmanager.h"
+
+void QDltMsgCacheEntry::render()
+{
+    header = msg.toStringHeader();
+    payload = msg.toStringPayload();
+}
+
+QDltMsgCache::QDltMsgCache(int budget)
+    : cache(budget),
+      hits(0),
+      misses(0)
+{
+}
+
+void QDltMsgCache::setBudget(int budget)
+{
+    QMutexLocker locker(&mutex);
+    cache.setMaxCost(budget);
+}
+
+int QDltMsgCache::getBudget() const
+{
+    QMutexLocker locker(&mutex);
+    return cache.maxCost();
+}
+
+void QDltMsgCache::clear()
+{
+    QMutexLocker locker(&mutex);
+    cache.clear();
+}
+
+bool QDltMsgCache::find(qint64 index, const QByteArray &configuration, QDltMsgCacheEntry &entry)
+{
+    QMutexLocker locker(&mutex);
+
+    /* the lookup makes the message the most recently used one */
+    Item *item = cache.object(index);
+    if(!item || item->configuration != configuration)
+    {
+        misses++;
+        return false;
+    }
+
+    hits++;
+    entry = item->entry;
+    return true;
+}
+
+bool QDltMsgCache::insert(qint64 index, const QByteArray &configuration, const QDltMsgCacheEntry &entry)
+{
+    /* estimated size of the message data, the arguments and the text */
+    qint64 cost = static_cast<qint64>(sizeof(Item)) + 2 * (static_cast<qint64>(entry.msg.getHeaderSize()) + entry.msg.getPayloadSize()) +
+            static_cast<qint64>(sizeof(QChar)) * (entry.header.size() + entry.payload.size());
+
+    QMutexLocker locker(&mutex);
+
+    /* QCache deletes an item bigger than the budget at once, it is not copied at all */
+    if(cost > cache.maxCost())
+    {
+        cache.remove(index);
+        return false;
+    }
+
+    Item *item = new Item();
+    item->configuration = configuration;
+    item->entry = entry;
+
+    /* the item is owned by the cache, it must not be used after inserting */
+    return cache.insert(index, item, static_cast<int>(cost));
+}
+
+bool QDltMsgCache::getMsg(const QDltFile &file, qint64 index, QDltPluginManager *pluginManager, bool triggeredByUser, QDltMsgCacheEntry &entry)
+{
+    QByteArray configuration = pluginManager ? pluginManager->getDecoderConfiguration() : QByteArray();
+
+    if(find(index, configuration, entry))
+        return true;
+
+    /* the message is copied, it must stay valid when the file is closed */
+    entry.msg.clear();
+    if(!file.getMsg(index, entry.msg))
+        return false;
+    if(pluginManager)
+        pluginManager->decodeMsg(entry.msg, triggeredByUser);
+    entry.render();
+
+    /* a message bigger than the budget is returned without caching it */
+    insert(index, configuration, entry);
+
+    return true;
+}
+
+int QDltMsgCache::size() const
+{
+    QMutexLocker locker(&mutex);
+    return cache.size();
+}
+
+int QDltMsgCache::memoryUsage() const
+{
+    QMutexLocker locker(&mutex);
+    return cache.totalCost();
+}
+
+qint64 QDltMsgCache::getHits() const
+{
+    QMutexLocker locker(&mutex);
+    return hits;
+}
+
+qint64 QDltMsgCache::getMisses() const
+{
+    QMutexLocker locker(&mutex);
+    return misses;
+}
@@ -0,0 +1,137 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltmsgcache.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+
+#ifndef QDLT_MSGCACHE_H
+#define QDLT_MSGCACHE_H
+
+#include <QCache>
+#include <QMutex>
+#include <QString>
+#include <QByteArray>
+
+#include "export_rules.h"
+#include "qdltmsg.h"
+
+class QDltFile;
+class QDltPluginManager;
+
+//! A decoded DLT message with its header and payload text.
+class QDLT_EXPORT QDltMsgCacheEntry
+{
+public:
+    //! The message decoded by the decoder plugins.
+    QDltMsg msg;
+
+    //! The text of msg.toStringHeader().
+    QString header;
+
+    //! The text of msg.toStringPayload().
+    QString payload;
+
+    //! Create the header and payload text of the message.
+    void render();
+};
+
+//! Cache of decoded DLT messages shared by the views, the search and the export.
+/*!
+  Reading, decoding and printing a message is done once for recently used messages
+  instead of each time a view, the search, a marker or the export needs the message.
+  Messages are stored with the number of the message in the file and a hash of the
+  configuration of the decoder plugins, and the least recently used messages are
+  removed when the memory budget is exceeded.
+  All functions can be called from several threads at once.
+*/
+class QDLT_EXPORT QDltMsgCache
+{
+public:
+    //! Default memory budget in bytes.
+    static const int defaultBudget = 32 * 1024 * 1024;
+
+    //! The constructor.
+    /*!
+      \param budget The memory budget in bytes.
+    */
+    QDltMsgCache(int budget = defaultBudget);
+
+    //! Set the memory budget, messages are removed if the cache is bigger.
+    void setBudget(int budget);
+
+    //! Get the memory budget in bytes.
+    int getBudget() const;
+
+    //! Remove all messages, e.g. if the file is closed.
+    void clear();
+
+    //! Get a message from the cache.
+    /*!
+      \param index The number of the message in the file.
+      \param configuration The configuration of the decoder plugins used for the message.
+      \param entry The decoded message and its text.
+      \return true if the message was found.
+    */
+    bool find(qint64 index, const QByteArray &configuration, QDltMsgCacheEntry &entry);
+
+    //! Add a message to the cache.
+    /*!
+      \param index The number of the message in the file.
+      \param configuration The configuration of the decoder plugins used for the message.
+      \param entry The decoded message and its text, must not reference a memory mapped file.
+      \return false if the message is bigger than the memory budget and was not added.
+    */
+    bool insert(qint64 index, const QByteArray &configuration, const QDltMsgCacheEntry &entry);
+
+    //! Get a message from the cache, or read, decode and add it to the cache.
+    /*!
+      \param file The file containing the message.
+      \param index The number of the message in the file.
+      \param pluginManager The decoder plugins, or 0 if the message is not decoded.
+      \param triggeredByUser Passed to the decoder plugins.
+      \param entry The decoded message and its text.
+      \return false if the message could not be read.
+    */
+    bool getMsg(const QDltFile &file, qint64 index, QDltPluginManager *pluginManager, bool triggeredByUser, QDltMsgCacheEntry &entry);
+
+    //! Get the number of messages in the cache.
+    int size() const;
+
+    //! Get the estimated memory used by the messages in bytes.
+    int memoryUsage() const;
+
+    //! Get the number of lookups which found a message.
+    qint64 getHits() const;
+
+    //! Get the number of lookups which did not find a message.
+    qint64 getMisses() const;
+
+private:
+    class Item
+    {
+    public:
+        QByteArray configuration;
+        QDltMsgCacheEntry entry;
+    };
+
+    mutable QMutex mutex;
+    QCache<qint64,Item> cache;
+    qint64 hits;
+    qint64 misses;
+};
+
+#endif // QDLT_MSGCACHE_H
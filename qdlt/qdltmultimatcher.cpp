@@ -0,0 +1,220 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltmultimatcher.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include "qdltmultimatcher.h"
+
+QDltMultiMatcher::Automaton::Automaton()
+{
+    clear();
+}
+
+void QDltMultiMatcher::Automaton::clear()
+{
+    patterns.clear();
+    emptyPatterns.clear();
+    asciiSymbols.fill(0, 128);
+    otherSymbols.clear();
+    width = 1;
+    next.clear();
+    outputStart.clear();
+    outputs.clear();
+}
+
+int QDltMultiMatcher::Automaton::symbol(ushort character) const
+{
+    if(character < 128)
+        return asciiSymbols.at(character);
+    return otherSymbols.value(character, 0);
+}
+
+void QDltMultiMatcher::Automaton::build()
+{
+    QHash<QString,int>::const_iterator it;
+
+    emptyPatterns.clear();
+    asciiSymbols.fill(0, 128);
+    otherSymbols.clear();
+    width = 1;
+    next.clear();
+    outputStart.clear();
+    outputs.clear();
+
+    if(patterns.isEmpty())
+        return;
+
+    /* number the characters used by the patterns, symbol 0 stands for all others */
+    for(it = patterns.constBegin(); it != patterns.constEnd(); ++it)
+    {
+        const QString &pattern = it.key();
+        for(int pos=0;pos<pattern.size();pos++)
+        {
+            ushort character = pattern.at(pos).unicode();
+            if(symbol(character) != 0)
+                continue;
+            if(character < 128)
+                asciiSymbols[character] = static_cast<quint16>(width);
+            else
+                otherSymbols.insert(character, width);
+            width++;
+        }
+    }
+
+    /* trie of the patterns, -1 is a missing transition */
+    QVector<QVector<qint32> > stateOutputs(1);
+    next.fill(-1, width);
+
+    for(it = patterns.constBegin(); it != patterns.constEnd(); ++it)
+    {
+        const QString &pattern = it.key();
+        int state = 0;
+
+        if(pattern.isEmpty())
+        {
+            emptyPatterns.append(it.value());
+            continue;
+        }
+
+        for(int pos=0;pos<pattern.size();pos++)
+        {
+            int transition = state * width + symbol(pattern.at(pos).unicode());
+            if(next.at(transition) < 0)
+            {
+                next[transition] = stateOutputs.size();
+                next.insert(next.size(), width, -1);
+                stateOutputs.append(QVector<qint32>());
+            }
+            state = next.at(transition);
+        }
+        stateOutputs[state].append(it.value());
+    }
+
+    /* complete the transitions breadth first, so the failure state of each state is already complete */
+    QVector<qint32> failure(stateOutputs.size(), 0);
+    QVector<qint32> queue;
+
+    queue.reserve(stateOutputs.size());
+    for(int num=0;num<width;num++)
+    {
+        if(next.at(num) < 0)
+        {
+            next[num] = 0;
+        }
+        else
+        {
+            failure[next.at(num)] = 0;
+            queue.append(next.at(num));
+        }
+    }
+
+    for(int head=0;head<queue.size();head++)
+    {
+        int state = queue.at(head);
+        int fallback = failure.at(state);
+
+        /* a state also finds all patterns of its longest suffix */
+        stateOutputs[state] += stateOutputs.at(fallback);
+
+        for(int num=0;num<width;num++)
+        {
+            int child = next.at(state * width + num);
+            int target = next.at(fallback * width + num);
+            if(child < 0)
+            {
+                next[state * width + num] = target;
+            }
+            else
+            {
+                failure[child] = target;
+                queue.append(child);
+            }
+        }
+    }
+
+    outputStart.reserve(stateOutputs.size() + 1);
+    for(int state=0;state<stateOutputs.size();state++)
+    {
+        outputStart.append(outputs.size());
+        outputs += stateOutputs.at(state);
+    }
+    outputStart.append(outputs.size());
+}
+
+void QDltMultiMatcher::Automaton::match(const QChar *text, int size, QVector<bool> &matches) const
+{
+    for(int num=0;num<emptyPatterns.size();num++)
+        matches[emptyPatterns.at(num)] = true;
+
+    if(next.isEmpty())
+        return;
+
+    const qint32 *transitions = next.constData();
+    int state = 0;
+
+    for(int pos=0;pos<size;pos++)
+    {
+        state = transitions[state * width + symbol(text[pos].unicode())];
+        for(int num=outputStart.at(state);num<outputStart.at(state + 1);num++)
+            matches[outputs.at(num)] = true;
+    }
+}
+
+QDltMultiMatcher::QDltMultiMatcher()
+    : patternCount(0)
+{
+}
+
+void QDltMultiMatcher::clear()
+{
+    caseSensitive.clear();
+    caseInsensitive.clear();
+    patternCount = 0;
+}
+
+int QDltMultiMatcher::addPattern(const QString &pattern, Qt::CaseSensitivity cs)
+{
+    Automaton &automaton = (cs == Qt::CaseSensitive) ? caseSensitive : caseInsensitive;
+    QString key = (cs == Qt::CaseSensitive) ? pattern : pattern.toCaseFolded();
+
+    QHash<QString,int>::const_iterator it = automaton.patterns.constFind(key);
+    if(it != automaton.patterns.constEnd())
+        return it.value();
+
+    automaton.patterns.insert(key, patternCount);
+    return patternCount++;
+}
+
+void QDltMultiMatcher::build()
+{
+    caseSensitive.build();
+    caseInsensitive.build();
+}
+
+void QDltMultiMatcher::match(const QString &text, QVector<bool> &matches) const
+{
+    matches.fill(false, patternCount);
+
+    if(!caseSensitive.patterns.isEmpty())
+        caseSensitive.match(text.constData(), text.size(), matches);
+
+    if(!caseInsensitive.patterns.isEmpty())
+    {
+        QString folded = text.toCaseFolded();
+        caseInsensitive.match(folded.constData(), folded.size(), matches);
+    }
+}
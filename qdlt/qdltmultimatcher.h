@@ -0,0 +1,108 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltmultimatcher.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef QDLT_MULTIMATCHER_H
+#define QDLT_MULTIMATCHER_H
+
+#include <QVector>
+#include <QString>
+#include <QHash>
+
+#include "export_rules.h"
+
+//! Search many literal texts at once.
+/*!
+  The patterns are compiled into an Aho-Corasick automaton, which finds all
+  patterns contained in a text with one pass over the text, however many
+  patterns there are. Case insensitive patterns are searched in the case folded
+  text with a second automaton.
+  Const functions can be called from several threads at once.
+*/
+class QDLT_EXPORT QDltMultiMatcher
+{
+public:
+    //! The constructor.
+    QDltMultiMatcher();
+
+    //! Remove all patterns.
+    void clear();
+
+    //! Add a pattern, build() must be called before the next match().
+    /*!
+      \param pattern The literal text.
+      \param cs Case sensitivity of the pattern.
+      \return The number of the pattern, equal patterns get the same number.
+    */
+    int addPattern(const QString &pattern, Qt::CaseSensitivity cs = Qt::CaseSensitive);
+
+    //! Create the automatons from the patterns.
+    void build();
+
+    //! Get the number of patterns.
+    int size() const { return patternCount; }
+
+    //! Check if there are no patterns.
+    bool isEmpty() const { return patternCount == 0; }
+
+    //! Find all patterns contained in a text.
+    /*!
+      \param text The text to be searched.
+      \param matches Resized to size(), true at the number of each pattern which is contained.
+    */
+    void match(const QString &text, QVector<bool> &matches) const;
+
+private:
+    //! Automaton for the patterns with the same case sensitivity.
+    class Automaton
+    {
+    public:
+        Automaton();
+
+        void clear();
+        void build();
+        void match(const QChar *text, int size, QVector<bool> &matches) const;
+
+        //! Number of each pattern by its text.
+        QHash<QString,int> patterns;
+
+        //! Patterns which are contained in every text.
+        QVector<int> emptyPatterns;
+
+    private:
+        int symbol(ushort character) const;
+
+        //! Symbol of each character used by a pattern, 0 for all other characters.
+        QVector<quint16> asciiSymbols;
+        QHash<ushort,int> otherSymbols;
+        int width;
+
+        //! Next state for each state and symbol, width entries per state.
+        QVector<qint32> next;
+
+        //! Patterns found in each state, from outputs[outputStart[state]] to outputs[outputStart[state+1]].
+        QVector<qint32> outputStart;
+        QVector<qint32> outputs;
+    };
+
+    Automaton caseSensitive;
+    Automaton caseInsensitive;
+    int patternCount;
+};
+
+#endif // QDLT_MULTIMATCHER_H
@@ -112,6 +112,11 @@ bool QDltPlugin::isDecoder()
     return (plugindecoderinterface?true:false);
 }
 
+bool QDltPlugin::isDecoderThreadSafe()
+{
+    return (plugindecoderinterface?plugindecoderinterface->isThreadSafe():false);
+}
+
 bool QDltPlugin::isViewer()
 {
     return (pluginviewerinterface?true:false);
@@ -177,12 +182,12 @@ void QDltPlugin::initFileFinish()
 if(pluginviewerinterface)
     pluginviewerinterface->initFileFinish();
 }
-void QDltPlugin::initMsg(int index, QDltMsg &msg)
+void QDltPlugin::initMsg(qint64 index, QDltMsg &msg)
 {
 if(pluginviewerinterface)
     pluginviewerinterface->initMsg(index,msg);
 }
-void QDltPlugin::initMsgDecoded(int index, QDltMsg &msg)
+void QDltPlugin::initMsgDecoded(qint64 index, QDltMsg &msg)
 {
 if(pluginviewerinterface)
     pluginviewerinterface->initMsgDecoded(index,msg);
@@ -192,12 +197,12 @@ void QDltPlugin::updateFileStart()
 if(pluginviewerinterface)
     pluginviewerinterface->updateFileStart();
 }
-void QDltPlugin::updateMsg(int index, QDltMsg &msg)
+void QDltPlugin::updateMsg(qint64 index, QDltMsg &msg)
 {
 if(pluginviewerinterface)
     pluginviewerinterface->updateMsg(index,msg);
 }
-void QDltPlugin::updateMsgDecoded(int index, QDltMsg &msg)
+void QDltPlugin::updateMsgDecoded(qint64 index, QDltMsg &msg)
 {
 if(pluginviewerinterface)
     pluginviewerinterface->updateMsgDecoded(index,msg);
@@ -207,12 +212,12 @@ void QDltPlugin::updateFileFinish()
 if(pluginviewerinterface)
     pluginviewerinterface->updateFileFinish();
 }
-void QDltPlugin::selectedIdxMsg(int index, QDltMsg &msg)
+void QDltPlugin::selectedIdxMsg(qint64 index, QDltMsg &msg)
 {
 if(pluginviewerinterface)
     pluginviewerinterface->selectedIdxMsg(index,msg);
 }
-void QDltPlugin::selectedIdxMsgDecoded(int index, QDltMsg &msg)
+void QDltPlugin::selectedIdxMsgDecoded(qint64 index, QDltMsg &msg)
 {
 if(pluginviewerinterface)
     pluginviewerinterface->selectedIdxMsgDecoded(index,msg);
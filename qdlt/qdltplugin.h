@@ -72,6 +72,12 @@ public:
     */
     bool isDecoder();
 
+    //! Check if the decoder plugin can decode messages in several threads at the same time
+    /*!
+      \return True if it is a decoder plugin which can decode messages in several threads
+    */
+    bool isDecoderThreadSafe();
+
     //! Check if this is a viewer plugin
     /*!
       \return True if it is a viewer plugin
@@ -99,14 +105,14 @@ public:
     QWidget* initViewer();
     void initFileStart(QDltFile *file);
     void initFileFinish();
-    void initMsg(int index, QDltMsg &msg);
-    void initMsgDecoded(int index, QDltMsg &msg);
+    void initMsg(qint64 index, QDltMsg &msg);
+    void initMsgDecoded(qint64 index, QDltMsg &msg);
     void updateFileStart();
-    void updateMsg(int index, QDltMsg &msg);
-    void updateMsgDecoded(int index, QDltMsg &msg);
+    void updateMsg(qint64 index, QDltMsg &msg);
+    void updateMsgDecoded(qint64 index, QDltMsg &msg);
     void updateFileFinish();
-    void selectedIdxMsg(int index, QDltMsg &msg);
-    void selectedIdxMsgDecoded(int index, QDltMsg &msg);
+    void selectedIdxMsg(qint64 index, QDltMsg &msg);
+    void selectedIdxMsgDecoded(qint64 index, QDltMsg &msg);
 
     // control plugin interfaces
     bool initControl(QDltControl *control);
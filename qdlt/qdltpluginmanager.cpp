@@ -6,6 +6,8 @@
 //#include <QMessageBox>
 #include <QTextStream>
 #include <QString>
+#include <QCryptographicHash>
+#include <QMutexLocker>
 
 QDltPluginManager::QDltPluginManager()
 {
@@ -56,6 +58,8 @@ QStringList QDltPluginManager::loadPlugins(const QString &settingsPluginPath)
         errorStrings << loadPluginsPath(pluginsDir);
     }
 
+    updateDecoderConfiguration();
+
     return errorStrings;
 }
 
@@ -124,6 +128,8 @@ void QDltPluginManager::loadConfig(QString pluginName,QString filename)
         if(plugin->getName()==pluginName)
             plugin->setFilename(filename);
     }
+
+    updateDecoderConfiguration();
 }
 
 
@@ -165,6 +171,44 @@ QList<QDltPlugin*> QDltPluginManager::getDecoderPlugins()
     return list;
 }
 
+bool QDltPluginManager::isDecoderThreadSafe()
+{
+    QList<QDltPlugin*> list = getDecoderPlugins();
+
+    for(int num=0;num<list.size();num++)
+    {
+        if(!list[num]->isDecoderThreadSafe())
+            return false;
+    }
+    return true;
+}
+
+QByteArray QDltPluginManager::getDecoderConfiguration() const
+{
+    QMutexLocker locker(&decoderConfigurationMutex);
+    return decoderConfiguration;
+}
+
+void QDltPluginManager::updateDecoderConfiguration()
+{
+    QString hashString;
+    QByteArray hash;
+
+    for(int num=0;num<plugins.size();num++)
+    {
+        QDltPlugin *plugin = plugins[num];
+
+        if(plugin->isDecoder() && plugin->getMode()>=QDltPlugin::ModeEnable)
+            hashString += plugin->getName() + plugin->getPluginVersion() + plugin->getFilename() + "\n";
+    }
+
+    if(!hashString.isEmpty())
+        hash = QCryptographicHash::hash(hashString.toUtf8(), QCryptographicHash::Md5);
+
+    QMutexLocker locker(&decoderConfigurationMutex);
+    decoderConfiguration = hash;
+}
+
 QList<QDltPlugin*> QDltPluginManager::getViewerPlugins()
 {
     QList<QDltPlugin*> list;
@@ -4,6 +4,7 @@
 #include "plugininterface.h"
 
 #include <QDir>
+#include <QMutex>
 
 #include "export_rules.h"
 
@@ -62,6 +63,27 @@ public:
     //! Get the list of pointers to all enabled decoder plugins
     QList<QDltPlugin*> getDecoderPlugins();
 
+    //! Check if messages can be decoded in several threads at the same time
+    /*!
+      \return true if all enabled decoder plugins can decode messages in several threads at the same time.
+    */
+    bool isDecoderThreadSafe();
+
+    //! Get a hash of the names, versions and configuration files of all enabled decoder plugins
+    /*!
+      Messages decoded with the same configuration are decoded equally.
+      The hash is calculated by updateDecoderConfiguration().
+      Can be called from several threads at once.
+      \return the hash, or an empty byte array if there is no enabled decoder plugin.
+    */
+    QByteArray getDecoderConfiguration() const;
+
+    //! Calculate the hash returned by getDecoderConfiguration()
+    /*!
+      Must be called after a plugin is enabled, disabled or its configuration is loaded.
+    */
+    void updateDecoderConfiguration();
+
     //! Get the list of pointers to all enabled viewer plugins
     QList<QDltPlugin*> getViewerPlugins();
 
@@ -83,6 +105,10 @@ private:
     //! The list of pointers to all loaded plugins
     QList<QDltPlugin*> plugins;
 
+    //! Hash of the configuration of all enabled decoder plugins
+    QByteArray decoderConfiguration;
+    mutable QMutex decoderConfigurationMutex;
+
     //! Loads all plugins from a special directory
     QStringList loadPluginsPath(QDir &dir);
 
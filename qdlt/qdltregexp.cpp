@@ -0,0 +1,260 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltregexp.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include "qdltregexp.h"
+
+QDltRegExp::QDltRegExp()
+    : caseSensitivity(Qt::CaseSensitive),
+      literalOnly(true)
+{
+}
+
+QDltRegExp::QDltRegExp(const QString &pattern, Qt::CaseSensitivity cs)
+{
+    setPattern(pattern, cs);
+}
+
+void QDltRegExp::setPattern(const QString &pattern, Qt::CaseSensitivity cs)
+{
+    caseSensitivity = cs;
+
+    regexp.setPattern(pattern);
+    regexp.setPatternOptions(cs == Qt::CaseInsensitive ? QRegularExpression::CaseInsensitiveOption : QRegularExpression::NoPatternOption);
+
+    literal = requiredLiteral(pattern, &literalOnly);
+
+    /* compile with JIT now, instead of after some matches */
+    if(!literalOnly)
+        regexp.optimize();
+}
+
+bool QDltRegExp::contains(const QString &text) const
+{
+    if(!regexp.isValid())
+        return false;
+
+    if(!literal.isEmpty() && !text.contains(literal, caseSensitivity))
+        return false;
+
+    if(literalOnly)
+        return true;
+
+    return regexp.match(text).hasMatch();
+}
+
+/* characters which are taken into the literal text, case insensitive compare must be equal to the regular expression */
+static bool isLiteralChar(QChar c)
+{
+    return c.unicode() >= 0x20 && c.unicode() < 0x7f;
+}
+
+/* escapes which stand for one character class or assertion and have no arguments */
+static bool isSimpleEscape(QChar c)
+{
+    return c.unicode() < 0x80 && QString("dDwWsSbBhHvVRAzZGntrfea").contains(c);
+}
+
+/* get the position behind a character class starting at pos, -1 if there is no end */
+static int skipClass(const QString &pattern, int pos)
+{
+    const int size = pattern.size();
+
+    pos++;
+    if(pos < size && pattern.at(pos) == '^')
+        pos++;
+    if(pos < size && pattern.at(pos) == ']')
+        pos++;
+
+    while(pos < size)
+    {
+        QChar c = pattern.at(pos);
+        if(c == '\\')
+        {
+            pos += 2;
+        }
+        else if(c == '[' && pos + 1 < size && pattern.at(pos + 1) == ':')
+        {
+            /* POSIX class like [:alpha:] */
+            int end = pattern.indexOf(":]", pos + 2);
+            if(end < 0)
+                return -1;
+            pos = end + 2;
+        }
+        else if(c == ']')
+        {
+            return pos + 1;
+        }
+        else
+        {
+            pos++;
+        }
+    }
+
+    return -1;
+}
+
+/* get the position behind a group starting at pos, -1 if there is no end */
+static int skipGroup(const QString &pattern, int pos)
+{
+    const int size = pattern.size();
+    int depth = 0;
+
+    while(pos < size)
+    {
+        QChar c = pattern.at(pos);
+        if(c == '\\')
+        {
+            pos += 2;
+        }
+        else if(c == '[')
+        {
+            pos = skipClass(pattern, pos);
+            if(pos < 0)
+                return -1;
+        }
+        else
+        {
+            if(c == '(')
+                depth++;
+            else if(c == ')' && --depth == 0)
+                return pos + 1;
+            pos++;
+        }
+    }
+
+    return -1;
+}
+
+QString QDltRegExp::requiredLiteral(const QString &pattern, bool *complete)
+{
+    const int size = pattern.size();
+    QString best;
+    QString run;
+    bool onlyLiteral = true;
+    int pos = 0;
+
+    if(complete)
+        *complete = false;
+
+    /* options and verbs like (?i) change the meaning of the rest of the pattern */
+    if(pattern.contains("(?") || pattern.contains("(*") || pattern.contains("\\Q"))
+        return QString();
+
+    while(pos < size)
+    {
+        QChar c = pattern.at(pos);
+        bool literalAtom = false;
+
+        if(c == '|')
+        {
+            /* alternatives on the top level, no text is required */
+            return QString();
+        }
+        else if(c == '\\')
+        {
+            if(pos + 1 >= size)
+                return QString();
+            QChar next = pattern.at(pos + 1);
+            if(isLiteralChar(next) && !next.isLetterOrNumber())
+            {
+                run += next;
+                literalAtom = true;
+            }
+            else if(!isSimpleEscape(next))
+            {
+                /* escape with arguments, e.g. \x{41} or \p{L}, an alternative could follow */
+                return QString();
+            }
+            pos += 2;
+        }
+        else if(c == '[')
+        {
+            pos = skipClass(pattern, pos);
+            if(pos < 0)
+                return QString();
+        }
+        else if(c == '(')
+        {
+            pos = skipGroup(pattern, pos);
+            if(pos < 0)
+                return QString();
+        }
+        else if(c == ')' || c == '*' || c == '+' || c == '?')
+        {
+            /* invalid pattern */
+            return QString();
+        }
+        else if(c == '.' || c == '^' || c == '$' || c == '{' || c == '}' || !isLiteralChar(c))
+        {
+            pos++;
+        }
+        else
+        {
+            run += c;
+            literalAtom = true;
+            pos++;
+        }
+
+        /* a quantifier behind the atom */
+        bool quantified = false;
+        bool optional = false;
+        if(pos < size && (pattern.at(pos) == '*' || pattern.at(pos) == '+' || pattern.at(pos) == '?' || pattern.at(pos) == '{'))
+        {
+            QChar quantifier = pattern.at(pos);
+
+            quantified = true;
+            optional = (quantifier != '+');
+            pos++;
+            if(quantifier == '{')
+            {
+                /* only {n} and {n,m} with n > 0 keep the character */
+                int minimum = 0;
+                while(pos < size && pattern.at(pos).isDigit())
+                    minimum = qMin(minimum * 10 + pattern.at(pos++).digitValue(), 0xffff);
+                while(pos < size && (pattern.at(pos).isDigit() || pattern.at(pos) == ','))
+                    pos++;
+                if(minimum > 0)
+                    optional = false;
+                if(pos < size && pattern.at(pos) == '}')
+                    pos++;
+            }
+            if(pos < size && (pattern.at(pos) == '?' || pattern.at(pos) == '+'))
+                pos++;
+        }
+
+        if(literalAtom && !quantified)
+            continue;
+
+        /* the literal text ends before a repeated or optional character and at other atoms */
+        if(literalAtom && optional)
+            run.chop(1);
+        onlyLiteral = false;
+        if(run.size() > best.size())
+            best = run;
+        run.clear();
+    }
+
+    if(run.size() > best.size())
+        best = run;
+
+    if(complete)
+        *complete = onlyLiteral;
+
+    return best;
+}
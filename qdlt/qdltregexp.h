@@ -0,0 +1,94 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2012  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltregexp.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef QDLT_REGEXP_H
+#define QDLT_REGEXP_H
+
+#include <QString>
+#include <QRegularExpression>
+
+#include "export_rules.h"
+
+//! Regular expression used by filters and the search.
+/*!
+  The expression is compiled by QRegularExpression with JIT. A literal text which
+  every match must contain is extracted from the pattern and searched first, the
+  expression itself is only run on texts which contain the literal text. Patterns
+  without any special characters are only searched as literal text.
+  Copies share the compiled expression. Const functions can be called from several
+  threads at once.
+*/
+class QDLT_EXPORT QDltRegExp
+{
+public:
+    //! The constructor, the empty pattern matches every text.
+    QDltRegExp();
+
+    //! Create an expression.
+    /*!
+      \param pattern The pattern in Perl syntax.
+      \param cs Case sensitivity of the pattern.
+    */
+    QDltRegExp(const QString &pattern, Qt::CaseSensitivity cs = Qt::CaseSensitive);
+
+    //! Set the pattern and compile it.
+    /*!
+      \param pattern The pattern in Perl syntax.
+      \param cs Case sensitivity of the pattern.
+    */
+    void setPattern(const QString &pattern, Qt::CaseSensitivity cs = Qt::CaseSensitive);
+
+    //! Get the pattern.
+    QString pattern() const { return regexp.pattern(); }
+
+    //! Check if the pattern is a valid regular expression.
+    bool isValid() const { return regexp.isValid(); }
+
+    //! Get the error of an invalid pattern.
+    QString errorString() const { return regexp.errorString(); }
+
+    //! Get the literal text which every matching text contains, may be empty.
+    QString getLiteral() const { return literal; }
+
+    //! Check if the expression matches somewhere in a text.
+    /*!
+      \param text The text to be searched.
+      \return true if the expression matches, false if not or if the pattern is invalid.
+    */
+    bool contains(const QString &text) const;
+
+    //! Extract the longest literal text which every match of a pattern contains.
+    /*!
+      Only printable ASCII characters outside of groups and character classes
+      are taken, and nothing is taken from patterns with alternatives or options,
+      or with escapes which are not understood, because an alternative could follow.
+      \param pattern The pattern in Perl syntax.
+      \param complete Set to true if the whole pattern is the literal text.
+      \return the literal text, empty if none was found.
+    */
+    static QString requiredLiteral(const QString &pattern, bool *complete = 0);
+
+private:
+    QRegularExpression regexp;
+    QString literal;
+    Qt::CaseSensitivity caseSensitivity;
+    bool literalOnly;
+};
+
+#endif // QDLT_REGEXP_H
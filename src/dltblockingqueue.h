@@ -0,0 +1,139 @@
+#ifndef DLTBLOCKINGQUEUE_H
+#define DLTBLOCKINGQUEUE_H
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+#include <QVector>
+
+// Bounded queue which blocks producers while it is full and consumers while it is empty.
+// Any number of threads may put and take items. Waiting threads sleep on a condition
+// variable and are woken as soon as an item or a free slot is available, or a stop is requested.
+template <typename T>
+class DltBlockingQueue
+{
+public:
+    DltBlockingQueue(int capacity)
+        : buffer(capacity),
+          head(0),
+          count(0),
+          stopRequested(false),
+          maxCount(0),
+          putStalls(0),
+          takeStalls(0),
+          putStallNsecs(0),
+          takeStallNsecs(0)
+    {}
+
+    // Add an item, waits while the queue is full.
+    // Returns false without adding the item, if a stop was requested.
+    bool put(const T &item)
+    {
+        QMutexLocker locker(&mutex);
+
+        if(count == buffer.size() && !stopRequested)
+        {
+            QElapsedTimer timer;
+            timer.start();
+            while(count == buffer.size() && !stopRequested)
+                notFull.wait(&mutex);
+            putStalls++;
+            putStallNsecs += timer.nsecsElapsed();
+        }
+
+        if(stopRequested)
+            return false;
+
+        buffer[(head + count) % buffer.size()] = item;
+        count++;
+        maxCount = qMax(maxCount, count);
+        notEmpty.wakeOne();
+
+        return true;
+    }
+
+    // Remove the oldest item, waits while the queue is empty.
+    // Returns false, if the queue is empty and a stop was requested.
+    // Items added before the stop request are still returned.
+    bool take(T &item)
+    {
+        QMutexLocker locker(&mutex);
+
+        if(count == 0 && !stopRequested)
+        {
+            QElapsedTimer timer;
+            timer.start();
+            while(count == 0 && !stopRequested)
+                notEmpty.wait(&mutex);
+            takeStalls++;
+            takeStallNsecs += timer.nsecsElapsed();
+        }
+
+        if(count == 0)
+            return false;
+
+        item = buffer[head];
+        head = (head + 1) % buffer.size();
+        count--;
+        notFull.wakeOne();
+
+        return true;
+    }
+
+    // Remove the oldest item without waiting.
+    // Returns false, if the queue is empty.
+    bool tryTake(T &item)
+    {
+        QMutexLocker locker(&mutex);
+
+        if(count == 0)
+            return false;
+
+        item = buffer[head];
+        buffer[head] = T();
+        head = (head + 1) % buffer.size();
+        count--;
+        notFull.wakeOne();
+
+        return true;
+    }
+
+    // Wake up all waiting threads, consumers still get the remaining items.
+    void requestStop()
+    {
+        QMutexLocker locker(&mutex);
+        stopRequested = true;
+        notEmpty.wakeAll();
+        notFull.wakeAll();
+    }
+
+    // Number of items in the queue.
+    int size() const { QMutexLocker locker(&mutex); return count; }
+
+    // Maximum number of items which were in the queue at once.
+    int getMaxSize() const { QMutexLocker locker(&mutex); return maxCount; }
+
+    // Number of times and total time producers waited, because the queue was full.
+    qint64 getPutStalls() const { QMutexLocker locker(&mutex); return putStalls; }
+    qint64 getPutStallNsecs() const { QMutexLocker locker(&mutex); return putStallNsecs; }
+
+    // Number of times and total time consumers waited, because the queue was empty.
+    qint64 getTakeStalls() const { QMutexLocker locker(&mutex); return takeStalls; }
+    qint64 getTakeStallNsecs() const { QMutexLocker locker(&mutex); return takeStallNsecs; }
+
+private:
+    mutable QMutex mutex;
+    QWaitCondition notEmpty, notFull;
+
+    QVector<T> buffer;
+    int head;
+    int count;
+    bool stopRequested;
+
+    int maxCount;
+    qint64 putStalls, takeStalls;
+    qint64 putStallNsecs, takeStallNsecs;
+};
+
+#endif // DLTBLOCKINGQUEUE_H
@@ -2,11 +2,13 @@
 #include <QMessageBox>
 #include <QApplication>
 #include <QClipboard>
+#include <limits.h>
 
 #include "dltexporter.h"
 #include "fieldnames.h"
 #include "project.h"
 #include "optmanager.h"
+#include "tablemodel.h"
 
 DltExporter::DltExporter(QObject *parent) :
     QObject(parent)
@@ -46,8 +48,9 @@ bool DltExporter::writeCSVHeader(QFile *file)
     return file->write(header.toLatin1().constData()) < 0 ? false : true;
 }
 
-void DltExporter::writeCSVLine(int index, QFile *to, QDltMsg msg)
+void DltExporter::writeCSVLine(qint64 index, QFile *to, const QDltMsgCacheEntry &entry)
 {
+    const QDltMsg &msg = entry.msg;
     QString text("");
 
     text += escapeCSVValue(QString("%1").arg(index)).append(",");
@@ -62,7 +65,7 @@ void DltExporter::writeCSVLine(int index, QFile *to, QDltMsg msg)
     text += escapeCSVValue(QString("%1").arg(msg.getSubtypeString())).append(",");
     text += escapeCSVValue(QString("%1").arg(msg.getModeString())).append(",");
     text += escapeCSVValue(QString("%1").arg(msg.getNumberOfArguments())).append(",");
-    text += escapeCSVValue(msg.toStringPayload().simplified());
+    text += escapeCSVValue(entry.payload.simplified());
     text += "\n";
 
     to->write(text.toLatin1().constData());
@@ -78,8 +81,9 @@ bool DltExporter::start()
         for(int num=0;num<selection->count();num++)
         {
             QModelIndex index = selection->at(num);
+            const TableModel *model = qobject_cast<const TableModel *>(index.model());
             if(index.column() == 0)
-                selectedRows.append(index.row());
+                selectedRows.append(model ? model->filterIndex(index.row()) : index.row());
         }
     }
 
@@ -153,15 +157,27 @@ bool DltExporter::finish()
     return true;
 }
 
-bool DltExporter::getMsg(int num,QDltMsg &msg,QByteArray &buf)
+qint64 DltExporter::getMsgIndex(qint64 num)
+{
+    if(exportSelection == DltExporter::SelectionAll)
+        return num;
+    else if(exportSelection == DltExporter::SelectionFiltered)
+        return from->getMsgFilterPos(num);
+    else if(exportSelection == DltExporter::SelectionSelected)
+        return from->getMsgFilterPos(selectedRows[num]);
+    else
+        return -1;
+}
+
+bool DltExporter::getMsg(qint64 num,QDltFileCursor &cursor,QDltMsg &msg,QByteArray &buf)
 {
     buf.clear();
     if(exportSelection == DltExporter::SelectionAll)
-        buf = from->getMsg(num);
+        buf = cursor.getMsg(num);
     else if(exportSelection == DltExporter::SelectionFiltered)
-        buf = from->getMsgFilter(num);
+        buf = cursor.getMsgFilter(num);
     else if(exportSelection == DltExporter::SelectionSelected)
-        buf = from->getMsgFilter(selectedRows[num]);
+        buf = cursor.getMsgFilter(selectedRows[num]);
     else
         return false;
     if(buf.isEmpty())
@@ -169,7 +185,7 @@ bool DltExporter::getMsg(int num,QDltMsg &msg,QByteArray &buf)
     return msg.setMsg(buf);
 }
 
-bool DltExporter::exportMsg(int num, QDltMsg &msg, QByteArray &buf)
+bool DltExporter::exportMsg(qint64 num, QDltMsgCacheEntry &entry, QByteArray &buf)
 {
     if((exportFormat == DltExporter::FormatDlt)||(exportFormat == DltExporter::FormatDltDecoded))
     {
@@ -180,17 +196,13 @@ bool DltExporter::exportMsg(int num, QDltMsg &msg, QByteArray &buf)
         QString text;
 
         /* get message ASCII text */
-        if(exportSelection == DltExporter::SelectionAll)
-            text += QString("%1 ").arg(num);
-        else if(exportSelection == DltExporter::SelectionFiltered)
-            text += QString("%1 ").arg(from->getMsgFilterPos(num));
-        else if(exportSelection == DltExporter::SelectionSelected)
-            text += QString("%1 ").arg(from->getMsgFilterPos(selectedRows[num]));
-        else
+        qint64 index = getMsgIndex(num);
+        if(index < 0)
             return false;
-        text += msg.toStringHeader();
+        text += QString("%1 ").arg(index);
+        text += entry.header;
         text += " ";
-        text += msg.toStringPayload().simplified();
+        text += entry.payload.simplified();
         text += "\n";
         try
          {
@@ -208,14 +220,10 @@ bool DltExporter::exportMsg(int num, QDltMsg &msg, QByteArray &buf)
     }
     else if(exportFormat == DltExporter::FormatCsv)
     {
-        if(exportSelection == DltExporter::SelectionAll)
-            writeCSVLine(num, to, msg);
-        else if(exportSelection == DltExporter::SelectionFiltered)
-            writeCSVLine(from->getMsgFilterPos(num), to, msg);
-        else if(exportSelection == DltExporter::SelectionSelected)
-            writeCSVLine(from->getMsgFilterPos(selectedRows[num]), to, msg);
-        else
+        qint64 index = getMsgIndex(num);
+        if(index < 0)
             return false;
+        writeCSVLine(index, to, entry);
     }
 
     return true;
@@ -224,7 +232,8 @@ bool DltExporter::exportMsg(int num, QDltMsg &msg, QByteArray &buf)
 void DltExporter::exportMessages(QDltFile *from, QFile *to, QDltPluginManager *pluginManager,
                          DltExporter::DltExportFormat exportFormat, DltExporter::DltExportSelection exportSelection, QModelIndexList *selection)
 {
-    QDltMsg msg;
+    QDltMsgCacheEntry entry;
+    QDltMsg &msg = entry.msg;
     QByteArray buf;
 
     /* initialise values */
@@ -257,7 +266,12 @@ void DltExporter::exportMessages(QDltFile *from, QFile *to, QDltPluginManager *p
 
     /* init fileprogress */
 
-    QProgressDialog fileprogress("Export ...", "Cancel", 0, this->size, qobject_cast<QWidget *>(parent()));
+    /* the progress dialog is limited to int, scale down large exports */
+    int progressShift = 0;
+    while((size >> progressShift) > INT_MAX)
+        progressShift++;
+
+    QProgressDialog fileprogress("Export ...", "Cancel", 0, static_cast<int>(size >> progressShift), qobject_cast<QWidget *>(parent()));
     if (silentMode == true)
      {
       fileprogress.setWindowTitle("DLT Viewer");
@@ -265,40 +279,52 @@ void DltExporter::exportMessages(QDltFile *from, QFile *to, QDltPluginManager *p
       fileprogress.show();
      }
 
-    for(int num = 0;num<size;num++)
+    /* messages are exported in order, read them in large blocks */
+    QDltFileCursor cursor(from);
+
+    /* messages shown before are taken from the message cache, which is not filled by the export */
+    bool textFormat = exportFormat != DltExporter::FormatDlt && exportFormat != DltExporter::FormatDltDecoded;
+    QByteArray configuration = pluginManager->getDecoderConfiguration();
+
+    for(qint64 num = 0;num<size;num++)
     {
         // Update progress dialog every 1000 lines
         if( 0 == (num%1000))
         {
           if (silentMode == true)
              {
-              fileprogress.setValue(num);
+              fileprogress.setValue(static_cast<int>(num >> progressShift));
              }
         }
 
-        // get message
-        if(!getMsg(num,msg,buf))
+        if(!textFormat || !from->getMsgCache().find(getMsgIndex(num), configuration, entry))
         {
-	    //  finish();
-	    qDebug() << "DLT Export getMsg() failed on msg " << num;
-	    readErrors++;
-	    continue;
-	    //  return;
-        }
+            // get message
+            if(!getMsg(num,cursor,msg,buf))
+            {
+                //  finish();
+                qDebug() << "DLT Export getMsg() failed on msg " << num;
+                readErrors++;
+                continue;
+                //  return;
+            }
 
-        // decode message if needed
-        if(exportFormat != DltExporter::FormatDlt)
-        {
-            pluginManager->decodeMsg(msg,silentMode);
-            if (exportFormat == DltExporter::FormatDltDecoded)
+            // decode message if needed
+            if(exportFormat != DltExporter::FormatDlt)
             {
-                msg.setNumberOfArguments(msg.sizeArguments());
-                msg.getMsg(buf,true);
+                pluginManager->decodeMsg(msg,silentMode);
+                if (exportFormat == DltExporter::FormatDltDecoded)
+                {
+                    msg.setNumberOfArguments(msg.sizeArguments());
+                    msg.getMsg(buf,true);
+                }
             }
+            if(textFormat)
+                entry.render();
         }
 
         // export message
-        if(!exportMsg(num,msg,buf))
+        if(!exportMsg(num,entry,buf))
         {
             // finish();
           qDebug() << "DLT Export exportMsg() failed";
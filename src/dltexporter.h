@@ -36,14 +36,15 @@ private:
     /* Write the message out to an open file
      * \param index True index to QDltFile of the message
      * \param to File to write to
-     * \param msg msg to get the data from
+     * \param entry msg and payload text to get the data from
      */
-    void writeCSVLine(int index, QFile *to, QDltMsg msg);
+    void writeCSVLine(qint64 index, QFile *to, const QDltMsgCacheEntry &entry);
 
     bool start();
     bool finish();
-    bool getMsg(int num, QDltMsg &msg, QByteArray &buf);
-    bool exportMsg(int num, QDltMsg &msg,QByteArray &buf);
+    qint64 getMsgIndex(qint64 num);
+    bool getMsg(qint64 num, QDltFileCursor &cursor, QDltMsg &msg, QByteArray &buf);
+    bool exportMsg(qint64 num, QDltMsgCacheEntry &entry,QByteArray &buf);
 
 public:
 
@@ -69,13 +70,13 @@ signals:
 public slots:
     
 private:
-    int size;
+    qint64 size;
     QDltFile *from;
     QFile *to;
     QString clipboardString;
     QDltPluginManager *pluginManager;
     QModelIndexList *selection;
-    QList<int> selectedRows;
+    QList<qint64> selectedRows;
     DltExporter::DltExportFormat exportFormat;
     DltExporter::DltExportSelection exportSelection;
 };
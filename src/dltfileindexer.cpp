@@ -1,7 +1,10 @@
 #include "dltfileindexer.h"
 #include "optmanager.h"
 #include "dltfileindexerthread.h"
+#include "dltfileindexerworkerthread.h"
 #include "dltfileindexerdefaultfilterthread.h"
+#include "dltfileindexerrangethread.h"
+#include "dltfileindexersortthread.h"
 
 #include <QDebug>
 #include <QMessageBox>
@@ -9,6 +12,11 @@
 #include <QTime>
 #include <QCryptographicHash>
 #include <QMutexLocker>
+#include <QFileInfo>
+#include <QDateTime>
+
+#include <algorithm>
+
 
 
 extern "C" {
@@ -16,10 +24,28 @@ extern "C" {
     #include "dlt_user.h"
 }
 
-DltFileIndexerKey::DltFileIndexerKey(time_t time,unsigned int microseconds)
+DltFileIndexerKey::DltFileIndexerKey(time_t time,unsigned int microseconds,qint64 index)
 {
-    this->time = time;
+    this->time = static_cast<quint32>(time);
     this->microseconds = microseconds;
+    this->index = index;
+}
+
+// Position in one sorted run while merging the runs.
+class DltFileIndexerRun
+{
+public:
+    DltFileIndexerRun() : pos(0), end(0) {}
+    DltFileIndexerRun(const DltFileIndexerKey *pos, const DltFileIndexerKey *end) : pos(pos), end(end) {}
+
+    const DltFileIndexerKey *pos;
+    const DltFileIndexerKey *end;
+};
+
+// Order of the merge heap, the run with the smallest key is on top.
+static bool runGreater(const DltFileIndexerRun &run1, const DltFileIndexerRun &run2)
+{
+    return *run2.pos < *run1.pos;
 }
 
 DltFileIndexer::DltFileIndexer(QObject *parent) :
@@ -71,19 +97,11 @@ DltFileIndexer::~DltFileIndexer()
 bool DltFileIndexer::index(int num)
 {
     QTime time;
+    qint64 indexedSize = -1;
 
     // start performance counter
     time.start();
 
-    // load filter index if enabled
-    if(!filterCache.isEmpty() && loadIndexCache(dltFile->getFileName(num)))
-    {
-        // loading index from filter is succesful
-        //qDebug() << "Loaded index cache for file" << dltFile->getFileName(num);
-        msecsIndexCounter = time.elapsed();
-        return true;
-    }
-
     // prepare indexing
     //dltFile->clearIndex();
     QFile f(dltFile->getFileName(num));
@@ -95,10 +113,22 @@ bool DltFileIndexer::index(int num)
         return false;
     }
 
+    // load index cache if enabled, the file may have grown since it was cached
+    if(!filterCache.isEmpty() && loadIndexCache(f, indexedSize) && indexedSize == f.size())
+    {
+        // loading index from filter is succesful
+        //qDebug() << "Loaded index cache for file" << dltFile->getFileName(num);
+        f.close();
+        msecsIndexCounter = time.elapsed();
+        return true;
+    }
+
     // check if file is empty
     if(f.size() == 0)
     {
         // No need to do anything here.
+        indexAllList.clear();
+        metadataAll.clear();
         f.close();
         return true;
     }
@@ -107,60 +137,32 @@ bool DltFileIndexer::index(int num)
     emit(progressText(QString("%1/%2").arg(currentRun).arg(maxRun)));
     emit(progressMax(f.size()));
 
-    // clear old index
-    indexAllList.clear();
-
-    // Go through the segments and create new index
-    char lastFound = 0;
-    qint64 length;
-    qint64 pos;
-    char *data = new char[DLT_FILE_INDEXER_SEG_SIZE];
-    do
+    bool success;
+    qint64 size = f.size();
+    if(indexedSize >= 0)
     {
-
-        pos = f.pos();
-        length = f.read(data,DLT_FILE_INDEXER_SEG_SIZE);
-        for(int num=0;num < length;num++)
-        {
-            if(data[num] == 'D')
-            {
-                lastFound = 'D';
-            }
-            else if(lastFound == 'D' && data[num] == 'L')
-            {
-                lastFound = 'L';
-            }
-            else if(lastFound == 'L' && data[num] == 'T')
-            {
-                lastFound = 'T';
-            }
-            else if(lastFound == 'T' && data[num] == 0x01)
-            {
-                indexAllList.append(pos+num-3);
-                lastFound = 0;
-            }
-            else
-            {
-                lastFound = 0;
-            }
-
-            /* stop if requested */
-            if(stopFlag)
-            {
-                delete[] data;
-                f.close();
-                return false;
-            }
-        }
-        emit(progress(pos));
+        // index only the messages appended since the index was cached
+        success = indexAppended(f);
+    }
+    else
+    {
+        // clear old index
+        indexAllList.clear();
+        metadataAll.clear();
+
+        // Go through the segments and create new index, split into ranges for large files
+        int ranges = static_cast<int>(qMin(static_cast<qint64>(QThread::idealThreadCount()), size / DLT_FILE_INDEXER_RANGE_MIN_SIZE));
+        if(multithreaded && ranges > 1)
+            success = indexRanges(f, ranges);
+        else
+            success = indexRange(f, 0, -1, indexAllList, &metadataAll);
     }
-    while(length>0);
-
-    // delete buffer
-    delete[] data;
 
-    // close file
-    f.close();
+    if(!success)
+    {
+        f.close();
+        return false;
+    }
 
     qDebug() << "Created index for file" << dltFile->getFileName(num);
 
@@ -170,17 +172,123 @@ bool DltFileIndexer::index(int num)
     // write index if enabled
     if(!filterCache.isEmpty())
     {
-        saveIndexCache(dltFile->getFileName(num));
+        saveIndexCache(f, size);
         qDebug() << "Saved index cache for file" << dltFile->getFileName(num);
     }
 
+    // close file
+    f.close();
+
+    return true;
+}
+
+bool DltFileIndexer::indexRange(QFile &f, qint64 begin, qint64 end, QDltIndex &index, QDltFileMetadata *metadata, qint64 *handoff)
+{
+    QDltFileScanner scanner;
+
+    scanner.reset(begin, end);
+    while(scanner.scanFile(f, index, metadata))
+    {
+        emit(progress(scanner.position()));
+
+        /* stop if requested */
+        if(stopFlag)
+            return false;
+    }
+
+    if(handoff)
+        *handoff = scanner.handoff();
+
     return true;
 }
 
+bool DltFileIndexer::indexAppended(QFile &f)
+{
+    // keep the metadata only if it covers all messages of the cached index
+    if(metadataAll.size() < indexAllList.size())
+        metadataAll.clear();
+    QDltFileMetadata *metadata = metadataAll.size() >= indexAllList.size() ? &metadataAll : 0;
+
+    // the last message could have been incomplete when the cache was written, index it again
+    qint64 begin = QDltFileScanner::resumeIndex(indexAllList, metadata);
+
+    qDebug() << "Index file" << f.fileName() << "from position" << begin;
+
+    return indexRange(f, begin, -1, indexAllList, metadata);
+}
+
+bool DltFileIndexer::indexRanges(QFile &f, int ranges)
+{
+    QList<DltFileIndexerRangeThread*> threads;
+    qint64 fileSize = f.size();
+    bool success = true;
+
+    // scan all ranges in parallel, each range also finds the first message behind its end
+    for(int num=0;num<ranges;num++)
+    {
+        qint64 begin = fileSize * num / ranges;
+        qint64 end = (num == ranges-1) ? -1 : fileSize * (num+1) / ranges;
+        threads.append(new DltFileIndexerRangeThread(f.fileName(), begin, end));
+        threads.last()->start();
+    }
+
+    for(int num=0;num<threads.size();num++)
+    {
+        while(!threads[num]->wait(100))
+        {
+            int segments = 0;
+            for(int i=0;i<threads.size();i++)
+                segments += threads[i]->getProgress();
+            emit(progress(qMin(fileSize, static_cast<qint64>(segments) * QDltFileScanner::blockSize)));
+
+            /* stop if requested */
+            if(stopFlag)
+            {
+                for(int i=0;i<threads.size();i++)
+                    threads[i]->requestStop();
+            }
+        }
+        success = success && threads[num]->getSuccess();
+    }
+
+    // concatenate ranges, a range is used beginning at the message where the previous range ends,
+    // messages found before are matches inside the payload of the last message of the previous range
+    if(success)
+    {
+        qint64 handoff;
+        indexAllList = threads[0]->getIndex();
+        metadataAll = threads[0]->getMetadata();
+        handoff = threads[0]->getHandoff();
+        for(int num=1;num<threads.size() && success && handoff>=0;num++)
+        {
+            const QDltIndex &rangeIndex = threads[num]->getIndex();
+            qint64 first = rangeIndex.lowerBound(handoff);
+            if(first < rangeIndex.size() && rangeIndex[first] == handoff)
+            {
+                indexAllList.append(rangeIndex, first);
+                metadataAll.append(threads[num]->getMetadata(), first);
+                handoff = threads[num]->getHandoff();
+            }
+            else
+            {
+                // range did not run into the same message, index it again beginning at the handoff
+                qint64 end = (num == threads.size()-1) ? -1 : fileSize * (num+1) / threads.size();
+                success = indexRange(f, handoff, end, indexAllList, &metadataAll, &handoff);
+            }
+        }
+    }
+
+    qDeleteAll(threads);
+
+    return success;
+}
+
 bool DltFileIndexer::indexFilter(QStringList filenames)
 {
-    QSharedPointer<QDltMsg> msg;
+    QDltMsg msg;
+    DltMsgBatch *batch = 0;
     QDltFilterList filterList;
+    QDltMsgMetadata metadata;
     QTime time;
 
     // start performance counter
@@ -198,6 +306,39 @@ bool DltFileIndexer::indexFilter(QStringList filenames)
         return true;
     }
 
+    // match results of single filters are only valid for the same messages decoded by the same plugins
+    if(mode == modeIndexAndFilter)
+        filterMatchCache.clear();
+    QByteArray identity = md5FilterMatchCache(filenames);
+    if(identity.isEmpty())
+        filterMatchCache.clear();
+    filterMatchCache.validate(identity, dltFile->size());
+    bool useFilterMatchCache = filterMatchCache.prepare(filterList);
+
+    // all filters are known, the filter index is created without reading the messages
+    if(useFilterMatchCache && mode == modeFilter && filterMatchCache.isComplete() && (!sortByTimeEnabled || dltFile->hasMetadata()))
+    {
+        getLogInfoList.clear();
+        filterMatchCache.createIndex(indexFilterList);
+        if(sortByTimeEnabled)
+        {
+            indexFilterListSorted.clear();
+            indexFilterListSorted.reserve(indexFilterList.size());
+            for(qint64 num = 0; num < indexFilterList.size(); num++)
+            {
+                qint64 ix = indexFilterList.at(num);
+                dltFile->getMsgMetadata(ix, metadata);
+                indexFilterListSorted.push_back(DltFileIndexerKey(metadata.time, metadata.microseconds, ix));
+            }
+            sortIndexFilter();
+            indexFilterListSorted.clear();
+            indexFilterListSorted.shrink_to_fit();
+        }
+        qDebug() << "Created filter index from known filter results";
+        msecsFilterCounter = time.elapsed();
+        return true;
+    }
+
     // Initialise progress bar
     emit(progressText(QString("%1/%2").arg(currentRun).arg(maxRun)));
     emit(progressMax(dltFile->size()));
@@ -213,12 +354,18 @@ bool DltFileIndexer::indexFilter(QStringList filenames)
     bool hasPlugins = (activeDecoderPlugins.size() + activeViewerPlugins.size()) > 0;
     bool hasFilters = filterList.filters.size() > 0;
 
-    bool useIndexerThread = hasPlugins || hasFilters;
+    // without plugins and with filters on header fields only, only control messages need to be read,
+    // all others are filtered with the header metadata
+    bool useMetadata = !hasPlugins && filterList.isHeaderOnly() && dltFile->hasMetadata();
+    QList<QDltFilter*> matchFilters = filterList.getMatchFilters();
+
+    bool useIndexerThread = (hasPlugins || hasFilters) && !useMetadata;
 
     DltFileIndexerThread indexerThread
             (
                 this,
                 &filterList,
+                useFilterMatchCache ? &filterMatchCache : 0,
                 sortByTimeEnabled,
                 &indexFilterList,
                 &indexFilterListSorted,
@@ -227,21 +374,79 @@ bool DltFileIndexer::indexFilter(QStringList filenames)
                 silentMode
             );
 
+    // viewer plugins need each message before and after decoding in order, and decoder plugins
+    // which are not thread safe decode one message after the other, otherwise
+    // decoding and filtering is spread over worker threads and only the results are sequenced
+    bool viewerPluginsEnabled = mode == modeIndexAndFilter && pluginsEnabled && !activeViewerPlugins.isEmpty();
+    bool decoderPluginsSequential = pluginsEnabled && !pluginManager->isDecoderThreadSafe();
+    QList<DltFileIndexerWorkerThread*> workerThreads;
+
+    if(useIndexerThread && !viewerPluginsEnabled && !decoderPluginsSequential)
+    {
+        // one thread is left for reading and one for sequencing
+        int numberOfWorkers = qMax(1, QThread::idealThreadCount() - 2);
+        for(int num = 0; num < numberOfWorkers; num++)
+        {
+            DltFileIndexerWorkerThread *workerThread = new DltFileIndexerWorkerThread(filterList, useFilterMatchCache ? &filterMatchCache : 0, pluginManager, pluginsEnabled, silentMode);
+            workerThread->start();
+            workerThreads.append(workerThread);
+        }
+        indexerThread.setWorkerThreads(workerThreads);
+    }
+
     if(useIndexerThread)
         indexerThread.start(); // thread starts reading its queue
 
+    // all messages are read once in order, in large blocks
+    dltFile->setAccessHint(QDltFile::AccessSequential);
+    QDltFileCursor cursor(dltFile);
+
     // Start reading messages
-    for(int ix=0;ix<dltFile->size();ix++)
+    qint64 count = dltFile->size();
+    for(qint64 ix=0;ix<count;ix++)
     {
-        msg = QSharedPointer<QDltMsg>::create(); // create new instance to be filled by getMsg(), otherwise shared pointer would be empty or pointing to last message
+        if(useMetadata && dltFile->getMsgMetadata(ix, metadata) && metadata.length != 0 && metadata.type != QDltMsg::DltTypeControl)
+        {
+            // header is enough, the message is not read
+            bool found;
+            if(useFilterMatchCache)
+            {
+                quint64 mask;
+                found = filterMatchCache.checkFilter(matchFilters, metadata, ix, mask);
+                filterMatchCache.store(ix, mask);
+            }
+            else
+            {
+                found = filterList.checkFilter(metadata);
+            }
+            if(found && sortByTimeEnabled)
+                indexFilterListSorted.push_back(DltFileIndexerKey(metadata.time, metadata.microseconds, ix));
+            else if(found)
+                indexFilterList.append(ix);
+        }
+        else if(useIndexerThread)
+        {
+            // fill recycled messages and pass them in batches to the indexer thread
+            if(!batch)
+                batch = indexerThread.getFreeBatch();
 
-        if(!dltFile->getMsg(ix, *msg))
-            continue; // Skip broken messages
+            if(!cursor.getMsg(ix, batch->msgs[batch->count], true, true))
+                continue; // Skip broken messages
 
-        if(useIndexerThread)
-            indexerThread.enqueueMessage(msg, ix);
+            batch->indexes[batch->count++] = ix;
+            if(batch->isFull())
+            {
+                indexerThread.enqueueBatch(batch);
+                batch = 0;
+            }
+        }
         else
+        {
+            if(!cursor.getMsg(ix, msg, true, true))
+                continue; // Skip broken messages
+
             indexerThread.processMessage(msg, ix);
+        }
 
         // Update progress
         if(ix % 1000 == 0)
@@ -252,21 +457,55 @@ bool DltFileIndexer::indexFilter(QStringList filenames)
         {
             if(useIndexerThread)
             {
+                if(batch)
+                    indexerThread.enqueueBatch(batch);
                 indexerThread.requestStop();
                 indexerThread.wait();
+                for(int num = 0; num < workerThreads.size(); num++)
+                    workerThreads[num]->wait();
+                qDeleteAll(workerThreads);
             }
 
+            // results of the pending filters are incomplete
+            filterMatchCache.abort();
+
+            dltFile->setAccessHint(QDltFile::AccessRandom);
             return false;
         }
     }
 
+    // view accesses messages randomly
+    dltFile->setAccessHint(QDltFile::AccessRandom);
+
     // destroy threads
     if(useIndexerThread)
     {
+        if(batch)
+            indexerThread.enqueueBatch(batch); // last messages
         indexerThread.requestStop();
         indexerThread.wait();
+        for(int num = 0; num < workerThreads.size(); num++)
+            workerThreads[num]->wait();
+
+        if(workerThreads.isEmpty())
+        {
+            const DltMsgQueue &queue = indexerThread.getMsgQueue();
+            qDebug() << "Filter index queue: max depth" << queue.getMaxDepth() << "batches, reader stalled"
+                     << queue.getProducerStallMsecs() << "msecs, worker stalled" << queue.getConsumerStallMsecs() << "msecs";
+        }
+        for(int num = 0; num < workerThreads.size(); num++)
+        {
+            const DltMsgQueue &queue = workerThreads[num]->getMsgQueue();
+            qDebug() << "Filter index queue of worker" << num << ": max depth" << queue.getMaxDepth() << "batches, reader stalled"
+                     << queue.getProducerStallMsecs() << "msecs, worker stalled" << queue.getConsumerStallMsecs() << "msecs";
+        }
+        qDeleteAll(workerThreads);
     }
 
+    // keep the results of the filters evaluated for all messages
+    if(useFilterMatchCache)
+        filterMatchCache.finish();
+
     //qDebug() << "Created filter index for files" << filenames;
 
     // update performance counter
@@ -274,7 +513,11 @@ bool DltFileIndexer::indexFilter(QStringList filenames)
 
     // use sorted values if sort by time enabled
     if(sortByTimeEnabled)
-        indexFilterList = QVector<qint64>::fromList(indexFilterListSorted.values());
+    {
+        sortIndexFilter();
+        indexFilterListSorted.clear();
+        indexFilterListSorted.shrink_to_fit();
+    }
 
     // write filter index if enabled
     if(!filterCache.isEmpty())
@@ -286,9 +529,65 @@ bool DltFileIndexer::indexFilter(QStringList filenames)
     return true;
 }
 
+void DltFileIndexer::sortIndexFilter()
+{
+    DltFileIndexerKey *keys = indexFilterListSorted.data();
+    qint64 count = indexFilterListSorted.size();
+    QVector<qint64> runs;
+
+    // find the runs which are already sorted, usually one per file
+    runs.append(0);
+    for(qint64 num = 1; num < count; num++)
+        if(keys[num] < keys[num - 1])
+            runs.append(num);
+    runs.append(count);
+
+    // too many runs, sort slices of the keys in parallel instead
+    if(runs.size() - 1 > DLT_FILE_INDEXER_SORT_MAX_RUNS)
+    {
+        int numberOfThreads = qMax(1, QThread::idealThreadCount());
+        QList<DltFileIndexerSortThread*> threads;
+
+        runs.clear();
+        for(int num = 0; num <= numberOfThreads; num++)
+            runs.append(count * num / numberOfThreads);
+
+        for(int num = 0; num < numberOfThreads; num++)
+        {
+            DltFileIndexerSortThread *thread = new DltFileIndexerSortThread(keys + runs[num], keys + runs[num + 1]);
+            thread->start();
+            threads.append(thread);
+        }
+        for(int num = 0; num < threads.size(); num++)
+            threads[num]->wait();
+        qDeleteAll(threads);
+    }
+
+    // k-way merge of the sorted runs
+    QVector<DltFileIndexerRun> heap;
+    for(int num = 0; num < runs.size() - 1; num++)
+        if(runs[num] < runs[num + 1])
+            heap.append(DltFileIndexerRun(keys + runs[num], keys + runs[num + 1]));
+    std::make_heap(heap.begin(), heap.end(), runGreater);
+
+    indexFilterList.clear();
+    indexFilterList.reserve(count);
+    while(!heap.isEmpty())
+    {
+        std::pop_heap(heap.begin(), heap.end(), runGreater);
+        DltFileIndexerRun &run = heap.last();
+        indexFilterList.append(run.pos->getIndex());
+        if(++run.pos == run.end)
+            heap.removeLast();
+        else
+            std::push_heap(heap.begin(), heap.end(), runGreater);
+    }
+}
+
 bool DltFileIndexer::indexDefaultFilter()
 {
-    QSharedPointer<QDltMsg> msg;
+    QDltMsg msg;
+    DltMsgBatch *batch = 0;
     QTime time;
 
     // start performance counter
@@ -316,21 +615,44 @@ bool DltFileIndexer::indexDefaultFilter()
     if(useDefaultFilterThread)
         defaultFilterThread.start();
 
+    // all messages are read once in order, in large blocks
+    dltFile->setAccessHint(QDltFile::AccessSequential);
+    QDltFileCursor cursor(dltFile);
+
     /* run through the whole open file */
-    for(int ix = 0; ix < dltFile->size(); ix++)
+    qint64 count = dltFile->size();
+    for(qint64 ix = 0; ix < count; ix++)
     {
-        msg = QSharedPointer<QDltMsg>::create();
-        /* Fill message from file */
-        if(!dltFile->getMsg(ix, *msg))
+        if(useDefaultFilterThread)
         {
-            /* Skip broken messages */
-            continue;
-        }
+            /* Fill recycled messages and pass them in batches to the default filter thread */
+            if(!batch)
+                batch = defaultFilterThread.getFreeBatch();
 
-        if(useDefaultFilterThread)
-            defaultFilterThread.enqueueMessage(msg, ix);
+            if(!cursor.getMsg(ix, batch->msgs[batch->count], true, true))
+            {
+                /* Skip broken messages */
+                continue;
+            }
+
+            batch->indexes[batch->count++] = ix;
+            if(batch->isFull())
+            {
+                defaultFilterThread.enqueueBatch(batch);
+                batch = 0;
+            }
+        }
         else
+        {
+            /* Fill message from file */
+            if(!cursor.getMsg(ix, msg, true, true))
+            {
+                /* Skip broken messages */
+                continue;
+            }
+
             defaultFilterThread.processMessage(msg, ix);
+        }
 
         /* Update progress */
         if(ix % 1000 == 0)
@@ -341,21 +663,36 @@ bool DltFileIndexer::indexDefaultFilter()
         {
             if(useDefaultFilterThread)
             {
+                if(batch)
+                    defaultFilterThread.enqueueBatch(batch);
                 defaultFilterThread.requestStop();
                 defaultFilterThread.wait();
             }
 
+            dltFile->setAccessHint(QDltFile::AccessRandom);
             return false;
         }
     }
 
+    // view accesses messages randomly
+    dltFile->setAccessHint(QDltFile::AccessRandom);
+
     if(useDefaultFilterThread)
     {
+        if(batch)
+            defaultFilterThread.enqueueBatch(batch); /* last messages */
         defaultFilterThread.requestStop();
         defaultFilterThread.wait();
+
+        const DltMsgQueue &queue = defaultFilterThread.getMsgQueue();
+        qDebug() << "Default filter index queue: max depth" << queue.getMaxDepth() << "batches, reader stalled"
+                 << queue.getProducerStallMsecs() << "msecs, worker stalled" << queue.getConsumerStallMsecs() << "msecs";
     }
 
     /* update plausibility checks of filter index cache, filename and filesize */
+    QStringList filenames;
+    for(int num=0;num<dltFile->getNumberOfFiles();num++)
+        filenames.append(dltFile->getFileName(num));
     for(int num=0; num < defaultFilter->defaultFilterIndex.size(); num++)
     {
         QDltFilterIndex *filterIndex;
@@ -366,9 +703,9 @@ bool DltFileIndexer::indexDefaultFilter()
         filterIndex->setDltFileName(dltFile->getFileName());
         filterIndex->setAllIndexSize(dltFile->size());
 
-        // write filter index if enabled
+        // write filter index if enabled, the index covers all opened files
         if(!filterCache.isEmpty())
-            saveFilterIndexCache(*filterList, filterIndex->indexFilter, QStringList(dltFile->getFileName()));
+            saveFilterIndexCache(*filterList, filterIndex->indexFilter, filenames);
     }
 
     // update performance counter
@@ -393,7 +730,7 @@ bool DltFileIndexer::tryLock()
     return indexLock.tryLock();
 }
 
-void DltFileIndexer::appendToGetLogInfoList(int value)
+void DltFileIndexer::appendToGetLogInfoList(qint64 value)
 {
     getLogInfoList.append(value);
 }
@@ -433,6 +770,7 @@ void DltFileIndexer::run()
                 return;
             }
             dltFile->setDltIndex(indexAllList,num);
+            dltFile->setDltMetadata(metadataAll,num);
             currentRun++;
         }
         emit(finishIndex());
@@ -448,7 +786,7 @@ void DltFileIndexer::run()
     {
         QStringList filenames;
         for(int num=0;num<dltFile->getNumberOfFiles();num++)
-            filenames.append(QFileInfo(dltFile->getFileName(num)).fileName());
+            filenames.append(dltFile->getFileName(num));
         if((mode != modeNone) && !indexFilter(filenames))
         {
             // error
@@ -489,45 +827,76 @@ void DltFileIndexer::stop()
 }
 
 // load/safe index from/to file
-bool DltFileIndexer::loadIndexCache(QString filename)
+bool DltFileIndexer::loadIndexCache(QFile &f, qint64 &indexedSize)
 {
     QString filenameCache;
+    DltFileIndexerFingerprint cached;
+    DltFileIndexerFingerprint current;
 
     // check if caching is enabled
     if(filterCache.isEmpty())
         return false;
 
     // get the filename for the cache file
-    filenameCache = filenameIndexCache(filename);
+    filenameCache = filenameIndexCache(f.fileName());
 
     // load the cache file
-    if(!loadIndex(filterCache + "/" +filenameCache,indexAllList))
+    if(!loadIndex(filterCache + "/" +filenameCache,indexAllList,cached))
     {
         // loading cache file failed
         return false;
     }
 
+    // the file must be unchanged, or only extended since it was indexed
+    if(cached.size > f.size() ||
+       (cached.size == f.size() && cached.modified != QFileInfo(f).lastModified().toMSecsSinceEpoch()) ||
+       !createFingerprint(f, cached.size, current) ||
+       current.head != cached.head || current.tail != cached.tail)
+    {
+        indexAllList.clear();
+        return false;
+    }
+
+    // load the metadata, the index can be used without it
+    filenameCache.replace(".dix", ".dim");
+    if(!loadMetadata(filterCache + "/" +filenameCache,metadataAll) || metadataAll.size() != indexAllList.size())
+        metadataAll.clear();
+
+    indexedSize = cached.size;
+
     return true;
 }
 
-bool DltFileIndexer::saveIndexCache(QString filename)
+bool DltFileIndexer::saveIndexCache(QFile &f, qint64 indexedSize)
 {
     QString filenameCache;
+    DltFileIndexerFingerprint fingerprint;
 
     // check if caching is enabled
     if(filterCache.isEmpty())
         return false;
 
     // get the filename for the cache file
-    filenameCache = filenameIndexCache(filename);
+    filenameCache = filenameIndexCache(f.fileName());
+
+    // fingerprint of the part of the file which was indexed
+    if(!createFingerprint(f, indexedSize, fingerprint))
+        return false;
 
     // save the cache file
-    if(!saveIndex(filterCache + "/" +filenameCache,indexAllList))
+    if(!saveIndex(filterCache + "/" +filenameCache,indexAllList,fingerprint))
     {
         // saving cache file failed
         return false;
     }
 
+    // save the metadata next to the index
+    if(metadataAll.size() == indexAllList.size())
+    {
+        filenameCache.replace(".dix", ".dim");
+        saveMetadata(filterCache + "/" +filenameCache,metadataAll);
+    }
+
     return true;
 }
 
@@ -538,12 +907,11 @@ QString DltFileIndexer::filenameIndexCache(QString filename)
     QByteArray md5;
     QString filenameCache;
 
-    // create string to be hashed
-    hashString = QFileInfo(filename).fileName();
-    hashString += "_" + QString("%1").arg(dltFile->fileSize());
+    // create string to be hashed, the content is checked with the fingerprint
+    hashString = QFileInfo(filename).absoluteFilePath();
 
     // create byte array from hash string
-    hashByteArray = hashString.toLatin1();
+    hashByteArray = hashString.toUtf8();
 
     // create MD5 from byte array
     md5 = QCryptographicHash::hash(hashByteArray, QCryptographicHash::Md5);
@@ -556,10 +924,11 @@ QString DltFileIndexer::filenameIndexCache(QString filename)
     return filenameCache;
 }
 
-// read/write index cache
-bool DltFileIndexer::loadFilterIndexCache(QDltFilterList &filterList, QVector<qint64> &index, QStringList filenames)
+// read/write filter index cache
+bool DltFileIndexer::loadFilterIndexCache(QDltFilterList &filterList, QDltIndex &index, QStringList filenames)
 {
     QString filenameCache;
+    DltFileIndexerFingerprint cached;
 
     // check if caching is enabled
     if(filterCache.isEmpty())
@@ -567,24 +936,28 @@ bool DltFileIndexer::loadFilterIndexCache(QDltFilterList &filterList, QVector<qi
 
     // get the filename for the cache file
     filenameCache = filenameFilterIndexCache(filterList,filenames);
+    if(filenameCache.isEmpty())
+        return false;
 
-    // load the cache file
-    if(loadIndex(filterCache + "/" +filenameCache,index))
+    // load the cache file, the identity of the files is part of the filename
+    if(loadIndex(filterCache + "/" +filenameCache,index,cached) && cached.size == dltFile->indexedFileSize(0))
     {
         qDebug() << "loadIndex" << filterCache + "/" +filenameCache << "success";
     }
     else
     {
         qDebug() << "loadIndex" << filterCache + "/" +filenameCache << "failed";
+        index.clear();
         return false;
-    }        
+    }
 
     return true;
 }
 
-bool DltFileIndexer::saveFilterIndexCache(QDltFilterList &filterList, QVector<qint64> index, QStringList filenames)
+bool DltFileIndexer::saveFilterIndexCache(QDltFilterList &filterList, const QDltIndex &index, QStringList filenames)
 {
     QString filename;
+    DltFileIndexerFingerprint fingerprint;
 
     // check if caching is enabled
     if(filterCache.isEmpty())
@@ -592,9 +965,17 @@ bool DltFileIndexer::saveFilterIndexCache(QDltFilterList &filterList, QVector<qi
 
     // get the filename for the cache file
     filename = filenameFilterIndexCache(filterList,filenames);
+    if(filename.isEmpty())
+        return false;
+
+    // fingerprint of the indexed part of the first file
+    QFile f(filenames.first());
+    if(!f.open(QIODevice::ReadOnly) || !createFingerprint(f, dltFile->indexedFileSize(0), fingerprint))
+        return false;
+    f.close();
 
     // save the cache file
-    if(!saveIndex(filterCache + "/" +filename,index))
+    if(!saveIndex(filterCache + "/" +filename,index,fingerprint))
     {
         // saving of cache file failed
         return false;
@@ -603,73 +984,88 @@ bool DltFileIndexer::saveFilterIndexCache(QDltFilterList &filterList, QVector<qi
     return true;
 }
 
-QByteArray DltFileIndexer::md5ActiveDecoderPlugins()
+QString DltFileIndexer::filenameFilterIndexCache(QDltFilterList &filterList, QStringList filenames)
 {
-    QByteArray md5;
-    QString hashString = "Plugins";
-    QByteArray hashByteArray;
+    QByteArray md5Files;
+    QByteArray md5FilterList;
+    QString filename;
 
-    // walk through all active decoder plugins and generate String with all plugin names, version and loaded filename
-    for(int num=0;num<activeDecoderPlugins.size();num++)
-    {
-        QDltPlugin *plugin = activeDecoderPlugins[num];
+    // identity of the indexed part of the files and the decoder plugins, not cached if a file cannot be read
+    md5Files = md5FilterMatchCache(filenames);
+    if(md5Files.isEmpty())
+        return QString();
+
+    // get filter list
+    md5FilterList = filterList.createMD5();
 
-        hashString += plugin->getName();
-        hashString += plugin->getPluginVersion();
-        hashString += plugin->getFilename();
+    // create filename
+    filename = QString(md5Files.toHex()) + "_" + QString(md5FilterList.toHex());
+    if(this->sortByTimeEnabled)
+    {
+        filename += "_S";
     }
-    hashByteArray = hashString.toLatin1();
+    filename += ".dix";
 
-    // calculate hash value
-    md5 = QCryptographicHash::hash(hashByteArray, QCryptographicHash::Md5);
+    //qDebug() << filenames << ">>" << filename;
 
-    return md5;
+    return filename;
 }
 
-QString DltFileIndexer::filenameFilterIndexCache(QDltFilterList &filterList,QStringList filenames)
+bool DltFileIndexer::createFingerprint(QFile &f, qint64 size, DltFileIndexerFingerprint &fingerprint)
 {
-    QString hashString;
-    QByteArray hashByteArray;
-    QByteArray md5;
-    QByteArray md5FilterList;
-    QString filename;
+    qint64 length = qMin(size, static_cast<qint64>(DLT_FILE_INDEXER_FINGERPRINT_SIZE));
 
-    // get filter list
-    md5FilterList = filterList.createMD5();
+    fingerprint.size = size;
+    fingerprint.modified = QFileInfo(f).lastModified().toMSecsSinceEpoch();
 
-    // create string to be hashed
-    if(sortByTimeEnabled)
-        filenames.sort();
-    hashString = filenames.join(QString("_"));
-    hashString += "_" + QString("%1").arg(dltFile->fileSize());
+    // hash of the first and the last block of the indexed part of the file
+    if(!f.seek(0))
+        return false;
+    QByteArray head = f.read(length);
+    if(!f.seek(size - length))
+        return false;
+    QByteArray tail = f.read(length);
+    if(head.size() != length || tail.size() != length)
+        return false;
 
-    // create byte array from hash string
-    hashByteArray = hashString.toLatin1();
+    fingerprint.head = QCryptographicHash::hash(head, QCryptographicHash::Md5);
+    fingerprint.tail = QCryptographicHash::hash(tail, QCryptographicHash::Md5);
 
-    // create MD5 from byte array
-    md5 = QCryptographicHash::hash(hashByteArray, QCryptographicHash::Md5);
+    return true;
+}
 
-    // create filename
-    filename = QString(md5.toHex()) + "_" + QString(md5FilterList.toHex());
-    if(this->pluginsEnabled)
+QByteArray DltFileIndexer::md5FilterMatchCache(QStringList filenames)
+{
+    QString hashString;
+    DltFileIndexerFingerprint fingerprint;
+
+    // message numbers depend on the files, their order and the content of the indexed part,
+    // a file which is still written keeps its identity until more messages are indexed
+    for(int num=0;num<filenames.size();num++)
     {
-        filename += "_" + QString(md5ActiveDecoderPlugins().toHex());
+        QFile f(filenames[num]);
+        qint64 indexedSize = dltFile->indexedFileSize(num);
+        if(indexedSize < 0 || !f.open(QIODevice::ReadOnly) || !createFingerprint(f, indexedSize, fingerprint))
+            return QByteArray(); // results are not cached
+        f.close();
+
+        hashString += "_" + QFileInfo(filenames[num]).fileName();
+        hashString += "_" + QString("%1").arg(fingerprint.size);
+        hashString += "_" + QString(fingerprint.head.toHex()) + "_" + QString(fingerprint.tail.toHex());
     }
-    if(this->sortByTimeEnabled)
+
+    // decoded messages depend on the decoder plugins
+    if(this->pluginsEnabled)
     {
-        filename += "_S";
+        hashString += "_" + QString(pluginManager->getDecoderConfiguration().toHex());
     }
-    filename += ".dix";
-
-    //qDebug() << filenames << ">>" << filename;
 
-    return filename;
+    return QCryptographicHash::hash(hashString.toUtf8(), QCryptographicHash::Md5);
 }
 
-bool DltFileIndexer::saveIndex(QString filename, const QVector<qint64> &index)
+bool DltFileIndexer::saveIndex(QString filename, const QDltIndex &index, const DltFileIndexerFingerprint &fingerprint)
 {
     quint32 version = DLT_FILE_INDEXER_FILE_VERSION;
-    qint64 value;
 
     QFile file(filename);
 
@@ -680,14 +1076,17 @@ bool DltFileIndexer::saveIndex(QString filename, const QVector<qint64> &index)
         return false;
     }
 
-    // write version
-    file.write((char*)&version,sizeof(version));
-
-    // write complete index
-    for(int num=0;num<index.size();num++)
+    // write version, fingerprint of the indexed file and the complete index
+    if(file.write((char*)&version,sizeof(version)) != sizeof(version) ||
+       file.write((char*)&fingerprint.size,sizeof(fingerprint.size)) != sizeof(fingerprint.size) ||
+       file.write((char*)&fingerprint.modified,sizeof(fingerprint.modified)) != sizeof(fingerprint.modified) ||
+       file.write(fingerprint.head) != fingerprint.head.size() ||
+       file.write(fingerprint.tail) != fingerprint.tail.size() ||
+       !index.write(file))
     {
-        value = index[num];
-        file.write((char*)&value,sizeof(value));
+        file.close();
+        file.remove();
+        return false;
     }
 
     // close cache file
@@ -696,11 +1095,9 @@ bool DltFileIndexer::saveIndex(QString filename, const QVector<qint64> &index)
     return true;
 }
 
-bool DltFileIndexer::loadIndex(QString filename, QVector<qint64> &index)
+bool DltFileIndexer::loadIndex(QString filename, QDltIndex &index, DltFileIndexerFingerprint &fingerprint)
 {
     quint32 version;
-    qint64 value;
-    int length;
 
     QFile file(filename);
 
@@ -713,30 +1110,91 @@ bool DltFileIndexer::loadIndex(QString filename, QVector<qint64> &index)
         return false;
     }
 
-    index.reserve(static_cast<int>((file.size() - sizeof(version)) / sizeof(value))); // prevent memory issues through reallocation
-
-    // read version
-    length = file.read((char*)&version,sizeof(version));
-
     // compare version if valid
-    if((length != sizeof(version)) || version != DLT_FILE_INDEXER_FILE_VERSION)
+    if((file.read((char*)&version,sizeof(version)) != sizeof(version)) || version != DLT_FILE_INDEXER_FILE_VERSION)
     {
         // wrong version number
         file.close();
         return false;
     }
 
-    // read complete index
-    do
+    // read fingerprint of the indexed file and the complete index
+    if(file.read((char*)&fingerprint.size,sizeof(fingerprint.size)) != sizeof(fingerprint.size) ||
+       file.read((char*)&fingerprint.modified,sizeof(fingerprint.modified)) != sizeof(fingerprint.modified))
+    {
+        file.close();
+        return false;
+    }
+    fingerprint.head = file.read(16);
+    fingerprint.tail = file.read(16);
+    if(fingerprint.head.size() != 16 || fingerprint.tail.size() != 16 || !index.read(file))
     {
-        length = file.read((char*)&value,sizeof(value));
-        if(length==sizeof(value))
-            index.append(value);
+        file.close();
+        return false;
     }
-    while(length==sizeof(value));
 
     // close cache file
     file.close();
 
     return true;
 }
+
+bool DltFileIndexer::saveMetadata(QString filename, const QDltFileMetadata &metadata)
+{
+    quint32 version = DLT_FILE_INDEXER_METADATA_VERSION;
+
+    QFile file(filename);
+
+    // open cache file
+    if(!file.open(QFile::WriteOnly))
+    {
+        // open file failed
+        return false;
+    }
+
+    // write version and all columns
+    if(file.write((char*)&version,sizeof(version)) != sizeof(version) || !metadata.write(file))
+    {
+        file.close();
+        file.remove();
+        return false;
+    }
+
+    // close cache file
+    file.close();
+
+    return true;
+}
+
+bool DltFileIndexer::loadMetadata(QString filename, QDltFileMetadata &metadata)
+{
+    quint32 version;
+    bool success;
+
+    QFile file(filename);
+
+    metadata.clear();
+
+    // open cache file
+    if(!file.open(QFile::ReadOnly))
+    {
+        // open file failed
+        return false;
+    }
+
+    // compare version if valid
+    if((file.read((char*)&version,sizeof(version)) != sizeof(version)) || version != DLT_FILE_INDEXER_METADATA_VERSION)
+    {
+        // wrong version number
+        file.close();
+        return false;
+    }
+
+    // read all columns
+    success = metadata.read(file);
+
+    // close cache file
+    file.close();
+
+    return success;
+}
@@ -8,21 +8,49 @@
 #include <QPair>
 #include <QMutex>
 
+#include <vector>
+
 #include "qdlt.h"
+#include "dltfiltermatchcache.h"
+
+#define DLT_FILE_INDEXER_RANGE_MIN_SIZE (32*1024*1024)
+#define DLT_FILE_INDEXER_FILE_VERSION 5
+#define DLT_FILE_INDEXER_METADATA_VERSION 1
+#define DLT_FILE_INDEXER_FINGERPRINT_SIZE (64*1024)
+
+#define DLT_FILE_INDEXER_SORT_MAX_RUNS 64
 
-#define DLT_FILE_INDEXER_SEG_SIZE (1024*1024)
-#define DLT_FILE_INDEXER_FILE_VERSION 2
+// Content fingerprint of an indexed file stored in the index cache.
+// A file which was only extended since it was indexed has the same
+// first and last block up to the indexed size.
+class DltFileIndexerFingerprint
+{
+public:
+    DltFileIndexerFingerprint() : size(0), modified(0) {}
 
+    qint64 size;
+    qint64 modified;
+    QByteArray head;
+    QByteArray tail;
+};
+
+// Sort key of a message in the filter index when sorting by time.
+// Messages with the same time keep the order of the files.
 class DltFileIndexerKey
 {
 public:
-    DltFileIndexerKey(time_t time,unsigned int microseconds);
+    DltFileIndexerKey() : time(0), microseconds(0), index(0) {}
+    DltFileIndexerKey(time_t time,unsigned int microseconds,qint64 index);
+
+    qint64 getIndex() const { return index; }
 
     friend bool operator< (const DltFileIndexerKey &key1, const DltFileIndexerKey &key2);
 
 private:
-    time_t time;
-    unsigned int microseconds;
+    // seconds of the storage header have 32 bits
+    quint32 time;
+    quint32 microseconds;
+    qint64 index;
 };
 
 inline bool operator< (const DltFileIndexerKey &key1, const DltFileIndexerKey &key2)
@@ -31,7 +59,11 @@ inline bool operator< (const DltFileIndexerKey &key1, const DltFileIndexerKey &k
         return true;
     if(key1.time>key2.time)
         return false;
-    return (key1.microseconds<key2.microseconds);
+    if(key1.microseconds<key2.microseconds)
+        return true;
+    if(key1.microseconds>key2.microseconds)
+        return false;
+    return (key1.index<key2.index);
 }
 
 class DltFileIndexer : public QThread
@@ -51,24 +83,43 @@ public:
     // create main index
     bool index(int num);
 
+    // create main index of a byte range of a file
+    bool indexRange(QFile &f, qint64 begin, qint64 end, QDltIndex &index, QDltFileMetadata *metadata = 0, qint64 *handoff = 0);
+
+    // create main index by scanning byte ranges of a file in parallel
+    bool indexRanges(QFile &f, int ranges);
+
+    // add the messages appended to a file since the index was loaded from the cache
+    bool indexAppended(QFile &f);
+
     // create index based on filters and apply plugins
     bool indexFilter(QStringList filenames);
     bool indexDefaultFilter();
 
+    // create the filter index from the sort by time keys
+    void sortIndexFilter();
+
+    // identity of the files for the filter match cache, empty if a file cannot be read
+    QByteArray md5FilterMatchCache(QStringList filenames);
+
+    // load/save index from/to file, a loaded index can cover only the beginning of a growing file
+    bool loadIndexCache(QFile &f, qint64 &indexedSize);
+    bool saveIndexCache(QFile &f, qint64 indexedSize);
+    QString filenameIndexCache(QString filename);
+    bool createFingerprint(QFile &f, qint64 size, DltFileIndexerFingerprint &fingerprint);
+
     // load/save filter index from/to file
-    bool loadFilterIndexCache(QDltFilterList &filterList, QVector<qint64> &index, QStringList filenames);
-    bool saveFilterIndexCache(QDltFilterList &filterList, QVector<qint64> index, QStringList filenames);
+    bool loadFilterIndexCache(QDltFilterList &filterList, QDltIndex &index, QStringList filenames);
+    bool saveFilterIndexCache(QDltFilterList &filterList, const QDltIndex &index, QStringList filenames);
     QString filenameFilterIndexCache(QDltFilterList &filterList, QStringList filenames);
-    QByteArray md5ActiveDecoderPlugins(); // generate hash value over all active decoder plugins
 
     // load/save index from/to file
-    bool loadIndexCache(QString filename);
-    bool saveIndexCache(QString filename);
-    QString filenameIndexCache(QString filename);
+    bool saveIndex(QString filename, const QDltIndex &index, const DltFileIndexerFingerprint &fingerprint);
+    bool loadIndex(QString filename, QDltIndex &index, DltFileIndexerFingerprint &fingerprint);
 
-    // load/save index from/to file
-    bool saveIndex(QString filename, const QVector<qint64> &index);
-    bool loadIndex(QString filename, QVector<qint64> &index);
+    // load/save header metadata from/to file
+    bool saveMetadata(QString filename, const QDltFileMetadata &metadata);
+    bool loadMetadata(QString filename, QDltFileMetadata &metadata);
 
     // Accessors to mutex
     void lock();
@@ -96,16 +147,17 @@ public:
     bool getMultithreaded() { return multithreaded; }
 
     // get and set filter cache
-    void setFilterCache(QString path) { filterCache = path; }
+    void setFilterCache(QString path) { filterCache = path; filterMatchCache.setCacheDirectory(path); }
     QString getFilterCache() { return filterCache; }
 
     // get index of all messages
-    QVector<qint64> getIndexAll() { return indexAllList; }
-    QVector<qint64> getIndexFilters() { return indexFilterList; }
-    QList<int> getGetLogInfoList() { return getLogInfoList; }
+    QDltIndex getIndexAll() { return indexAllList; }
+    QDltFileMetadata getMetadataAll() { return metadataAll; }
+    QDltIndex getIndexFilters() { return indexFilterList; }
+    QList<qint64> getGetLogInfoList() { return getLogInfoList; }
 
     // let worker thread append to getLogInfoList
-    void appendToGetLogInfoList(int value);
+    void appendToGetLogInfoList(qint64 value);
 
     // main thread routine
     void run();
@@ -138,14 +190,22 @@ private:
     QList<QDltPlugin*> activeDecoderPlugins;
 
     // full index
-    QVector<qint64> indexAllList;
+    QDltIndex indexAllList;
+
+    // header metadata of all messages in full index
+    QDltFileMetadata metadataAll;
 
     // filtered index
-    QVector<qint64> indexFilterList;
-    QMultiMap<DltFileIndexerKey,qint64> indexFilterListSorted;
+    QDltIndex indexFilterList;
+
+    // sort by time keys, not limited by the size of Qt containers
+    std::vector<DltFileIndexerKey> indexFilterListSorted;
+
+    // match results of single filters, to update the filter index when filters change
+    DltFilterMatchCache filterMatchCache;
 
     // getLogInfoList
-    QList<int> getLogInfoList;
+    QList<qint64> getLogInfoList;
 
     // some flags
     bool pluginsEnabled;
@@ -9,15 +9,20 @@ DltFileIndexerDefaultFilterThread::DltFileIndexerDefaultFilterThread
     : defaultFilter(defaultFilter),
       pluginManager(pluginManager),
       silentMode(silentMode),
-      msgQueue(1024)
+      msgQueue(8)
 {}
 
 DltFileIndexerDefaultFilterThread::~DltFileIndexerDefaultFilterThread()
 {}
 
-void DltFileIndexerDefaultFilterThread::enqueueMessage(const QSharedPointer<QDltMsg> &msg, int index)
+DltMsgBatch *DltFileIndexerDefaultFilterThread::getFreeBatch()
 {
-    msgQueue.enqueueMsg(msg, index);
+    return msgQueue.getFreeBatch();
+}
+
+void DltFileIndexerDefaultFilterThread::enqueueBatch(DltMsgBatch *batch)
+{
+    msgQueue.enqueueBatch(batch);
 }
 
 void DltFileIndexerDefaultFilterThread::requestStop()
@@ -27,19 +32,23 @@ void DltFileIndexerDefaultFilterThread::requestStop()
 
 void DltFileIndexerDefaultFilterThread::run()
 {
-    QPair<QSharedPointer<QDltMsg>, int> msgPair;
-
-    while(msgQueue.dequeue(msgPair))
-        processMessage(msgPair.first, msgPair.second);
+    DltMsgBatch *batch;
+
+    while(msgQueue.dequeue(batch))
+    {
+        for(int num = 0; num < batch->count; num++)
+            processMessage(batch->msgs[num], batch->indexes.at(num));
+        msgQueue.releaseBatch(batch);
+    }
 }
 
-void DltFileIndexerDefaultFilterThread::processMessage(QSharedPointer<QDltMsg> &msg, int index)
+void DltFileIndexerDefaultFilterThread::processMessage(QDltMsg &msg, qint64 index)
 {
     /* Process all decoderplugins */
-    pluginManager->decodeMsg(*msg, silentMode);
+    pluginManager->decodeMsg(msg, silentMode);
 
     /* run through all default filter */
     for(int num = 0; num < defaultFilter->defaultFilterList.size(); num++)
-        if(defaultFilter->defaultFilterList[num]->checkFilter(*msg)) // if filter matches message...
+        if(defaultFilter->defaultFilterList[num]->checkFilter(msg)) // if filter matches message...
             defaultFilter->defaultFilterIndex[num]->indexFilter.append(index); // ... add message to index cache
 }
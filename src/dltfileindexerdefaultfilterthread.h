@@ -11,9 +11,11 @@ class DltFileIndexerDefaultFilterThread :public QThread
 public:
     DltFileIndexerDefaultFilterThread(QDltDefaultFilter *defaultFilter, QDltPluginManager *pluginManager, bool silentMode);
     ~DltFileIndexerDefaultFilterThread();
-    void enqueueMessage(const QSharedPointer<QDltMsg> &msg, int index);
-    void processMessage(QSharedPointer<QDltMsg> &msg, int index);
+    DltMsgBatch *getFreeBatch();
+    void enqueueBatch(DltMsgBatch *batch);
+    void processMessage(QDltMsg &msg, qint64 index);
     void requestStop();
+    const DltMsgQueue &getMsgQueue() const { return msgQueue; }
 
 protected:
     void run();
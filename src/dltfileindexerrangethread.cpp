@@ -0,0 +1,54 @@
+#include "dltfileindexerrangethread.h"
+
+#include <QFile>
+#include <QDebug>
+
+DltFileIndexerRangeThread::DltFileIndexerRangeThread(QString filename, qint64 begin, qint64 end)
+    : filename(filename),
+      begin(begin),
+      end(end),
+      handoff(-1),
+      success(false),
+      stopRequested(false),
+      progress(0)
+{}
+
+DltFileIndexerRangeThread::~DltFileIndexerRangeThread()
+{}
+
+void DltFileIndexerRangeThread::requestStop()
+{
+    stopRequested = true;
+}
+
+void DltFileIndexerRangeThread::run()
+{
+    QFile f(filename);
+
+    // each range is read through its own file handle
+    if(!f.open(QIODevice::ReadOnly))
+    {
+        qWarning() << "Cannot open file in DltFileIndexerRangeThread " << f.errorString();
+        return;
+    }
+
+    // scan the range, messages starting behind the range are not added
+    QDltFileScanner scanner;
+    scanner.reset(begin, end);
+    while(scanner.scanFile(f, index, &metadata))
+    {
+        progress.ref();
+
+        /* stop if requested */
+        if(stopRequested)
+        {
+            f.close();
+            return;
+        }
+    }
+
+    f.close();
+
+    handoff = scanner.handoff();
+    success = true;
+}
@@ -0,0 +1,49 @@
+#ifndef DLTFILEINDEXERRANGETHREAD_H
+#define DLTFILEINDEXERRANGETHREAD_H
+
+#include "dltfileindexer.h"
+#include <QThread>
+#include <QAtomicInt>
+
+class DltFileIndexerRangeThread : public QThread
+{
+    Q_OBJECT
+public:
+    DltFileIndexerRangeThread(QString filename, qint64 begin, qint64 end);
+    ~DltFileIndexerRangeThread();
+
+    // index of all messages starting in the range
+    QDltIndex &getIndex() { return index; }
+
+    // header metadata of all messages in the index
+    QDltFileMetadata &getMetadata() { return metadata; }
+
+    // first message starting behind the range, -1 if none
+    qint64 getHandoff() const { return handoff; }
+
+    // false if the file could not be read or indexing was stopped
+    bool getSuccess() const { return success; }
+
+    // number of segments read so far
+    int getProgress() const { return progress.load(); }
+
+    void requestStop();
+
+protected:
+    void run();
+
+private:
+    QString filename;
+    qint64 begin;
+    qint64 end;
+
+    QDltIndex index;
+    QDltFileMetadata metadata;
+    qint64 handoff;
+    bool success;
+
+    volatile bool stopRequested;
+    QAtomicInt progress;
+};
+
+#endif // DLTFILEINDEXERRANGETHREAD_H
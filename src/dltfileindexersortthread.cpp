@@ -0,0 +1,16 @@
+#include "dltfileindexersortthread.h"
+
+#include <algorithm>
+
+DltFileIndexerSortThread::DltFileIndexerSortThread(DltFileIndexerKey *begin, DltFileIndexerKey *end)
+    : begin(begin),
+      end(end)
+{}
+
+DltFileIndexerSortThread::~DltFileIndexerSortThread()
+{}
+
+void DltFileIndexerSortThread::run()
+{
+    std::sort(begin, end);
+}
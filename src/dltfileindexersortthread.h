@@ -0,0 +1,23 @@
+#ifndef DLTFILEINDEXERSORTTHREAD_H
+#define DLTFILEINDEXERSORTTHREAD_H
+
+#include "dltfileindexer.h"
+#include <QThread>
+
+// Sorts one slice of the sort by time keys, in parallel to the other slices.
+class DltFileIndexerSortThread : public QThread
+{
+    Q_OBJECT
+public:
+    DltFileIndexerSortThread(DltFileIndexerKey *begin, DltFileIndexerKey *end);
+    ~DltFileIndexerSortThread();
+
+protected:
+    void run();
+
+private:
+    DltFileIndexerKey *begin;
+    DltFileIndexerKey *end;
+};
+
+#endif // DLTFILEINDEXERSORTTHREAD_H
@@ -7,23 +7,25 @@ DltFileIndexerThread::DltFileIndexerThread
 (
         DltFileIndexer *indexer,
         QDltFilterList *filterList,
+        DltFilterMatchCache *filterMatchCache,
         bool sortByTimeEnabled,
-        QVector<qint64> *indexFilterList,
-        QMultiMap<DltFileIndexerKey,qint64> *indexFilterListSorted,
+        QDltIndex *indexFilterList,
+        std::vector<DltFileIndexerKey> *indexFilterListSorted,
         QDltPluginManager *pluginManager,
         QList<QDltPlugin*> *activeViewerPlugins,
         bool silentMode
 )
     :indexer(indexer),
       filterList(filterList),
+      filterMatchCache(filterMatchCache),
       sortByTimeEnabled(sortByTimeEnabled),
       indexFilterList(indexFilterList),
       indexFilterListSorted(indexFilterListSorted),
       pluginManager(pluginManager),
       activeViewerPlugins(activeViewerPlugins),
-      silentMode(silentMode), msgQueue(1024)
+      silentMode(silentMode), msgQueue(8), nextWorker(0)
 {
-
+    matchFilters = filterList->getMatchFilters();
 }
 
 DltFileIndexerThread::~DltFileIndexerThread()
@@ -31,133 +33,209 @@ DltFileIndexerThread::~DltFileIndexerThread()
 
 }
 
-void DltFileIndexerThread::enqueueMessage(const QSharedPointer<QDltMsg> &msg, int index)
+DltMsgBatch *DltFileIndexerThread::getFreeBatch()
+{
+    if(!workerThreads.isEmpty())
+        return workerThreads[nextWorker]->getFreeBatch();
+
+    return msgQueue.getFreeBatch();
+}
+
+void DltFileIndexerThread::enqueueBatch(DltMsgBatch *batch)
 {
-    msgQueue.enqueueMsg(msg, index);
+    if(!workerThreads.isEmpty())
+    {
+        // the batch was taken from the same worker by getFreeBatch()
+        workerThreads[nextWorker]->enqueueBatch(batch);
+        nextWorker = (nextWorker + 1) % workerThreads.size();
+        return;
+    }
+
+    msgQueue.enqueueBatch(batch);
 }
 
 void DltFileIndexerThread::requestStop()
 {
+    if(!workerThreads.isEmpty())
+    {
+        for(int num = 0; num < workerThreads.size(); num++)
+            workerThreads[num]->requestStop();
+        return;
+    }
+
     msgQueue.enqueueStopRequest();
 }
 
 void DltFileIndexerThread::run()
 {
-    QPair<QSharedPointer<QDltMsg>, int> msgPair;
-    while(msgQueue.dequeue(msgPair))
-        processMessage(msgPair.first, msgPair.second);
+    DltMsgBatch *batch;
+
+    if(!workerThreads.isEmpty())
+    {
+        // take the batches in the same round robin order as they were passed to the workers,
+        // the first worker without further batches follows the last batch
+        int worker = 0;
+        while(workerThreads[worker]->takeProcessedBatch(batch))
+        {
+            for(int num = 0; num < batch->count; num++)
+                processResult(batch->msgs[num], batch->indexes.at(num), batch->results.at(num), batch->masks.at(num));
+            workerThreads[worker]->releaseBatch(batch);
+            worker = (worker + 1) % workerThreads.size();
+        }
+        return;
+    }
+
+    while(msgQueue.dequeue(batch))
+    {
+        for(int num = 0; num < batch->count; num++)
+            processMessage(batch->msgs[num], batch->indexes.at(num));
+        msgQueue.releaseBatch(batch);
+    }
 }
 
-void DltFileIndexerThread::processMessage(QSharedPointer<QDltMsg> &msg, int index)
+void DltFileIndexerThread::processMessage(QDltMsg &msg, qint64 index)
 {
     DltFileIndexer::IndexingMode mode = indexer->getMode();
     bool pluginsEnabled = indexer->getPluginsEnabled();
     QDltPlugin *item;
-    bool bool_result = false;
+
+    if(msg.getType() == QDltMsg::DltTypeControl &&
+       msg.getSubtype() == QDltMsg::DltControlResponse)
+        processControlResponse(msg);
+
+    /* Process all viewer plugins */
+    if((mode == DltFileIndexer::modeIndexAndFilter) && pluginsEnabled)
+    {
+        for(int ivp = 0; ivp < activeViewerPlugins->size(); ivp++)
+        {
+            item = (QDltPlugin *) activeViewerPlugins->at(ivp);
+            item->initMsg(index, msg);
+        }
+    }
+
+    /* Process all decoderplugins */
+    if ( pluginsEnabled == true )
+     {
+     (void) pluginManager->decodeMsg(msg, silentMode);
+     }
+
+    if(checkFilter(msg, index))
+        appendToIndex(msg, index);
+
+    /* Offer messages again to viewer plugins after decode */
+    if((mode == DltFileIndexer::modeIndexAndFilter) && pluginsEnabled)
+    {
+        for(int ivp = 0; ivp < activeViewerPlugins->size(); ivp++)
+        {
+            item = (QDltPlugin *) activeViewerPlugins->at(ivp);
+            item->initMsgDecoded(index, msg);
+        }
+    }
+
+    checkGetLogInfo(msg, index);
+}
+
+void DltFileIndexerThread::processResult(QDltMsg &msg, qint64 index, quint8 result, quint64 mask)
+{
+    /* message was decoded and filtered by a worker thread */
+    if(filterMatchCache)
+        filterMatchCache->store(index, mask);
+
+    if(result & DltMsgBatch::ResultControlResponse)
+        processControlResponse(msg);
+
+    if(result & DltMsgBatch::ResultMatch)
+        appendToIndex(msg, index);
+
+    checkGetLogInfo(msg, index);
+}
+
+bool DltFileIndexerThread::checkFilter(QDltMsg &msg, qint64 index)
+{
+    quint64 mask;
+
+    if(!filterMatchCache)
+        return filterList->checkFilter(msg);
+
+    QDltFilterInput input(msg);
+    filterList->prepareInput(input);
+
+    bool found = filterMatchCache->checkFilter(matchFilters, input, index, mask);
+    filterMatchCache->store(index, mask);
+
+    return found;
+}
+
+void DltFileIndexerThread::processControlResponse(QDltMsg &msg)
+{
+    if(indexer->getMode() != DltFileIndexer::modeIndexAndFilter)
+        return;
 
     /* check if it is a version messages and
     version string not already parsed */
-    if((mode == DltFileIndexer::modeIndexAndFilter) &&
-       msg->getType() == QDltMsg::DltTypeControl &&
-       msg->getSubtype() == QDltMsg::DltControlResponse &&
-       msg->getCtrlServiceId() == DLT_SERVICE_ID_GET_SOFTWARE_VERSION)
+    if(msg.getCtrlServiceId() == DLT_SERVICE_ID_GET_SOFTWARE_VERSION)
     {
-        QByteArray payload = msg->getPayload();
+        QByteArray payload = msg.getPayload();
         QByteArray data = payload.mid(9, (payload.size() > 262) ? 256 : (payload.size() - 9));
-        QString version = msg->toAscii(data,true);
+        QString version = msg.toAscii(data,true);
         version = version.trimmed(); // remove all white spaces at beginning and end
-        indexer->versionString(msg->getEcuid(),version);
+        indexer->versionString(msg.getEcuid(),version);
     }
 
     /* check if it is a timezone message */
-    if((mode == DltFileIndexer::modeIndexAndFilter) &&
-       msg->getType() == QDltMsg::DltTypeControl &&
-       msg->getSubtype() == QDltMsg::DltControlResponse &&
-       msg->getCtrlServiceId() == DLT_SERVICE_ID_TIMEZONE)
+    if(msg.getCtrlServiceId() == DLT_SERVICE_ID_TIMEZONE)
     {
-        QByteArray payload = msg->getPayload();
+        QByteArray payload = msg.getPayload();
         if(payload.size() == sizeof(DltServiceTimezone))
         {
             DltServiceTimezone *service;
             service = (DltServiceTimezone*) payload.constData();
 
-            if(msg->getEndianness() == QDltMsg::DltEndiannessLittleEndian)
+            if(msg.getEndianness() == QDltMsg::DltEndiannessLittleEndian)
                 indexer->timezone(service->timezone, service->isdst);
             else
                 indexer->timezone(DLT_SWAP_32(service->timezone), service->isdst);
         }
     }
 
-    /* check if it is a timezone message */
-    if((mode == DltFileIndexer::modeIndexAndFilter) &&
-       msg->getType()==QDltMsg::DltTypeControl &&
-       msg->getSubtype()==QDltMsg::DltControlResponse &&
-       msg->getCtrlServiceId() == DLT_SERVICE_ID_UNREGISTER_CONTEXT)
+    /* check if it is an unregister context message */
+    if(msg.getCtrlServiceId() == DLT_SERVICE_ID_UNREGISTER_CONTEXT)
     {
-        QByteArray payload = msg->getPayload();
+        QByteArray payload = msg.getPayload();
         if(payload.size() == sizeof(DltServiceUnregisterContext))
         {
             DltServiceUnregisterContext *service;
             service = (DltServiceUnregisterContext *) payload.constData();
 
-            indexer->unregisterContext(msg->getEcuid(), QString(QByteArray(service->apid, 4)), QString(QByteArray(service->ctid, 4)));
-        }
-    }
-
-    /* Process all viewer plugins */
-    if((mode == DltFileIndexer::modeIndexAndFilter) && pluginsEnabled)
-    {
-        for(int ivp = 0; ivp < activeViewerPlugins->size(); ivp++)
-        {
-            item = (QDltPlugin *) activeViewerPlugins->at(ivp);
-            item->initMsg(index, *msg);
+            indexer->unregisterContext(msg.getEcuid(), QString(QByteArray(service->apid, 4)), QString(QByteArray(service->ctid, 4)));
         }
     }
+}
 
-    /* Process all decoderplugins */
-    if ( pluginsEnabled == true )
-     {
-     (void) pluginManager->decodeMsg(*msg, silentMode);
-     }
-
-
-    bool_result = filterList->checkFilter(*msg);
-    if ( bool_result == true)
-    {
-        if(sortByTimeEnabled)
-         {
-            indexFilterListSorted->insert(DltFileIndexerKey(msg->getTime(), msg->getMicroseconds()), index);
-         }
-        else
-         {
-            indexFilterList->append(index);
-         }
-    }
-
-    /* Offer messages again to viewer plugins after decode */
-    if((mode == DltFileIndexer::modeIndexAndFilter) && pluginsEnabled)
-    {
-        for(int ivp = 0; ivp < activeViewerPlugins->size(); ivp++)
-        {
-            item = (QDltPlugin *) activeViewerPlugins->at(ivp);
-            item->initMsgDecoded(index, *msg);
-        }
-    }
+void DltFileIndexerThread::appendToIndex(QDltMsg &msg, qint64 index)
+{
+    if(sortByTimeEnabled)
+        indexFilterListSorted->push_back(DltFileIndexerKey(msg.getTime(), msg.getMicroseconds(), index));
+    else
+        indexFilterList->append(index);
+}
 
+void DltFileIndexerThread::checkGetLogInfo(QDltMsg &msg, qint64 index)
+{
     /* update context configuration when loading file */
-    if((mode == DltFileIndexer::modeIndexAndFilter) &&
-        msg->getType() == QDltMsg::DltTypeControl &&
-        msg->getSubtype() == QDltMsg::DltControlResponse)
+    if((indexer->getMode() == DltFileIndexer::modeIndexAndFilter) &&
+        msg.getType() == QDltMsg::DltTypeControl &&
+        msg.getSubtype() == QDltMsg::DltControlResponse)
     {
         const char *ptr;
         int32_t length;
         uint32_t service_id=0, service_id_tmp=0;
 
-        QByteArray payload = msg->getPayload();
+        QByteArray payload = msg.getPayload();
         ptr = payload.constData();
         length = payload.size();
         DLT_MSG_READ_VALUE(service_id_tmp,ptr, length, uint32_t);
-        service_id=DLT_ENDIAN_GET_32(((msg->getEndianness() == QDltMsg::DltEndiannessBigEndian) ? DLT_HTYP_MSBF:0), service_id_tmp);
+        service_id=DLT_ENDIAN_GET_32(((msg.getEndianness() == QDltMsg::DltEndiannessBigEndian) ? DLT_HTYP_MSBF:0), service_id_tmp);
 
         if(service_id == DLT_SERVICE_ID_GET_LOG_INFO)
         {
@@ -3,34 +3,55 @@
 
 #include "dltfileindexer.h"
 #include "dltmsgqueue.h"
+#include "dltfileindexerworkerthread.h"
 #include <QThread>
 
 class DltFileIndexerThread :public QThread
 {
     Q_OBJECT
 public:
-    DltFileIndexerThread(DltFileIndexer *indexer, QDltFilterList *filterList, bool sortByTimeEnabled, QVector<qint64> *indexFilterList, QMultiMap<DltFileIndexerKey,qint64> *indexFilterListSorted, QDltPluginManager *pluginManager, QList<QDltPlugin*> *activeViewerPlugins, bool silentMode);
+    DltFileIndexerThread(DltFileIndexer *indexer, QDltFilterList *filterList, DltFilterMatchCache *filterMatchCache, bool sortByTimeEnabled, QDltIndex *indexFilterList, std::vector<DltFileIndexerKey> *indexFilterListSorted, QDltPluginManager *pluginManager, QList<QDltPlugin*> *activeViewerPlugins, bool silentMode);
     ~DltFileIndexerThread();
-    void enqueueMessage(const QSharedPointer<QDltMsg> &msg, int index);
-    void processMessage(QSharedPointer<QDltMsg> &msg, int index);
+    DltMsgBatch *getFreeBatch();
+    void enqueueBatch(DltMsgBatch *batch);
+    void processMessage(QDltMsg &msg, qint64 index);
     void requestStop();
+    const DltMsgQueue &getMsgQueue() const { return msgQueue; }
+
+    // Batches are decoded and filtered round robin by the worker threads,
+    // this thread only processes their results in the order of the messages.
+    void setWorkerThreads(const QList<DltFileIndexerWorkerThread*> &workers) { workerThreads = workers; }
 
 protected:
     void run();
 
 private:
+    void processResult(QDltMsg &msg, qint64 index, quint8 result, quint64 mask);
+    bool checkFilter(QDltMsg &msg, qint64 index);
+    void processControlResponse(QDltMsg &msg);
+    void appendToIndex(QDltMsg &msg, qint64 index);
+    void checkGetLogInfo(QDltMsg &msg, qint64 index);
+
     DltFileIndexer *indexer;
     QDltFilterList *filterList;
+    QList<QDltFilter*> matchFilters;
+
+    // known results of single filters, 0 if not used
+    DltFilterMatchCache *filterMatchCache;
+
     bool sortByTimeEnabled;
 
-    QVector<qint64> *indexFilterList;
-    QMultiMap<DltFileIndexerKey,qint64> *indexFilterListSorted;
+    QDltIndex *indexFilterList;
+    std::vector<DltFileIndexerKey> *indexFilterListSorted;
 
     QDltPluginManager *pluginManager;
     QList<QDltPlugin*> *activeViewerPlugins;
     bool silentMode;
 
     DltMsgQueue msgQueue;
+
+    QList<DltFileIndexerWorkerThread*> workerThreads;
+    int nextWorker;
 };
 
 #endif // DLTFILEINDEXERTHREAD_H
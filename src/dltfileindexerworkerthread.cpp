@@ -0,0 +1,97 @@
+#include "dltfileindexerworkerthread.h"
+
+#define DLT_WORKER_BATCHES 8
+
+DltFileIndexerWorkerThread::DltFileIndexerWorkerThread
+(
+        const QDltFilterList &filterList,
+        const DltFilterMatchCache *filterMatchCache,
+        QDltPluginManager *pluginManager,
+        bool pluginsEnabled,
+        bool silentMode
+)
+    : filterList(filterList),
+      filterMatchCache(filterMatchCache),
+      pluginManager(pluginManager),
+      pluginsEnabled(pluginsEnabled),
+      silentMode(silentMode),
+      msgQueue(DLT_WORKER_BATCHES),
+      processedBatches(DLT_WORKER_BATCHES)
+{
+    matchFilters = this->filterList.getMatchFilters();
+}
+
+DltFileIndexerWorkerThread::~DltFileIndexerWorkerThread()
+{}
+
+DltMsgBatch *DltFileIndexerWorkerThread::getFreeBatch()
+{
+    return msgQueue.getFreeBatch();
+}
+
+void DltFileIndexerWorkerThread::enqueueBatch(DltMsgBatch *batch)
+{
+    msgQueue.enqueueBatch(batch);
+}
+
+void DltFileIndexerWorkerThread::requestStop()
+{
+    msgQueue.enqueueStopRequest();
+}
+
+bool DltFileIndexerWorkerThread::takeProcessedBatch(DltMsgBatch *&batch)
+{
+    return processedBatches.take(batch);
+}
+
+void DltFileIndexerWorkerThread::releaseBatch(DltMsgBatch *batch)
+{
+    msgQueue.releaseBatch(batch);
+}
+
+void DltFileIndexerWorkerThread::run()
+{
+    DltMsgBatch *batch;
+
+    while(msgQueue.dequeue(batch))
+    {
+        processBatch(batch);
+
+        // never blocks, the queue can hold all batches of this worker
+        processedBatches.put(batch);
+    }
+
+    processedBatches.requestStop();
+}
+
+void DltFileIndexerWorkerThread::processBatch(DltMsgBatch *batch)
+{
+    for(int num = 0; num < batch->count; num++)
+    {
+        QDltMsg &msg = batch->msgs[num];
+        quint8 result = 0;
+
+        /* control responses are checked before the message is decoded */
+        if(msg.getType() == QDltMsg::DltTypeControl &&
+           msg.getSubtype() == QDltMsg::DltControlResponse)
+            result |= DltMsgBatch::ResultControlResponse;
+
+        /* Process all decoderplugins */
+        if(pluginsEnabled)
+            (void) pluginManager->decodeMsg(msg, silentMode);
+
+        if(filterMatchCache)
+        {
+            QDltFilterInput input(msg);
+            filterList.prepareInput(input);
+            if(filterMatchCache->checkFilter(matchFilters, input, batch->indexes.at(num), batch->masks[num]))
+                result |= DltMsgBatch::ResultMatch;
+        }
+        else if(filterList.checkFilter(msg))
+        {
+            result |= DltMsgBatch::ResultMatch;
+        }
+
+        batch->results[num] = result;
+    }
+}
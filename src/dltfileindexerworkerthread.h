@@ -0,0 +1,50 @@
+#ifndef DLTFILEINDEXERWORKERTHREAD_H
+#define DLTFILEINDEXERWORKERTHREAD_H
+
+#include "dltfileindexer.h"
+#include "dltmsgqueue.h"
+#include "dltblockingqueue.h"
+#include "dltfiltermatchcache.h"
+#include <QThread>
+
+// Decodes and filters message batches in parallel to other worker threads.
+// The results are stored in the batches, which are passed in the same order
+// to the sequencing thread. The sequencing thread gives them back with releaseBatch().
+class DltFileIndexerWorkerThread : public QThread
+{
+    Q_OBJECT
+public:
+    DltFileIndexerWorkerThread(const QDltFilterList &filterList, const DltFilterMatchCache *filterMatchCache, QDltPluginManager *pluginManager, bool pluginsEnabled, bool silentMode);
+    ~DltFileIndexerWorkerThread();
+    DltMsgBatch *getFreeBatch();
+    void enqueueBatch(DltMsgBatch *batch);
+    void requestStop();
+
+    // false if the worker is stopped and all processed batches are taken
+    bool takeProcessedBatch(DltMsgBatch *&batch);
+    void releaseBatch(DltMsgBatch *batch);
+
+    const DltMsgQueue &getMsgQueue() const { return msgQueue; }
+
+protected:
+    void run();
+
+private:
+    void processBatch(DltMsgBatch *batch);
+
+    // each worker matches with its own copy of the filters
+    QDltFilterList filterList;
+    QList<QDltFilter*> matchFilters;
+
+    // known results of single filters, 0 if not used
+    const DltFilterMatchCache *filterMatchCache;
+
+    QDltPluginManager *pluginManager;
+    bool pluginsEnabled;
+    bool silentMode;
+
+    DltMsgQueue msgQueue;
+    DltBlockingQueue<DltMsgBatch*> processedBatches;
+};
+
+#endif // DLTFILEINDEXERWORKERTHREAD_H
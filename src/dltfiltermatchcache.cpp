@@ -0,0 +1,297 @@
+#include "dltfiltermatchcache.h"
+
+#include <QFile>
+#include <QCryptographicHash>
+
+DltFilterMatchCache::DltFilterMatchCache()
+    : size(0),
+      validKnown(false),
+      validPending(false),
+      prepared(false),
+      positiveFilters(0)
+{}
+
+void DltFilterMatchCache::clear()
+{
+    abort();
+    matches.clear();
+    identity.clear();
+    size = 0;
+    valid.clear();
+    validKnown = false;
+}
+
+void DltFilterMatchCache::validate(const QByteArray &identity, qint64 size)
+{
+    if(identity == this->identity && size == this->size)
+        return;
+
+    // results depend on the decoded messages
+    clear();
+    this->identity = identity;
+    this->size = size;
+}
+
+bool DltFilterMatchCache::prepare(const QDltFilterList &filterList)
+{
+    QList<QDltFilter*> filters = filterList.getMatchFilters();
+
+    abort();
+
+    // messages which cannot be read are found in the first pass, or are known from the cache file
+    if(!validKnown && load(cacheFilename(QByteArray()), valid))
+        validKnown = true;
+
+    positiveFilters = filterList.getPositiveFilterCount();
+    filterResults.resize(filters.size());
+    for(int num = 0; num < filters.size(); num++)
+    {
+        FilterResult &result = filterResults[num];
+        result.key = filters[num]->matchKey();
+        result.matches = 0;
+        result.pending = -1;
+
+        if(matches.contains(result.key))
+            continue;
+
+        // results of filters used before with the same files
+        QDltBitmap bitmap;
+        if(validKnown && load(cacheFilename(result.key), bitmap))
+        {
+            matches.insert(result.key, bitmap);
+            continue;
+        }
+
+        // filters with the same criteria are evaluated once
+        result.pending = pendingKeys.indexOf(result.key);
+        if(result.pending < 0)
+        {
+            if(pendingKeys.size() == maxPendingFilters)
+            {
+                abort();
+                return false;
+            }
+            result.pending = pendingKeys.size();
+            pendingKeys.append(result.key);
+            pendingMatches.append(QDltBitmap());
+        }
+    }
+
+    // the hash is not changed anymore until finish()
+    for(int num = 0; num < filterResults.size(); num++)
+        if(filterResults.at(num).pending < 0)
+            filterResults[num].matches = &matches.constFind(filterResults.at(num).key).value();
+
+    if(!validKnown)
+    {
+        valid.clear();
+        validPending = true;
+    }
+
+    prepared = true;
+    return true;
+}
+
+bool DltFilterMatchCache::isComplete() const
+{
+    return prepared && validKnown && pendingKeys.isEmpty();
+}
+
+template <typename Input>
+bool DltFilterMatchCache::checkFilterInput(const QList<QDltFilter*> &filters, Input &input, qint64 index, quint64 &mask) const
+{
+    bool positive = (positiveFilters == 0);
+    bool negative = false;
+
+    mask = 0;
+
+    // pending filters are evaluated for all messages, even if the result is already clear
+    for(int num = 0; num < filterResults.size(); num++)
+    {
+        const FilterResult &result = filterResults.at(num);
+        bool found;
+
+        if(result.pending >= 0)
+        {
+            found = filters.at(num)->match(input);
+            if(found)
+                mask |= Q_UINT64_C(1) << result.pending;
+        }
+        else
+        {
+            found = result.matches->contains(index);
+        }
+
+        if(found)
+        {
+            if(num < positiveFilters)
+                positive = true;
+            else
+                negative = true;
+        }
+    }
+
+    return positive && !negative;
+}
+
+bool DltFilterMatchCache::checkFilter(const QList<QDltFilter*> &filters, QDltFilterInput &input, qint64 index, quint64 &mask) const
+{
+    return checkFilterInput(filters, input, index, mask);
+}
+
+bool DltFilterMatchCache::checkFilter(const QList<QDltFilter*> &filters, const QDltMsgMetadata &metadata, qint64 index, quint64 &mask) const
+{
+    return checkFilterInput(filters, metadata, index, mask);
+}
+
+void DltFilterMatchCache::store(qint64 index, quint64 mask)
+{
+    if(validPending)
+        valid.add(index);
+
+    for(int bit = 0; mask; bit++, mask >>= 1)
+        if(mask & 1)
+            pendingMatches[bit].add(index);
+}
+
+void DltFilterMatchCache::finish()
+{
+    if(!prepared)
+        return;
+
+    if(validPending)
+    {
+        save(cacheFilename(QByteArray()), valid);
+        validKnown = true;
+        validPending = false;
+    }
+
+    for(int num = 0; num < pendingKeys.size(); num++)
+    {
+        save(cacheFilename(pendingKeys.at(num)), pendingMatches.at(num));
+        matches.insert(pendingKeys.at(num), pendingMatches.at(num));
+    }
+    pendingKeys.clear();
+    pendingMatches.clear();
+
+    // keep the results of the current filters and drop others, if there are too many
+    if(matches.size() > DLT_FILTER_MATCH_CACHE_SIZE)
+    {
+        QHash<QByteArray,QDltBitmap> current;
+        for(int num = 0; num < filterResults.size(); num++)
+            current.insert(filterResults.at(num).key, matches.value(filterResults.at(num).key));
+        matches = current;
+    }
+
+    for(int num = 0; num < filterResults.size(); num++)
+    {
+        filterResults[num].matches = &matches.constFind(filterResults.at(num).key).value();
+        filterResults[num].pending = -1;
+    }
+}
+
+void DltFilterMatchCache::abort()
+{
+    prepared = false;
+    filterResults.clear();
+    pendingKeys.clear();
+    pendingMatches.clear();
+
+    if(validPending)
+    {
+        valid.clear();
+        validPending = false;
+    }
+}
+
+void DltFilterMatchCache::createIndex(QDltIndex &index) const
+{
+    QDltBitmap visible;
+
+    // same semantics as QDltFilterList::checkFilter()
+    if(positiveFilters > 0)
+    {
+        for(int num = 0; num < positiveFilters; num++)
+            visible.unite(*filterResults.at(num).matches);
+    }
+    else
+    {
+        visible = valid;
+    }
+
+    for(int num = positiveFilters; num < filterResults.size(); num++)
+        visible.subtract(*filterResults.at(num).matches);
+
+    index.clear();
+    visible.appendTo(index);
+}
+
+QString DltFilterMatchCache::cacheFilename(const QByteArray &key) const
+{
+    if(directory.isEmpty() || identity.isEmpty())
+        return QString();
+
+    // an empty key is used for the valid messages
+    if(key.isEmpty())
+        return directory + "/" + QString(identity.toHex()) + "_valid.dfm";
+
+    return directory + "/" + QString(identity.toHex()) + "_" +
+            QString(QCryptographicHash::hash(key, QCryptographicHash::Md5).toHex()) + ".dfm";
+}
+
+bool DltFilterMatchCache::load(const QString &filename, QDltBitmap &bitmap) const
+{
+    quint32 version;
+    qint64 count;
+
+    if(filename.isEmpty())
+        return false;
+
+    QFile file(filename);
+
+    // open cache file
+    if(!file.open(QFile::ReadOnly))
+        return false;
+
+    // compare version and number of messages
+    if(file.read((char*)&version,sizeof(version)) != sizeof(version) || version != DLT_FILTER_MATCH_CACHE_VERSION ||
+       file.read((char*)&count,sizeof(count)) != sizeof(count) || count != size ||
+       !bitmap.read(file))
+    {
+        bitmap.clear();
+        file.close();
+        return false;
+    }
+
+    file.close();
+
+    return true;
+}
+
+bool DltFilterMatchCache::save(const QString &filename, const QDltBitmap &bitmap) const
+{
+    quint32 version = DLT_FILTER_MATCH_CACHE_VERSION;
+
+    if(filename.isEmpty())
+        return false;
+
+    QFile file(filename);
+
+    // open cache file
+    if(!file.open(QFile::WriteOnly))
+        return false;
+
+    // write version, number of messages and the bitmap
+    if(file.write((char*)&version,sizeof(version)) != sizeof(version) ||
+       file.write((char*)&size,sizeof(size)) != sizeof(size) ||
+       !bitmap.write(file))
+    {
+        file.close();
+        file.remove();
+        return false;
+    }
+
+    file.close();
+
+    return true;
+}
@@ -0,0 +1,102 @@
+#ifndef DLTFILTERMATCHCACHE_H
+#define DLTFILTERMATCHCACHE_H
+
+#include <QHash>
+#include <QList>
+#include <QVector>
+#include <QString>
+#include <QByteArray>
+
+#include "qdlt.h"
+
+#define DLT_FILTER_MATCH_CACHE_SIZE 32
+#define DLT_FILTER_MATCH_CACHE_VERSION 1
+
+// Match results of single positive and negative filters for all messages of
+// the opened files. When filters are added, removed, enabled or disabled, only
+// the filters which are not known yet are evaluated while the messages are read.
+// If all filters are known, the filter index is created without reading any message.
+// The results are stored as compressed bitmaps, one per filter, and are kept in
+// the cache directory, so they are also used after the files are opened again.
+class DltFilterMatchCache
+{
+public:
+    // Number of filters which can be evaluated while reading the messages once
+    static const int maxPendingFilters = 64;
+
+    DltFilterMatchCache();
+
+    void clear();
+
+    // Directory of the cache files, results are kept in memory only if empty
+    void setCacheDirectory(const QString &directory) { this->directory = directory; }
+
+    // Drop the results, if they were created for other files or with other decoder plugins.
+    // The identity is a hash of the file names, the content fingerprints of the indexed part of the files and the active decoder plugins.
+    void validate(const QByteArray &identity, qint64 size);
+
+    // Prepare filtering with the filters of a filter list.
+    // Returns false if the results cannot be cached, e.g. too many unknown filters.
+    bool prepare(const QDltFilterList &filterList);
+
+    // true if all filters of the prepared list and all valid messages are known
+    bool isComplete() const;
+
+    // Same result as QDltFilterList::checkFilter(), the filters are the match filters
+    // of a copy of the prepared filter list, which also prepared the input.
+    // The bits of mask are set for matching pending filters.
+    // Can be called from several threads at once.
+    bool checkFilter(const QList<QDltFilter*> &filters, QDltFilterInput &input, qint64 index, quint64 &mask) const;
+
+    // Same as above with the header metadata of a message, if all filters check header fields only
+    bool checkFilter(const QList<QDltFilter*> &filters, const QDltMsgMetadata &metadata, qint64 index, quint64 &mask) const;
+
+    // Store the results of a valid message, must be called for the messages in order
+    void store(qint64 index, quint64 mask);
+
+    // Keep the results of the pending filters after all messages were read
+    void finish();
+
+    // Drop the results of the pending filters
+    void abort();
+
+    // Create the filter index from the known results
+    void createIndex(QDltIndex &index) const;
+
+private:
+    // Result of one match filter, either known or pending
+    class FilterResult
+    {
+    public:
+        FilterResult() : matches(0), pending(-1) {}
+        QByteArray key;
+        const QDltBitmap *matches;
+        int pending;
+    };
+
+    template <typename Input>
+    bool checkFilterInput(const QList<QDltFilter*> &filters, Input &input, qint64 index, quint64 &mask) const;
+
+    QString cacheFilename(const QByteArray &key) const;
+    bool load(const QString &filename, QDltBitmap &bitmap) const;
+    bool save(const QString &filename, const QDltBitmap &bitmap) const;
+
+    QHash<QByteArray,QDltBitmap> matches;
+    QByteArray identity;
+    qint64 size;
+    QString directory;
+
+    // messages which could be read
+    QDltBitmap valid;
+    bool validKnown;
+    bool validPending;
+
+    // prepared filter list
+    bool prepared;
+    QVector<FilterResult> filterResults;
+    int positiveFilters;
+    QList<QByteArray> pendingKeys;
+    QVector<QDltBitmap> pendingMatches;
+};
+
+#endif // DLTFILTERMATCHCACHE_H
@@ -1,66 +1,47 @@
 #include "dltmsgqueue.h"
-#include <QThread>
 
-DltMsgQueue::DltMsgQueue(int size)
-    : bufferSize(size),
-      readPosition(0),
-      writePosition(0),
-      stopRequested(false),
-      writeSleepTime(0),
-      readSleepTime(0),
-      buffer(new QPair<QSharedPointer<QDltMsg>, int> [size])
-{}
+DltMsgQueue::DltMsgQueue(int numberOfBatches)
+    : batches(new DltMsgBatch [numberOfBatches]),
+      filledBatches(numberOfBatches),
+      freeBatches(numberOfBatches)
+{
+    // all batches are free at the beginning
+    for(int num = 0; num < numberOfBatches; num++)
+        freeBatches.put(&batches[num]);
+}
 
 DltMsgQueue::~DltMsgQueue()
 {
-    if(buffer != nullptr)
-        delete[] buffer;
+    delete[] batches;
 }
 
-void DltMsgQueue::enqueueMsg(const QSharedPointer<QDltMsg> &msg, int index)
+DltMsgBatch *DltMsgQueue::getFreeBatch()
 {
-    int nextWritePosition = (writePosition.load() + 1) % bufferSize;
-
-    while(nextWritePosition == readPosition.load()) // buffer full?
-    {
-        if(writeSleepTime > 0)
-            QThread::currentThread()->usleep(writeSleepTime);
-
-        writeSleepTime = qMin(writeSleepTime + sleepTimeSteps, maxSleepTime);
-    }
+    DltMsgBatch *batch;
 
-    writeSleepTime = qMax(writeSleepTime - sleepTimeSteps, 0);
+    // the free list is never stopped, all batches are returned by the consumers
+    freeBatches.take(batch);
+    batch->count = 0;
 
-    buffer[writePosition.load()].first = msg;
-    buffer[writePosition.load()].second = index;
-
-    writePosition.store(nextWritePosition);
+    return batch;
 }
 
-bool DltMsgQueue::dequeue(QPair<QSharedPointer<QDltMsg>, int> &dequeuedData)
+void DltMsgQueue::enqueueBatch(DltMsgBatch *batch)
 {
-    while(readPosition.load() == writePosition.load()) // buffer empty?
-    {
-        if(stopRequested)
-            return false;
-
-        if(readSleepTime > 0)
-            QThread::currentThread()->usleep(readSleepTime);
-
-        readSleepTime = qMin(readSleepTime + sleepTimeSteps, maxSleepTime);
-    }
-
-    readSleepTime = qMax(readSleepTime - sleepTimeSteps, 0);
-
-    dequeuedData = buffer[readPosition.load()];
+    filledBatches.put(batch);
+}
 
-    readPosition.store((readPosition.load() + 1) % bufferSize);
+bool DltMsgQueue::dequeue(DltMsgBatch *&batch)
+{
+    return filledBatches.take(batch);
+}
 
-    return true;
+void DltMsgQueue::releaseBatch(DltMsgBatch *batch)
+{
+    freeBatches.put(batch);
 }
 
 void DltMsgQueue::enqueueStopRequest()
 {
-    stopRequested = true;
+    filledBatches.requestStop();
 }
-
@@ -1,29 +1,55 @@
 #ifndef DLTMSGQUEUE_H
 #define DLTMSGQUEUE_H
 
-#include <QSemaphore>
-#include <QSharedPointer>
+#include <QVector>
 #include "qdlt.h"
+#include "dltblockingqueue.h"
 
+#define DLT_MSG_BATCH_SIZE 256
+
+// Messages passed at once from the reading thread to a worker thread.
+// The messages are reused for the next batch, so they are allocated only once.
+class DltMsgBatch
+{
+public:
+    // Flags set by a worker thread for each message
+    enum Result { ResultMatch = 0x01, ResultControlResponse = 0x02 };
+
+    DltMsgBatch() : msgs(DLT_MSG_BATCH_SIZE), indexes(DLT_MSG_BATCH_SIZE), results(DLT_MSG_BATCH_SIZE), masks(DLT_MSG_BATCH_SIZE), count(0) {}
+
+    bool isFull() const { return count == DLT_MSG_BATCH_SIZE; }
+
+    QVector<QDltMsg> msgs;
+    QVector<qint64> indexes;
+    QVector<quint8> results;
+    QVector<quint64> masks;
+    int count;
+};
+
+// Queue of message batches between the reading thread and the worker threads.
+// The queue owns a fixed pool of batches, producers take free batches
+// with getFreeBatch() and consumers give them back with releaseBatch().
+// Waiting threads are blocked, not polling.
 class DltMsgQueue
 {
 public:
-    DltMsgQueue(int bufferSize);
+    DltMsgQueue(int numberOfBatches);
     ~DltMsgQueue();
-    void enqueueMsg(const QSharedPointer<QDltMsg> &msg, int index);
-    bool dequeue(QPair<QSharedPointer<QDltMsg>, int> &dequeuedData);
+    DltMsgBatch *getFreeBatch();
+    void enqueueBatch(DltMsgBatch *batch);
+    bool dequeue(DltMsgBatch *&batch);
+    void releaseBatch(DltMsgBatch *batch);
     void enqueueStopRequest();
 
+    // Counters of the filled batches queue
+    int getMaxDepth() const { return filledBatches.getMaxSize(); }
+    qint64 getProducerStallMsecs() const { return (filledBatches.getPutStallNsecs() + freeBatches.getTakeStallNsecs()) / 1000000; }
+    qint64 getConsumerStallMsecs() const { return filledBatches.getTakeStallNsecs() / 1000000; }
+
 private:
-    int bufferSize;
-    QPair<QSharedPointer<QDltMsg>, int> *buffer;
-    QAtomicInt readPosition, writePosition;
-    volatile bool stopRequested;
-    int writeSleepTime; // Microseconds to sleep if buffer is full during a write attempt
-    int readSleepTime; // Microseconds to sleep if buffer is empty during a read attempt
-
-    const int maxSleepTime = 1000 * 10;
-    const int sleepTimeSteps = 10;
+    DltMsgBatch *batches;
+    DltBlockingQueue<DltMsgBatch*> filledBatches;
+    DltBlockingQueue<DltMsgBatch*> freeBatches;
 };
 
 #endif // DLTMSGQUEUE_H
@@ -0,0 +1,145 @@
+#include "dltreceiver.h"
+
+#if defined(_MSC_VER)
+#include <time.h>
+#else
+#include <sys/time.h>	/* for gettimeofday() */
+#endif
+
+extern "C"
+{
+#include "dlt_common.h"
+}
+
+DltReceiver::DltReceiver(QObject *parent)
+    : QThread(parent),
+      batchQueue(DLT_RECEIVER_BATCHES),
+      notified(0)
+{
+}
+
+DltReceiver::~DltReceiver()
+{
+    // connections deleted before are deleted when the thread finishes
+    requestStop();
+    wait();
+}
+
+DltReceiverConnection *DltReceiver::createConnection()
+{
+    DltReceiverConnection *connection = new DltReceiverConnection(this);
+    connection->moveToThread(this);
+    return connection;
+}
+
+bool DltReceiver::takeBatch(DltReceivedBatch &batch)
+{
+    if(batchQueue.tryTake(batch))
+        return true;
+
+    // notify again for the next batch, a batch passed in between is taken now
+    notified.fetchAndStoreOrdered(0);
+
+    return batchQueue.tryTake(batch);
+}
+
+void DltReceiver::requestStop()
+{
+    batchQueue.requestStop();
+    quit();
+}
+
+void DltReceiver::run()
+{
+    // the connections read the data in the event loop of this thread
+    exec();
+}
+
+void DltReceiver::parseData(DltReceiverConnection *connection, const QByteArray &data)
+{
+    QList<DltReceivedBatch> batches;
+    QDltMsg qmsg;
+
+    // the messages get the time when the data was read
+#if defined(_MSC_VER)
+    time_t today;
+    time(&today);
+    quint32 seconds = (quint32)today;
+    qint32 microseconds = 0;
+#else
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    quint32 seconds = (quint32)tv.tv_sec;
+    qint32 microseconds = (qint32)tv.tv_usec;
+#endif
+
+    batches.append(DltReceivedBatch());
+    batches.last().connectionBytes.insert(connection, data.size());
+
+    connection->parser.add(data);
+
+    while(connection->parser.parse(qmsg))
+    {
+        if(batches.last().size() >= DLT_RECEIVER_BATCH_SIZE)
+            batches.append(DltReceivedBatch());
+        DltReceivedBatch &batch = batches.last();
+
+        DltStorageHeader str;
+        str.pattern[0]='D';
+        str.pattern[1]='L';
+        str.pattern[2]='T';
+        str.pattern[3]=0x01;
+        str.seconds = seconds;
+        str.microseconds = microseconds;
+        str.ecu[0]=0;
+        str.ecu[1]=0;
+        str.ecu[2]=0;
+        str.ecu[3]=0;
+
+        /* prepare storage header */
+        if (!qmsg.getEcuidId().isEmpty())
+            dlt_set_id(str.ecu,qmsg.getEcuid().toLatin1());
+        else
+            dlt_set_id(str.ecu,connection->ecuId.toString().toLatin1());
+
+        quint8 flags = 0;
+        if(qmsg.getType() == QDltMsg::DltTypeControl)
+        {
+            flags |= DltReceivedBatch::FlagControl;
+            if(qmsg.getSubtype() == QDltMsg::DltControlResponse)
+                flags |= DltReceivedBatch::FlagControlResponse;
+        }
+
+        batch.offsets.append(batch.data.size());
+        batch.data.append((const char*)&str, sizeof(DltStorageHeader));
+        batch.data.append(qmsg.getHeader());
+        batch.data.append(qmsg.getPayload());
+        batch.flags.append(flags);
+        batch.connections.append(connection);
+    }
+
+    DltReceivedBatch &batch = batches.last();
+    batch.bytesError += connection->parser.bytesError;
+    connection->parser.bytesError = 0;
+    batch.bytesReceived += connection->parser.bytesReceived;
+    connection->parser.bytesReceived = 0;
+    batch.syncFound += connection->parser.syncFound;
+    connection->parser.syncFound = 0;
+
+    // waits while the GUI thread is behind, no more data is read until then
+    for(int num = 0; num < batches.size(); num++)
+    {
+        if(!batches.at(num).isEmpty())
+            publish(batches.at(num));
+    }
+}
+
+void DltReceiver::publish(const DltReceivedBatch &batch)
+{
+    if(!batchQueue.put(batch))
+        return;
+
+    // one notification until the GUI thread has taken all batches
+    if(notified.testAndSetOrdered(0, 1))
+        emit dataAvailable();
+}
@@ -0,0 +1,94 @@
+#ifndef DLTRECEIVER_H
+#define DLTRECEIVER_H
+
+#include <QThread>
+#include <QAtomicInt>
+#include <QHash>
+#include <QVector>
+#include <QByteArray>
+#include "qdlt.h"
+#include "dltblockingqueue.h"
+#include "dltreceiverconnection.h"
+
+#define DLT_RECEIVER_BATCH_SIZE 1024
+#define DLT_RECEIVER_BATCHES 64
+
+// Messages received from the ECUs and parsed by the receive thread.
+// Each message is stored as it is written to the log file, with its storage header.
+class DltReceivedBatch
+{
+public:
+    // Flags of each message
+    enum Flag { FlagControl = 0x01, FlagControlResponse = 0x02 };
+
+    DltReceivedBatch() : bytesError(0), bytesReceived(0), syncFound(0) {}
+
+    int size() const { return flags.size(); }
+    bool isEmpty() const { return flags.isEmpty() && connectionBytes.isEmpty() && bytesReceived == 0 && bytesError == 0 && syncFound == 0; }
+
+    int msgOffset(int num) const { return offsets.at(num); }
+    int msgSize(int num) const { return (num + 1 < offsets.size() ? offsets.at(num + 1) : data.size()) - offsets.at(num); }
+    QByteArray getMsg(int num) const { return data.mid(msgOffset(num), msgSize(num)); }
+
+    // storage header, header and payload of all messages one after the other
+    QByteArray data;
+
+    // position of each message in data
+    QVector<int> offsets;
+    QVector<quint8> flags;
+
+    // connection which received each message, only used as key
+    QVector<const void*> connections;
+
+    // bytes read from each connection
+    QHash<const void*,unsigned long> connectionBytes;
+
+    // counters of all connections since the last batch
+    unsigned long bytesError;
+    unsigned long bytesReceived;
+    unsigned long syncFound;
+};
+
+// Reads and parses the data received from all ECUs in one thread, so the data is
+// read also while the GUI thread is busy. The sockets and serial ports are owned
+// by the DltReceiverConnection objects, which live in the receive thread.
+// The parsed messages are passed in batches to the GUI thread, which is notified
+// once with dataAvailable() until it has taken all batches. While all batches are
+// waiting for the GUI thread, no more data is read, the data is kept by the
+// operating system.
+// Receiving goes on while the log file is indexed.
+class DltReceiver : public QThread
+{
+    Q_OBJECT
+public:
+    DltReceiver(QObject *parent = 0);
+    ~DltReceiver();
+
+    // Create a connection to an ECU, which is deleted with deleteLater()
+    DltReceiverConnection *createConnection();
+
+    // Take the next batch, false if there is none.
+    // After false is returned dataAvailable() is emitted again for the next batch.
+    bool takeBatch(DltReceivedBatch &batch);
+
+    void requestStop();
+
+signals:
+    void dataAvailable();
+
+protected:
+    void run();
+
+private:
+    friend class DltReceiverConnection;
+
+    // Parse data read from a connection, called by the receive thread
+    void parseData(DltReceiverConnection *connection, const QByteArray &data);
+    void publish(const DltReceivedBatch &batch);
+
+    // parsed batches, and if the GUI thread was notified and did not take all of them yet
+    DltBlockingQueue<DltReceivedBatch> batchQueue;
+    QAtomicInt notified;
+};
+
+#endif // DLTRECEIVER_H
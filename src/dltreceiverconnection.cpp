@@ -0,0 +1,202 @@
+#include "dltreceiverconnection.h"
+#include "dltreceiver.h"
+
+DltReceiverConnection::DltReceiverConnection(DltReceiver *receiver)
+    : QObject(0),
+      receiver(receiver),
+      device(0),
+      tcpSocket(0),
+      udpSocket(0),
+      serialPort(0)
+{
+}
+
+DltReceiverConnection::~DltReceiverConnection()
+{
+    // the socket and serial port are deleted as children
+}
+
+void DltReceiverConnection::connectToHost(bool udp, const QString &hostname, quint16 port, QDltId ecuId, bool syncSerialHeader)
+{
+    QMetaObject::invokeMethod(this, "doConnectToHost", Qt::QueuedConnection,
+                              Q_ARG(bool, udp), Q_ARG(QString, hostname), Q_ARG(int, port),
+                              Q_ARG(QString, ecuId.toString()), Q_ARG(bool, syncSerialHeader));
+}
+
+void DltReceiverConnection::openSerialPort(const QString &portName, BaudRateType baudrate, QDltId ecuId, bool syncSerialHeader)
+{
+    QMetaObject::invokeMethod(this, "doOpenSerialPort", Qt::QueuedConnection,
+                              Q_ARG(QString, portName), Q_ARG(int, baudrate),
+                              Q_ARG(QString, ecuId.toString()), Q_ARG(bool, syncSerialHeader));
+}
+
+void DltReceiverConnection::disconnectFromHost()
+{
+    QMetaObject::invokeMethod(this, "doDisconnectFromHost", Qt::QueuedConnection);
+}
+
+void DltReceiverConnection::send(const QByteArray &data)
+{
+    QMetaObject::invokeMethod(this, "doSend", Qt::QueuedConnection, Q_ARG(QByteArray, data));
+}
+
+void DltReceiverConnection::doConnectToHost(bool udp, const QString &hostname, int port, const QString &ecuId, bool syncSerialHeader)
+{
+    QAbstractSocket *socket;
+
+    if(udp)
+    {
+        if(!udpSocket)
+            udpSocket = new QUdpSocket(this);
+        socket = udpSocket;
+    }
+    else
+    {
+        if(!tcpSocket)
+        {
+            // limit the data read at once, the rest is kept by the operating system
+            tcpSocket = new QTcpSocket(this);
+            tcpSocket->setReadBufferSize(DLT_RECEIVER_READ_BUFFER_SIZE);
+        }
+        socket = tcpSocket;
+    }
+
+    // the interface was changed
+    if(device && device != socket)
+        doDisconnectFromHost();
+
+    reset(ecuId, syncSerialHeader);
+    device = socket;
+
+    if(socket->state() != QAbstractSocket::UnconnectedState)
+        return;
+
+    disconnect(socket, 0, this, 0);
+    connect(socket, SIGNAL(connected()), this, SLOT(socketConnected()));
+    connect(socket, SIGNAL(disconnected()), this, SIGNAL(disconnected()));
+    connect(socket, SIGNAL(error(QAbstractSocket::SocketError)), this, SLOT(socketError(QAbstractSocket::SocketError)));
+    connect(socket, SIGNAL(readyRead()), this, SLOT(readyRead()));
+    connect(socket, SIGNAL(stateChanged(QAbstractSocket::SocketState)), this, SLOT(socketStateChanged(QAbstractSocket::SocketState)));
+
+    socket->connectToHost(hostname, port);
+}
+
+void DltReceiverConnection::doOpenSerialPort(const QString &portName, int baudrate, const QString &ecuId, bool syncSerialHeader)
+{
+    // the interface was changed
+    if(device && device != serialPort)
+        doDisconnectFromHost();
+
+    if(!serialPort)
+    {
+        PortSettings settings = {(BaudRateType)baudrate, DATA_8, PAR_NONE, STOP_1, FLOW_OFF, 10}; //Before timeout was 1
+        serialPort = new QextSerialPort(portName, settings, QextSerialPort::EventDriven, this);
+        connect(serialPort, SIGNAL(readyRead()), this, SLOT(readyRead()));
+        connect(serialPort, SIGNAL(dsrChanged(bool)), this, SLOT(serialDsrChanged(bool)));
+    }
+    else
+    {
+        // open again with the new settings
+        serialPort->close();
+        serialPort->setBaudRate((BaudRateType)baudrate);
+        serialPort->setPortName(portName);
+    }
+
+    reset(ecuId, syncSerialHeader);
+
+    device = serialPort;
+    serialPort->open(QIODevice::ReadWrite);
+
+    if(serialPort->isOpen())
+    {
+        emit connected();
+        emit stateChanged(QDltConnection::QDltConnectionOnline);
+    }
+    else
+    {
+        emit error(serialPort->errorString());
+    }
+}
+
+void DltReceiverConnection::doDisconnectFromHost()
+{
+    if(!device)
+        return;
+
+    if(device == serialPort)
+    {
+        serialPort->close();
+    }
+    else
+    {
+        QAbstractSocket *socket = (QAbstractSocket*)device;
+        if(socket->state() != QAbstractSocket::UnconnectedState)
+            socket->disconnectFromHost();
+    }
+
+    device = 0;
+}
+
+void DltReceiverConnection::doSend(const QByteArray &data)
+{
+    if(device && device->isOpen())
+        device->write(data);
+}
+
+void DltReceiverConnection::readyRead()
+{
+    QIODevice *source = qobject_cast<QIODevice*>(sender());
+    if(!source)
+        return;
+
+    // waits while the GUI thread is behind, the data is kept by the socket until then
+    QByteArray data = source->readAll();
+    if(source == device && data.size() > 0)
+        receiver->parseData(this, data);
+}
+
+void DltReceiverConnection::socketConnected()
+{
+    // the data of the previous connection is not parsed anymore
+    parser.clear();
+
+    emit connected();
+}
+
+void DltReceiverConnection::socketError(QAbstractSocket::SocketError /* socketError */)
+{
+    QAbstractSocket *socket = qobject_cast<QAbstractSocket*>(sender());
+    if(!socket)
+        return;
+
+    emit error(socket->errorString());
+
+    socket->disconnectFromHost();
+}
+
+void DltReceiverConnection::socketStateChanged(QAbstractSocket::SocketState socketState)
+{
+    switch(socketState){
+    case QAbstractSocket::ConnectingState:
+        emit stateChanged(QDltConnection::QDltConnectionConnecting);
+        break;
+    case QAbstractSocket::ConnectedState:
+        emit stateChanged(QDltConnection::QDltConnectionOnline);
+        break;
+    default:
+        emit stateChanged(QDltConnection::QDltConnectionOffline);
+        break;
+    }
+}
+
+void DltReceiverConnection::serialDsrChanged(bool status)
+{
+    emit stateChanged(status ? QDltConnection::QDltConnectionOnline : QDltConnection::QDltConnectionOffline);
+}
+
+void DltReceiverConnection::reset(const QString &ecuId, bool syncSerialHeader)
+{
+    parser.clear();
+    parser.setSyncSerialHeader(syncSerialHeader);
+    this->ecuId = QDltId(ecuId);
+}
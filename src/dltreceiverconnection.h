@@ -0,0 +1,80 @@
+#ifndef DLTRECEIVERCONNECTION_H
+#define DLTRECEIVERCONNECTION_H
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QAbstractSocket>
+#include <QTcpSocket>
+#include <QUdpSocket>
+#include <qextserialport.h>
+#include "qdlt.h"
+
+#define DLT_RECEIVER_READ_BUFFER_SIZE (1024*1024)
+
+class DltReceiver;
+
+// Connection to one ECU, which lives in the receive thread.
+// The socket or serial port is owned and read by the receive thread, so the data
+// is read also while the GUI thread is busy. The public functions are called by
+// the GUI thread, they are executed later by the receive thread. The signals are
+// received by the GUI thread.
+class DltReceiverConnection : public QObject
+{
+    Q_OBJECT
+public:
+    // Created by DltReceiver::createConnection(), deleted with deleteLater()
+    DltReceiverConnection(DltReceiver *receiver);
+    ~DltReceiverConnection();
+
+    // Connect with TCP or UDP, nothing is done if the socket is not unconnected
+    void connectToHost(bool udp, const QString &hostname, quint16 port, QDltId ecuId, bool syncSerialHeader);
+
+    // Open the serial port again with the settings
+    void openSerialPort(const QString &portName, BaudRateType baudrate, QDltId ecuId, bool syncSerialHeader);
+
+    // Disconnect from host or close the serial port
+    void disconnectFromHost();
+
+    // Send data, e.g. a control message, if connected
+    void send(const QByteArray &data);
+
+signals:
+    void connected();
+    void disconnected();
+    void error(QString errorString);
+
+    // New state of the connection, one of QDltConnection::QDltConnectionState
+    void stateChanged(int state);
+
+private slots:
+    void doConnectToHost(bool udp, const QString &hostname, int port, const QString &ecuId, bool syncSerialHeader);
+    void doOpenSerialPort(const QString &portName, int baudrate, const QString &ecuId, bool syncSerialHeader);
+    void doDisconnectFromHost();
+    void doSend(const QByteArray &data);
+
+    void readyRead();
+    void socketConnected();
+    void socketError(QAbstractSocket::SocketError socketError);
+    void socketStateChanged(QAbstractSocket::SocketState socketState);
+    void serialDsrChanged(bool status);
+
+private:
+    // Start parsing the data from the beginning
+    void reset(const QString &ecuId, bool syncSerialHeader);
+
+    DltReceiver *receiver;
+
+    // the device used by the current connection, 0 if none
+    QIODevice *device;
+    QTcpSocket *tcpSocket;
+    QUdpSocket *udpSocket;
+    QextSerialPort *serialPort;
+
+    // only used by the receive thread
+    friend class DltReceiver;
+    QDltConnection parser;
+    QDltId ecuId;
+};
+
+#endif // DLTRECEIVERCONNECTION_H
@@ -0,0 +1,307 @@
+#include "dltrecordwriter.h"
+
+#include <QDebug>
+
+#if defined(_MSC_VER) || defined(Q_OS_WIN)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+DltRecordWriter::DltRecordWriter(QObject *parent)
+    : QThread(parent),
+      endOffset(0),
+      committedOffset(0),
+      commitRequests(0),
+      writing(false),
+      stopRequested(false),
+      groupSize(DLT_RECORD_WRITER_GROUP_SIZE),
+      groupTime(DLT_RECORD_WRITER_GROUP_TIME),
+      durability(DurabilityNone),
+      unsynced(false)
+{
+}
+
+DltRecordWriter::~DltRecordWriter()
+{
+    // pending data is still written
+    requestStop();
+    wait();
+    close();
+}
+
+bool DltRecordWriter::open(const QString &fileName)
+{
+    commit();
+
+    QMutexLocker fileLocker(&fileMutex);
+
+    if(file.isOpen())
+    {
+        // the data of the previous file is on the disk when it is closed
+        if(getDurability() != DurabilityNone)
+            syncFile();
+        file.close();
+    }
+
+    file.setFileName(fileName);
+    bool ok = file.open(QIODevice::WriteOnly|QIODevice::Append);
+    if(!ok)
+        qDebug() << "Cannot open log file for writing" << fileName << file.errorString();
+
+    QMutexLocker locker(&mutex);
+    endOffset = committedOffset = (ok ? file.size() : 0);
+    unsynced = false;
+
+    return ok;
+}
+
+void DltRecordWriter::close()
+{
+    commit();
+
+    QMutexLocker fileLocker(&fileMutex);
+
+    if(!file.isOpen())
+        return;
+
+    // the data is on the disk when the file is closed
+    if(getDurability() != DurabilityNone)
+        syncFile();
+    file.close();
+
+    QMutexLocker locker(&mutex);
+    endOffset = committedOffset = 0;
+    unsynced = false;
+}
+
+bool DltRecordWriter::isOpen() const
+{
+    // the file is only opened and closed by the thread calling open() and close()
+    return file.isOpen();
+}
+
+void DltRecordWriter::setDurability(Durability durability)
+{
+    QMutexLocker locker(&mutex);
+    this->durability = durability;
+}
+
+DltRecordWriter::Durability DltRecordWriter::getDurability() const
+{
+    QMutexLocker locker(&mutex);
+    return durability;
+}
+
+void DltRecordWriter::setGroupLimits(int groupSize, int groupTime)
+{
+    QMutexLocker locker(&mutex);
+    this->groupSize = groupSize;
+    this->groupTime = groupTime;
+    dataAdded.wakeOne();
+}
+
+qint64 DltRecordWriter::append(const char *data, int size)
+{
+    if(!file.isOpen())
+        return -1;
+
+    QMutexLocker locker(&mutex);
+
+    // the writer thread is behind, e.g. while waiting for the disk
+    while(pending.size() >= 4 * groupSize && !stopRequested)
+        dataCommitted.wait(&mutex);
+
+    if(pending.isEmpty())
+    {
+        pending.reserve(groupSize);
+        pendingTime.start();
+    }
+
+    qint64 offset = endOffset;
+    pending.append(data, size);
+    endOffset += size;
+
+    if(pending.size() >= groupSize)
+        dataAdded.wakeOne();
+
+    return offset;
+}
+
+void DltRecordWriter::commit()
+{
+    QMutexLocker locker(&mutex);
+
+    commitRequests++;
+    dataAdded.wakeOne();
+    while((!pending.isEmpty() || writing) && isRunning())
+        dataCommitted.wait(&mutex);
+    commitRequests--;
+
+    // the writer thread is not running, the data is written by the calling thread
+    if(!pending.isEmpty())
+    {
+        QByteArray group;
+        group.swap(pending);
+        Durability groupDurability = durability;
+        // without the writer thread the periodic sync is only checked when data is written
+        if(groupDurability == DurabilityPeriodic && !unsynced)
+        {
+            unsynced = true;
+            syncTime.start();
+        }
+        bool sync = syncReady();
+        if(sync)
+            unsynced = false;
+        locker.unlock();
+        QMutexLocker fileLocker(&fileMutex);
+        writeGroup(group, groupDurability);
+        if(sync)
+            syncFile();
+        fileLocker.unlock();
+        locker.relock();
+        committedOffset += group.size();
+    }
+}
+
+qint64 DltRecordWriter::size() const
+{
+    QMutexLocker locker(&mutex);
+    return endOffset;
+}
+
+qint64 DltRecordWriter::committedSize() const
+{
+    QMutexLocker locker(&mutex);
+    return committedOffset;
+}
+
+void DltRecordWriter::requestStop()
+{
+    QMutexLocker locker(&mutex);
+    stopRequested = true;
+    dataAdded.wakeAll();
+    dataCommitted.wakeAll();
+}
+
+bool DltRecordWriter::groupReady() const
+{
+    if(pending.isEmpty())
+        return false;
+
+    return pending.size() >= groupSize || commitRequests > 0 || stopRequested ||
+            pendingTime.elapsed() >= groupTime;
+}
+
+bool DltRecordWriter::syncReady() const
+{
+    return unsynced && syncTime.elapsed() >= DLT_RECORD_WRITER_SYNC_INTERVAL;
+}
+
+void DltRecordWriter::run()
+{
+    QByteArray group;
+
+    mutex.lock();
+    for(;;)
+    {
+        while(!groupReady() && !syncReady() && !stopRequested)
+        {
+            // wake up for the next group and for the periodic sync, whichever is first
+            int timeout = -1;
+            if(!pending.isEmpty())
+                timeout = qMax(1, groupTime - (int)pendingTime.elapsed());
+            if(unsynced)
+            {
+                int syncTimeout = qMax(1, DLT_RECORD_WRITER_SYNC_INTERVAL - (int)syncTime.elapsed());
+                timeout = (timeout < 0) ? syncTimeout : qMin(timeout, syncTimeout);
+            }
+
+            if(timeout < 0)
+                dataAdded.wait(&mutex);
+            else
+                dataAdded.wait(&mutex, timeout);
+        }
+
+        // written data waited for the sync interval, also if no more data was appended
+        if(syncReady())
+        {
+            unsynced = false;
+            mutex.unlock();
+
+            fileMutex.lock();
+            syncFile();
+            fileMutex.unlock();
+
+            mutex.lock();
+            continue;
+        }
+
+        if(pending.isEmpty())
+            break;
+
+        group.swap(pending);
+        Durability groupDurability = durability;
+        writing = true;
+        mutex.unlock();
+
+        fileMutex.lock();
+        writeGroup(group, groupDurability);
+        fileMutex.unlock();
+
+        mutex.lock();
+        writing = false;
+        committedOffset += group.size();
+        if(groupDurability == DurabilityPeriodic && !unsynced)
+        {
+            // the sync interval starts with the oldest data which is not synchronised
+            unsynced = true;
+            syncTime.start();
+        }
+        qint64 size = committedOffset;
+        dataCommitted.wakeAll();
+        mutex.unlock();
+
+        group.clear();
+        emit committed(size);
+
+        mutex.lock();
+    }
+    mutex.unlock();
+}
+
+void DltRecordWriter::writeGroup(const QByteArray &group, Durability durability)
+{
+    if(!file.isOpen())
+        return;
+
+    // https://bugreports.qt-project.org/browse/QTBUG-26069
+    file.seek(file.size());
+    if(file.write(group) != group.size())
+        qDebug() << "Cannot write log file" << file.fileName() << file.errorString();
+    file.flush();
+
+    // with periodic durability the writer thread synchronises the data later
+    if(durability == DurabilityGroup)
+    {
+#if defined(_MSC_VER) || defined(Q_OS_WIN)
+        _commit(file.handle());
+#elif defined(Q_OS_MAC)
+        fsync(file.handle());
+#else
+        fdatasync(file.handle());
+#endif
+    }
+}
+
+void DltRecordWriter::syncFile()
+{
+    if(!file.isOpen())
+        return;
+
+#if defined(_MSC_VER) || defined(Q_OS_WIN)
+    _commit(file.handle());
+#else
+    fsync(file.handle());
+#endif
+}
@@ -0,0 +1,95 @@
+#ifndef DLTRECORDWRITER_H
+#define DLTRECORDWRITER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+#include <QByteArray>
+#include <QString>
+#include <QFile>
+
+#define DLT_RECORD_WRITER_GROUP_SIZE (1024*1024)
+#define DLT_RECORD_WRITER_GROUP_TIME 100
+#define DLT_RECORD_WRITER_SYNC_INTERVAL 1000
+
+// Writes the messages received from the ECUs to the log file in its own thread.
+// The appended data is collected and written as one group, when the group size
+// is reached or the oldest data waited for the group time, followed by a flush
+// and depending on the durability a synchronisation to the disk. With periodic
+// durability, written data is synchronised at the latest after the sync interval,
+// also if no more data is appended.
+// The GUI thread appends the data and gets the file offset of each message at once,
+// committed() is emitted when the data up to a file size is written.
+class DltRecordWriter : public QThread
+{
+    Q_OBJECT
+public:
+    // When the written data is synchronised to the disk
+    enum Durability { DurabilityNone = 0, DurabilityPeriodic, DurabilityGroup };
+
+    DltRecordWriter(QObject *parent = 0);
+    ~DltRecordWriter();
+
+    // Data is written to the file with a second handle, opened in append mode.
+    // Appending to another file commits the pending data first.
+    bool open(const QString &fileName);
+    void close();
+    bool isOpen() const;
+
+    void setDurability(Durability durability);
+    Durability getDurability() const;
+    void setGroupLimits(int groupSize, int groupTime);
+
+    // Append data to the log file, waits while too much data is pending.
+    // Returns the offset of the data in the file, or -1 if no file is open.
+    qint64 append(const char *data, int size);
+    qint64 append(const QByteArray &data) { return append(data.constData(), data.size()); }
+
+    // Write the pending data now and wait until it is written.
+    void commit();
+
+    // Size of the file with and without the pending data
+    qint64 size() const;
+    qint64 committedSize() const;
+
+    void requestStop();
+
+signals:
+    // The data up to the file size is written to the file
+    void committed(qint64 size);
+
+protected:
+    void run();
+
+private:
+    bool groupReady() const;
+    bool syncReady() const;
+    void writeGroup(const QByteArray &group, Durability durability);
+    void syncFile();
+
+    // appended data, not written yet
+    mutable QMutex mutex;
+    QWaitCondition dataAdded;
+    QWaitCondition dataCommitted;
+    QByteArray pending;
+    QElapsedTimer pendingTime;
+    qint64 endOffset;
+    qint64 committedOffset;
+    int commitRequests;
+    bool writing;
+    bool stopRequested;
+    int groupSize;
+    int groupTime;
+    Durability durability;
+
+    // written data, not synchronised to the disk yet with periodic durability
+    bool unsynced;
+    QElapsedTimer syncTime;
+
+    // file used by the writer thread, locked while a group is written
+    QMutex fileMutex;
+    QFile file;
+};
+
+#endif // DLTRECORDWRITER_H
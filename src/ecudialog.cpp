@@ -80,7 +80,7 @@ EcuDialog::~EcuDialog()
 
 void EcuDialog::setData(EcuItem &item)
 {
-    ui->idLineEdit->setText(item.id);
+    ui->idLineEdit->setText(item.id.toString());
     ui->descriptionLineEdit->setText(item.description);
     ui->comboBoxInterface->setCurrentIndex(item.interfacetype);
     ui->comboBoxHostname->setEditText(item.getHostname());
@@ -277,7 +277,7 @@ void EcuDialog::setPortList(QStringList ports)
 }
 
 void EcuDialog::setDialogToEcuItem(EcuItem *item){
-    item->id = this->id();
+    item->id = QDltId(this->id());
     item->description = this->description();
     item->interfacetype = this->interfacetype();
     item->setHostname(this->hostname());
@@ -399,7 +399,7 @@ void FilterDialog::validate()
         return;
     }
 
-    QRegExp rx;
+    QDltRegExp rx;
     rx.setPattern(getPayloadText());
     if(!rx.isValid()) {
         QMessageBox::warning(this, "Warning", error.arg("PAYLOAD").arg(rx.pattern()).arg(rx.errorString()));
@@ -21,17 +21,17 @@ JumpToDialog::~JumpToDialog()
     delete ui;
 }
 
-void JumpToDialog::setLimits(int min, int max)
+void JumpToDialog::setLimits(qint64 min, qint64 max)
 {
     searchMin = min;
     searchMax = max;
 }
 
-int JumpToDialog::getIndex()
+qint64 JumpToDialog::getIndex()
 {
     QString it = ui->lineEditIndex->text();
     bool ok;
-    int ret = it.toInt(&ok);
+    qint64 ret = it.toLongLong(&ok);
     if(ok)
     {
         return ret;
@@ -14,13 +14,13 @@ class JumpToDialog : public QDialog
 public:
     explicit JumpToDialog(QWidget *parent = 0);
     ~JumpToDialog();
-    void setLimits(int min, int max);
-    int getIndex();
+    void setLimits(qint64 min, qint64 max);
+    qint64 getIndex();
     void showEvent(QShowEvent * event);
 private:
     Ui::JumpToDialog *ui;
-    int searchMin;
-    int searchMax;
+    qint64 searchMin;
+    qint64 searchMax;
 private slots:
     void validate();
 };
@@ -18,6 +18,7 @@
  */
 
 #include <iostream>
+#include <limits.h>
 #include <QMimeData>
 #include <QTreeView>
 #include <QFileDialog>
@@ -152,6 +153,9 @@ MainWindow::~MainWindow()
         }
     }
 
+    // write all received data before the file is renamed
+    recordWriter->close();
+
     // rename output filename if flag set in settings
     if(settings->appendDateTime)
     {
@@ -176,9 +180,14 @@ MainWindow::~MainWindow()
         }
     }
 
+    // the connections of the ECUs are deleted by the receive thread before it is stopped
+    project.ecu->clear();
+
     delete ui;
     delete tableModel;
     delete searchDlg;
+    delete dltReceiver;
+    delete recordWriter;
     delete dltIndexer;
     delete m_shortcut_searchnext;
     delete m_shortcut_searchprev;
@@ -308,6 +317,7 @@ void MainWindow::initView()
     statusByteErrorsReceived = new QLabel("Recv Errors: 0");
     statusSyncFoundReceived = new QLabel("Sync found: 0");
     statusProgressBar = new QProgressBar();
+    statusProgressBarShift = 0;
     statusBar()->addWidget(statusFilename);
     statusBar()->addWidget(statusFileVersion);
     statusBar()->addWidget(statusBytesReceived);
@@ -462,6 +472,17 @@ void MainWindow::initFileHandling()
     connect(dltIndexer, SIGNAL(timezone(int,unsigned char)), this, SLOT(controlMessage_Timezone(int,unsigned char)));
     connect(dltIndexer, SIGNAL(unregisterContext(QString,QString,QString)), this, SLOT(controlMessage_UnregisterContext(QString,QString,QString)));
 
+    /* Initialize receive thread */
+    dltReceiver = new DltReceiver(this);
+    connect(dltReceiver, SIGNAL(dataAvailable()), this, SLOT(receiveDataAvailable()));
+    dltReceiver->start();
+
+    /* Initialize writer thread */
+    recordWriter = new DltRecordWriter(this);
+    recordWriter->setDurability((DltRecordWriter::Durability)settings->writeSync);
+    connect(recordWriter, SIGNAL(committed(qint64)), this, SLOT(recordCommitted()));
+    recordWriter->start();
+
     /* Plugins/Filters enabled checkboxes */
     ui->pluginsEnabled->setChecked(DltSettingsManager::getInstance()->value("startup/pluginsEnabled", true).toBool());
     ui->filtersEnabled->setChecked(DltSettingsManager::getInstance()->value("startup/filtersEnabled", true).toBool());
@@ -527,6 +548,7 @@ void MainWindow::initFileHandling()
             outputfileIsFromCLI = false;
             if(outputfile.open(QIODevice::WriteOnly|QIODevice::Truncate))
             {
+                recordWriter->open(fn);
                 openFileNames = QStringList(fn);
                 isDltFileReadOnly = false;
                 reloadLogFile();
@@ -752,6 +774,7 @@ void MainWindow::deleteactualFile()
     {
         // Delete created temp file
         qfile.close();
+        recordWriter->close();
         outputfile.close();
         if(outputfile.exists() && !outputfile.remove())
         {
@@ -775,6 +798,7 @@ void MainWindow::closeEvent(QCloseEvent *event)
 {
 
     settings->writeSettings(this);
+    recordWriter->commit();
     if(true == isSearchOngoing)
     {
         event->ignore();
@@ -828,6 +852,7 @@ void MainWindow::on_New_triggered(QString fileName)
     workingDirectory.setDltDirectory(QFileInfo(fileName).absolutePath());
 
     // close existing file
+    recordWriter->close();
     if(outputfile.isOpen())
     {
         if (outputfile.size() == 0)
@@ -847,6 +872,7 @@ void MainWindow::on_New_triggered(QString fileName)
     setCurrentFile(fileName);
     if(outputfile.open(QIODevice::WriteOnly|QIODevice::Truncate))
     {
+        recordWriter->open(fileName);
         openFileNames = QStringList(fileName);
         isDltFileReadOnly = false;
         reloadLogFile();
@@ -934,6 +960,7 @@ bool MainWindow::openDltFile(QStringList fileNames)
     // clear the cache stored for the history
     searchDlg->clearCacheHistory();
 
+    recordWriter->close();
     if(outputfile.isOpen())
     {
         if (outputfile.size() == 0)
@@ -951,6 +978,7 @@ bool MainWindow::openDltFile(QStringList fileNames)
     setCurrentFile(fileNames.last());
     if(outputfile.open(QIODevice::WriteOnly|QIODevice::Append))
     {
+        recordWriter->open(fileNames.last());
         openFileNames = fileNames;
         isDltFileReadOnly = false;
         if(OptManager::getInstance()->isConvert() || OptManager::getInstance()->isPlugin())
@@ -1027,13 +1055,10 @@ void MainWindow::on_action_menuFile_Import_DLT_Stream_triggered()
     /* parse and build index of complete log file and show progress */
     while (dlt_file_read_raw(&importfile,false,0)>=0)
     {
-        // https://bugreports.qt-project.org/browse/QTBUG-26069
-        outputfile.seek(outputfile.size());
-        outputfile.write((char*)importfile.msg.headerbuffer,importfile.msg.headersize);
-        outputfile.write((char*)importfile.msg.databuffer,importfile.msg.datasize);
-        outputfile.flush();
-
+        recordWriter->append((char*)importfile.msg.headerbuffer,importfile.msg.headersize);
+        recordWriter->append((char*)importfile.msg.databuffer,importfile.msg.datasize);
     }
+    recordWriter->commit();
 
     dlt_file_free(&importfile,0);
 
@@ -1071,13 +1096,10 @@ void MainWindow::on_action_menuFile_Import_DLT_Stream_with_Serial_Header_trigger
     /* parse and build index of complete log file and show progress */
     while (dlt_file_read_raw(&importfile,true,0)>=0)
     {
-        // https://bugreports.qt-project.org/browse/QTBUG-26069
-        outputfile.seek(outputfile.size());
-        outputfile.write((char*)importfile.msg.headerbuffer,importfile.msg.headersize);
-        outputfile.write((char*)importfile.msg.databuffer,importfile.msg.datasize);
-        outputfile.flush();
-
+        recordWriter->append((char*)importfile.msg.headerbuffer,importfile.msg.headersize);
+        recordWriter->append((char*)importfile.msg.databuffer,importfile.msg.datasize);
     }
+    recordWriter->commit();
 
     dlt_file_free(&importfile,0);
 
@@ -1145,14 +1167,15 @@ void MainWindow::on_action_menuFile_Append_DLT_File_triggered()
         if (progress.wasCanceled())
         {
             dlt_file_free(&importfile,0);
+            recordWriter->commit();
             reloadLogFile();
             return;
         }
         dlt_file_message(&importfile,pos,0);
-        outputfile.write((char*)importfile.msg.headerbuffer,importfile.msg.headersize);
-        outputfile.write((char*)importfile.msg.databuffer,importfile.msg.datasize);
+        recordWriter->append((char*)importfile.msg.headerbuffer,importfile.msg.headersize);
+        recordWriter->append((char*)importfile.msg.databuffer,importfile.msg.datasize);
     }
-    outputfile.flush();
+    recordWriter->commit();
 
     dlt_file_free(&importfile,0);
 
@@ -1183,13 +1206,13 @@ void MainWindow::exportSelection_searchTable()
     foreach(QModelIndex index,list)
     {
         int position = index.row();
-        unsigned long entry;
+        qint64 entry;
 
         if (! m_searchtableModel->get_SearchResultEntry(position, entry) )
             return;
 
         //jump_to_line
-        int row = nearest_line(entry);
+        int row = tableModel->showFilterIndex(nearest_line(entry));
         if (0 > row)
             return;
 
@@ -1360,6 +1383,7 @@ void MainWindow::on_SaveAs_triggered(QString fileName)
     workingDirectory.setDltDirectory(QFileInfo(fileName).absolutePath());
 
     qfile.close();
+    recordWriter->close();
     outputfile.close();
 
     QFile sourceFile( outputfile.fileName() );
@@ -1390,6 +1414,7 @@ void MainWindow::on_SaveAs_triggered(QString fileName)
     setCurrentFile(fileName);
     if(outputfile.open(QIODevice::WriteOnly|QIODevice::Append))
     {
+        recordWriter->open(fileName);
         openFileNames = QStringList(fileName);
         isDltFileReadOnly = false;
         reloadLogFile();
@@ -1423,6 +1448,7 @@ void MainWindow::on_action_menuFile_Clear_triggered()
 
     QString oldfn = outputfile.fileName();
 
+    recordWriter->close();
     if(outputfile.isOpen())
     {
         if (outputfile.size() == 0)
@@ -1439,6 +1465,7 @@ void MainWindow::on_action_menuFile_Clear_triggered()
 
     if(outputfile.open(QIODevice::WriteOnly|QIODevice::Truncate))
     {
+        recordWriter->open(fn);
         openFileNames = QStringList(fn);
         isDltFileReadOnly = false;
         reloadLogFile();
@@ -1478,7 +1505,7 @@ void MainWindow::contextLoadingFile(QDltMsg &msg)
         for(int num = 0; num < project.ecu->topLevelItemCount (); num++)
         {
             EcuItem *ecuitem = (EcuItem*)project.ecu->topLevelItem(num);
-            if(ecuitem->id == msg.getEcuid())
+            if(ecuitem->id == msg.getEcuidId())
             {
                 ecuitemFound = ecuitem;
                 break;
@@ -1491,7 +1518,7 @@ void MainWindow::contextLoadingFile(QDltMsg &msg)
             ecuitemFound = new EcuItem(0);
 
             /* update ECU item */
-            ecuitemFound->id = msg.getEcuid();
+            ecuitemFound->id = msg.getEcuidId();
             ecuitemFound->update();
 
             /* add ECU to configuration */
@@ -1515,12 +1542,17 @@ void MainWindow::reloadLogFileStop()
 
 void MainWindow::reloadLogFileProgressMax(quint64 num)
 {
-    statusProgressBar->setRange(0,num);
+    /* the progress bar is limited to int, scale down large values */
+    statusProgressBarShift = 0;
+    while((num >> statusProgressBarShift) > INT_MAX)
+        statusProgressBarShift++;
+
+    statusProgressBar->setRange(0,static_cast<int>(num >> statusProgressBarShift));
 }
 
 void MainWindow::reloadLogFileProgress(quint64 num)
 {
-    statusProgressBar->setValue(num);
+    statusProgressBar->setValue(static_cast<int>(num >> statusProgressBarShift));
 }
 
 void MainWindow::reloadLogFileProgressText(QString text)
@@ -1589,7 +1621,7 @@ void MainWindow::reloadLogFileFinishFilter()
     // process getLogInfoMessages
     if(( dltIndexer->getMode() == DltFileIndexer::modeIndexAndFilter) && settings->updateContextLoadingFile)
     {
-        QList<int> list = dltIndexer->getGetLogInfoList();
+        QList<qint64> list = dltIndexer->getGetLogInfoList();
         QDltMsg msg;
 
         for(int num=0;num<list.size();num++)
@@ -1602,9 +1634,6 @@ void MainWindow::reloadLogFileFinishFilter()
     // reconnect ecus again
     connectPreviouslyConnectedECUs();
 
-    // We might have had readyRead events, which we missed
-    readyRead();
-
     // hide progress bar when finished
     statusProgressBar->reset();
     statusProgressBar->hide();
@@ -1620,6 +1649,13 @@ void MainWindow::reloadLogFileFinishDefaultFilter()
 
 void MainWindow::reloadLogFile(bool update, bool multithreaded)
 {
+    /* the messages written so far are found by the indexer */
+    if(!update)
+    {
+        recordWriter->commit();
+        liveMsgs.clear();
+    }
+
     /* check if in logging only mode, then do not create index */
     tableModel->setLoggingOnlyMode(settings->loggingOnlyMode);
     tableModel->modelChanged();
@@ -1667,6 +1703,8 @@ void MainWindow::reloadLogFile(bool update, bool multithreaded)
     // open qfile
     if(!update)
     {
+        // files written by the viewer could be truncated, only map read only files
+        qfile.enableMemoryMapping(isDltFileReadOnly);
         for(int num=0;num<openFileNames.size();num++)
         {
             //qDebug() << "Open file" << openFileNames[num];
@@ -1793,6 +1831,7 @@ void MainWindow::on_action_menuFile_Settings_triggered()
         /* change settings and store settings persistently */
         settings->readDlg();
         settings->writeSettings(this);
+        recordWriter->setDurability((DltRecordWriter::Durability)settings->writeSync);
 
         /* Apply settings to table */
         applySettings();
@@ -2171,7 +2210,7 @@ void MainWindow::on_action_menuConfig_Application_Add_triggered()
         {
             /* change settings of application configuration */
             ApplicationItem* appitem = new ApplicationItem(ecuitem);
-            appitem->id = dlg.id();
+            appitem->id = QDltId(dlg.id());
             appitem->description = dlg.description();
 
             /* update application item */
@@ -2192,10 +2231,10 @@ void MainWindow::on_action_menuConfig_Application_Edit_triggered()
         ApplicationItem* appitem = (ApplicationItem*) list.at(0);
 
         /* show Application configuration dialog */
-        ApplicationDialog dlg(appitem->id,appitem->description);
+        ApplicationDialog dlg(appitem->id.toString(),appitem->description);
         if(dlg.exec())
         {
-            appitem->id = dlg.id();
+            appitem->id = QDltId(dlg.id());
             appitem->description = dlg.description();
 
             /* update application item */
@@ -2232,7 +2271,7 @@ void MainWindow::on_action_menuConfig_Context_Add_triggered()
         if(dlg.exec()==1)
         {
             ContextItem* conitem = new ContextItem(appitem);
-            conitem->id = dlg.id();
+            conitem->id = QDltId(dlg.id());
             conitem->description = dlg.description();
             conitem->loglevel = dlg.loglevel();
             conitem->tracestatus = dlg.tracestatus();
@@ -2247,8 +2286,8 @@ void MainWindow::on_action_menuConfig_Context_Add_triggered()
             if(dlg.update())
             {
                 EcuItem* ecuitem = (EcuItem*) appitem->parent();
-                controlMessage_SetLogLevel(ecuitem,appitem->id,conitem->id,conitem->loglevel);
-                controlMessage_SetTraceStatus(ecuitem,appitem->id,conitem->id,conitem->tracestatus);
+                controlMessage_SetLogLevel(ecuitem,appitem->id.toString(),conitem->id.toString(),conitem->loglevel);
+                controlMessage_SetTraceStatus(ecuitem,appitem->id.toString(),conitem->id.toString(),conitem->tracestatus);
 
                 /* update status */
                 conitem->status = ContextItem::valid;
@@ -2269,10 +2308,10 @@ void MainWindow::on_action_menuConfig_Context_Edit_triggered()
         ContextItem* conitem = (ContextItem*) list.at(0);
 
         /* show Context configuration dialog */
-        ContextDialog dlg(conitem->id,conitem->description,conitem->loglevel,conitem->tracestatus);
+        ContextDialog dlg(conitem->id.toString(),conitem->description,conitem->loglevel,conitem->tracestatus);
         if(dlg.exec())
         {
-            conitem->id = dlg.id();
+            conitem->id = QDltId(dlg.id());
             conitem->description = dlg.description();
             conitem->loglevel = dlg.loglevel();
             conitem->tracestatus = dlg.tracestatus();
@@ -2288,8 +2327,8 @@ void MainWindow::on_action_menuConfig_Context_Edit_triggered()
 
                 if(ecuitem->connected)
                 {
-                    controlMessage_SetLogLevel(ecuitem,appitem->id,conitem->id,conitem->loglevel);
-                    controlMessage_SetTraceStatus(ecuitem,appitem->id,conitem->id,conitem->tracestatus);
+                    controlMessage_SetLogLevel(ecuitem,appitem->id.toString(),conitem->id.toString(),conitem->loglevel);
+                    controlMessage_SetTraceStatus(ecuitem,appitem->id.toString(),conitem->id.toString(),conitem->tracestatus);
 
                     /* update status */
                     conitem->status = ContextItem::valid;
@@ -2372,8 +2411,8 @@ void MainWindow::on_action_menuDLT_Edit_All_Log_Levels_triggered()
 
                         if(ecuitem->connected)
                         {
-                            controlMessage_SetLogLevel(ecuitem,appitem->id,conitem->id,conitem->loglevel);
-                            controlMessage_SetTraceStatus(ecuitem,appitem->id,conitem->id,conitem->tracestatus);
+                            controlMessage_SetLogLevel(ecuitem,appitem->id.toString(),conitem->id.toString(),conitem->loglevel);
+                            controlMessage_SetTraceStatus(ecuitem,appitem->id.toString(),conitem->id.toString(),conitem->tracestatus);
 
                             /* update status */
                             conitem->status = ContextItem::valid;
@@ -2781,18 +2820,9 @@ void MainWindow::disconnectECU(EcuItem *ecuitem)
         ecuitem->update();
         on_configWidget_itemSelectionChanged();
 
-        /* update conenction state */
-        if(ecuitem->interfacetype == EcuItem::INTERFACETYPE_TCP || ecuitem->interfacetype == EcuItem::INTERFACETYPE_UDP)
-        {
-            /* TCP or UDP */
-            if (ecuitem->socket->state()!=QAbstractSocket::UnconnectedState)
-                ecuitem->socket->disconnectFromHost();
-        }
-        else
-        {
-            /* Serial */
-            ecuitem->m_serialport->close();
-        }
+        /* update conenction state, the receive thread disconnects the socket or closes the serial port */
+        if(ecuitem->connection)
+            ecuitem->connection->disconnectFromHost();
 
         ecuitem->InvalidAll();
     }
@@ -2846,73 +2876,29 @@ void MainWindow::connectECU(EcuItem* ecuitem,bool force)
         ecuitem->ipcon.clear();
         ecuitem->serialcon.clear();
 
+        /* the socket or serial port is owned and read by the receive thread */
+        if(!ecuitem->connection)
+        {
+            ecuitem->connection = dltReceiver->createConnection();
+            connect(ecuitem->connection,SIGNAL(connected()),this,SLOT(connected()));
+            connect(ecuitem->connection,SIGNAL(disconnected()),this,SLOT(disconnected()));
+            connect(ecuitem->connection,SIGNAL(error(QString)),this,SLOT(error(QString)));
+            connect(ecuitem->connection,SIGNAL(stateChanged(int)),this,SLOT(stateChanged(int)));
+        }
+
         //qDebug()<< "Connect ECU " <<__LINE__;
         /* start socket connection to host */
         if(ecuitem->interfacetype == EcuItem::INTERFACETYPE_TCP || ecuitem->interfacetype == EcuItem::INTERFACETYPE_UDP)
         {
             /* TCP or UDP */
-            /* connect socket signals with window slots */
-            if (ecuitem->socket->state()==QAbstractSocket::UnconnectedState)
-            {
-                disconnect(ecuitem->socket,0,0,0);
-                connect(ecuitem->socket,SIGNAL(connected()),this,SLOT(connected()));
-                connect(ecuitem->socket,SIGNAL(disconnected()),this,SLOT(disconnected()));
-                connect(ecuitem->socket,SIGNAL(error(QAbstractSocket::SocketError)),this,SLOT(error(QAbstractSocket::SocketError)));
-                connect(ecuitem->socket,SIGNAL(readyRead()),this,SLOT(readyRead()));
-                connect(ecuitem->socket,SIGNAL(stateChanged(QAbstractSocket::SocketState)),this,SLOT(stateChangedTCP(QAbstractSocket::SocketState)));
-
-                //disconnect(ecuitem->socket,0,0,0);
-                ecuitem->socket->connectToHost(ecuitem->getHostname(),ecuitem->getIpport());
-            }
+            ecuitem->connection->connectToHost(ecuitem->interfacetype == EcuItem::INTERFACETYPE_UDP,ecuitem->getHostname(),ecuitem->getIpport(),
+                                               ecuitem->id,ecuitem->ipcon.getSyncSerialHeader());
         }
         else
         {
-            /* Serial */
-            if(!ecuitem->m_serialport)
-            {
-                PortSettings settings = {ecuitem->getBaudrate(), DATA_8, PAR_NONE, STOP_1, FLOW_OFF, 10}; //Before timeout was 1
-                ecuitem->m_serialport = new QextSerialPort(ecuitem->getPort(),settings);
-                connect(ecuitem->m_serialport, SIGNAL(readyRead()), this, SLOT(readyRead()));
-                connect(ecuitem->m_serialport,SIGNAL(dsrChanged(bool)),this,SLOT(stateChangedSerial(bool)));
-            }
-            else
-            {
-
-                //to keep things consistent: delete old member, create new one
-                //alternatively we could just close the port, and set the new settings.
-                ecuitem->m_serialport->close();
-                //delete(ecuitem->m_serialport);
-                ecuitem->m_serialport->setBaudRate(ecuitem->getBaudrate());
-                //ecuitem->m_serialport->setDataBits(settings.DataBits);
-                //ecuitem->m_serialport->setFlowControl(settings.FlowControl);
-                //ecuitem->m_serialport->setStopBits(settings.StopBits);
-                //ecuitem->m_serialport->setParity(settings.Parity);
-                //ecuitem->m_serialport->setTimeout(settings.Timeout_Millisec);
-                ecuitem->m_serialport->setPortName(ecuitem->getPort());
-            }
-
-            if(ecuitem->m_serialport->isOpen())
-            {
-                ecuitem->m_serialport->close();
-                ecuitem->m_serialport->setBaudRate(ecuitem->getBaudrate());
-            }
-
-            ecuitem->m_serialport->open(QIODevice::ReadWrite);
-
-            if(ecuitem->m_serialport->isOpen())
-            {
-                ecuitem->connected = true;
-                ecuitem->update();
-                on_configWidget_itemSelectionChanged();
-
-                /* send new default log level to ECU, if selected in dlg */
-                if (ecuitem->updateDataIfOnline)
-                {
-                    sendUpdates(ecuitem);
-                }
-
-            }
-
+            /* Serial, the ECU is online when the port is opened */
+            ecuitem->connection->openSerialPort(ecuitem->getPort(),ecuitem->getBaudrate(),
+                                                ecuitem->id,ecuitem->serialcon.getSyncSerialHeader());
         }
 
         if(  (settings->showCtId && settings->showCtIdDesc) || (settings->showApId && settings->showApIdDesc) ){
@@ -2930,7 +2916,7 @@ void MainWindow::connected()
     for(int num = 0; num < project.ecu->topLevelItemCount (); num++)
     {
         EcuItem *ecuitem = (EcuItem*)project.ecu->topLevelItem(num);
-        if( ecuitem->socket == sender())
+        if( ecuitem->connection == sender())
         {
             /* update connection state */
             ecuitem->connected = true;
@@ -2995,7 +2981,7 @@ void MainWindow::disconnected()
     for(int num = 0; num < project.ecu->topLevelItemCount (); num++)
     {
         EcuItem *ecuitem = (EcuItem*)project.ecu->topLevelItem(num);
-        if( ecuitem && ecuitem->socket == sender())
+        if( ecuitem && ecuitem->connection == sender())
         {
             qDebug() << "Disconnect" << ecuitem->getHostname();
             /* update connection state */
@@ -3004,9 +2990,6 @@ void MainWindow::disconnected()
             ecuitem->InvalidAll();
             ecuitem->update();
             on_configWidget_itemSelectionChanged();
-
-            /* disconnect socket signals from window slots */
-            disconnect(ecuitem->socket,0,0,0);
         }
     }
       checkConnectionState();
@@ -3044,24 +3027,18 @@ void MainWindow::timeout()
         }
 }
 
-void MainWindow::error(QAbstractSocket::SocketError /* socketError */)
+void MainWindow::error(QString errorString)
 {
-    /* signal emited when connection to host is not possible */
+    /* signal emited when connection to host is not possible, the socket is disconnected by the receive thread */
 
-    /* find socket which emited signal */
+    /* find connection which emited signal */
     for(int num = 0; num < project.ecu->topLevelItemCount (); num++)
     {
         EcuItem *ecuitem = (EcuItem*)project.ecu->topLevelItem(num);
-        if( ecuitem && ecuitem->socket == sender())
+        if( ecuitem && ecuitem->connection == sender())
         {
             /* save error */
-            ecuitem->connectError = ecuitem->socket->errorString();
-
-            if(ecuitem->interfacetype == EcuItem::INTERFACETYPE_TCP || ecuitem->interfacetype == EcuItem::INTERFACETYPE_UDP)
-            {
-                /* disconnect socket */
-                ecuitem->socket->disconnectFromHost();
-            }
+            ecuitem->connectError = errorString;
 
             /* update connection state */
             ecuitem->connected = false;
@@ -3073,190 +3050,187 @@ void MainWindow::error(QAbstractSocket::SocketError /* socketError */)
     }
 }
 
-void MainWindow::readyRead()
+void MainWindow::receiveDataAvailable()
 {
-    /* signal emited when socket received data */
+    DltReceivedBatch batch;
 
-    /* Delay reading, if indexer is working on the dlt file */
-    if(dltIndexer->tryLock())
+    /* signal emited once by the receive thread until all parsed messages are taken */
+    while(dltReceiver->takeBatch(batch))
     {
-        /* find socket which emited signal */
-        for(int num = 0; num < project.ecu->topLevelItemCount (); num++)
+        totalByteErrorsRcvd+=batch.bytesError;
+        totalBytesRcvd+=batch.bytesReceived;
+        totalSyncFoundRcvd+=batch.syncFound;
+
+        /* bytes read from each ECU, used by the auto reconnect */
+        for(int numecu = 0; numecu < project.ecu->topLevelItemCount (); numecu++)
         {
-            EcuItem *ecuitem = (EcuItem*)project.ecu->topLevelItem(num);
-            if( ecuitem && (ecuitem->socket == sender() || ecuitem->m_serialport == sender()))
+            EcuItem *ecuitem = (EcuItem*)project.ecu->topLevelItem(numecu);
+            if(ecuitem->connection)
+                ecuitem->totalBytesRcvd += batch.connectionBytes.value(ecuitem->connection);
+        }
+
+        if (outputfile.isOpen())
+            writeReceivedBatch(batch);
+
+        /* analyse received messages, check if DLT control message response */
+        for(int num = 0; num < batch.size(); num++)
+        {
+            if(!(batch.flags.at(num) & DltReceivedBatch::FlagControlResponse))
+                continue;
+
+            /* the ECU could be deleted after the message was received */
+            for(int numecu = 0; numecu < project.ecu->topLevelItemCount (); numecu++)
             {
-                read(ecuitem);
+                EcuItem *ecuitem = (EcuItem*)project.ecu->topLevelItem(numecu);
+                if(ecuitem->connection == batch.connections.at(num))
+                {
+                    QDltMsg qmsg;
+                    qmsg.setMsg(batch.getMsg(num));
+                    controlMessage_ReceiveControlMessage(ecuitem,qmsg);
+                    break;
+                }
             }
         }
-        dltIndexer->unlock();
     }
 }
 
-void MainWindow::read(EcuItem* ecuitem)
+void MainWindow::recordCommitted()
 {
-    int32_t bytesRcvd = 0;
-    QDltMsg qmsg;
+    QList<QByteArray> bufs;
+    qint64 committed = recordWriter->committedSize();
+    qint64 oldsize = qfile.size();
 
-    if (!ecuitem)
-        return;
+    /* the indexer finds the messages written while it is running, see reloadLogFileFinishFilter() */
+    bool handOver = outputfile.isOpen() && !dltIndexer->isRunning() &&
+            qfile.getFileName(qfile.getNumberOfFiles()-1) == outputfile.fileName();
 
-    QByteArray data;
-    if(ecuitem->interfacetype == EcuItem::INTERFACETYPE_TCP || ecuitem->interfacetype == EcuItem::INTERFACETYPE_UDP)
+    /* add the written messages to the index without reading the DLT file again */
+    bool missing = false;
+    while(!liveMsgs.isEmpty() && liveMsgs.first().first + liveMsgs.first().second.size() <= committed)
     {
-        /* TCP or UDP */
-        // bytesRcvd = ecuitem->socket->bytesAvailable();
-        data = ecuitem->socket->readAll();
-        bytesRcvd = data.size();
-        ecuitem->ipcon.add(data);
-     }
-    else if(ecuitem->m_serialport)
-    {
-        /* serial */
-        // bytesRcvd = ecuitem->m_serialport->bytesAvailable();
-        data = ecuitem->m_serialport->readAll();
-        bytesRcvd = data.size();
-        ecuitem->serialcon.add(data);
+        QPair<qint64,QByteArray> live = liveMsgs.takeFirst();
+        if(!handOver || missing)
+            continue;
+        if(qfile.appendMsg(live.first,live.second) >= 0)
+            bufs.append(live.second);
+        else
+            missing = true;
     }
 
-    /* reading data; new data is added to the current buffer */
-    if (bytesRcvd>0)
-    {
-
-        ecuitem->totalBytesRcvd += bytesRcvd;
+    /* messages in between are not in the index, e.g. written while the indexer was finishing */
+    if(missing)
+        qfile.updateIndex();
 
-        while(((ecuitem->interfacetype == EcuItem::INTERFACETYPE_TCP || ecuitem->interfacetype == EcuItem::INTERFACETYPE_UDP) && ecuitem->ipcon.parse(qmsg)) ||
-              (ecuitem->interfacetype == EcuItem::INTERFACETYPE_SERIAL && ecuitem->serialcon.parse(qmsg)))
-        {
+    /* update DLT message list view */
+    if(oldsize != qfile.size())
+        updateIndexMsgs(oldsize,bufs);
+}
 
+void MainWindow::writeReceivedBatch(const DltReceivedBatch &batch)
+{
+    bool pluginsEnabled = dltIndexer->getPluginsEnabled();
+    bool loggingOnly = ( settings->loggingOnlyMode == 1 ) && ( pluginsEnabled == true );
+    qint64 maxFileSize = ((qint64)settings->maxFileSizeMB)*1000*1000;
+    QList<int> written;
 
-            DltStorageHeader str;
-            str.pattern[0]='D';
-            str.pattern[1]='L';
-            str.pattern[2]='T';
-            str.pattern[3]=0x01;
+    qint64 fileSize = recordWriter->size();
 
-            /* get time of day */
-            #if defined(_MSC_VER)
-                time_t today;
-                time(&today);
-                str.seconds = (time_t)today;
-                str.microseconds = 0;
-            #else
-                struct timeval tv;
-                gettimeofday(&tv, NULL);
-                str.seconds = (time_t)tv.tv_sec; /* value is long */
-                str.microseconds = (int32_t)tv.tv_usec; /* value is long */
-            #endif
+    /* consecutive messages are appended at once */
+    int first = 0;
+    int firstOffset = 0;
+    for(int num = 0; num <= batch.size(); num++)
+    {
+        bool skip = false;
+        bool split = false;
 
-            QDateTime time = QDateTime::currentDateTime();
-            str.ecu[0]=0;
-            str.ecu[1]=0;
-            str.ecu[2]=0;
-            str.ecu[3]=0;
-            /* prepare storage header */
-            if (!qmsg.getEcuid().isEmpty())
-               dlt_set_id(str.ecu,qmsg.getEcuid().toLatin1());
-            else
-                dlt_set_id(str.ecu,ecuitem->id.toLatin1());
+        if(num < batch.size())
+        {
+            skip = (batch.flags.at(num) & DltReceivedBatch::FlagControl) && !settings->writeControl;
+            split = settings->maxFileSizeMB && (fileSize + batch.msgOffset(num) - firstOffset + batch.msgSize(num)) > maxFileSize;
+        }
 
-            /* check if message is matching the filter */
-            if (outputfile.isOpen())
+        if(num == batch.size() || skip || split)
+        {
+            // write data into file
+            int length = (num < batch.size() ? batch.msgOffset(num) : batch.data.size()) - firstOffset;
+            if(num > first)
             {
+                qint64 position = recordWriter->append(batch.data.constData() + firstOffset, length);
+                fileSize += length;
 
-                if ((settings->writeControl && (qmsg.getType()==QDltMsg::DltTypeControl)) || (!(qmsg.getType()==QDltMsg::DltTypeControl)))
-                {
-                    // https://bugreports.qt-project.org/browse/QTBUG-26069
-                    outputfile.seek(outputfile.size());
-                    QByteArray bufferHeader = qmsg.getHeader();
-                    QByteArray bufferPayload = qmsg.getPayload();
+                // the messages are added to the index when they are written
+                for(int numwritten = first; position >= 0 && numwritten < num; numwritten++)
+                    liveMsgs.append(qMakePair(position + batch.msgOffset(numwritten) - firstOffset, batch.getMsg(numwritten)));
+            }
+            first = num + (skip ? 1 : 0);
+            firstOffset = (num < batch.size() ? batch.msgOffset(num) : batch.data.size()) + (skip ? batch.msgSize(num) : 0);
+        }
 
-                    // set start time when writing first data
-                    if(startLoggingDateTime.isNull())
-                        startLoggingDateTime = QDateTime::currentDateTime();
+        if(num == batch.size() || skip)
+            continue;
 
-                    // check if files size limit reached
-                    if(settings->maxFileSizeMB && ((outputfile.size()+sizeof(DltStorageHeader)+bufferHeader.size()+bufferPayload.size())>(((size_t)settings->maxFileSizeMB)*1000*1000)))
-                    {
-                        // get new filename
-                        QFileInfo info(outputfile.fileName());
-                        QString newFilename = info.baseName()+
-                                (startLoggingDateTime.toString("__yyyyMMdd_hhmmss"))+
-                                (QDateTime::currentDateTime().toString("__yyyyMMdd_hhmmss"))+
-                                QString(".dlt");
-                        QFileInfo infoNew(info.absolutePath(),newFilename);
-
-                        // rename old file
-                       outputfile.copy(outputfile.fileName(),infoNew.absoluteFilePath());
-
-                        // set new start time
-                        startLoggingDateTime = QDateTime::currentDateTime();
-
-                        // create new file
-                        on_New_triggered(info.absoluteFilePath());
-                    }
+        // set start time when writing first data
+        if(startLoggingDateTime.isNull())
+            startLoggingDateTime = QDateTime::currentDateTime();
 
-                    // write datat into file
-                    outputfile.write((char*)&str,sizeof(DltStorageHeader));
-                    outputfile.write(bufferHeader);
-                    outputfile.write(bufferPayload);
+        // check if files size limit reached
+        if(split)
+        {
+            // get new filename
+            QFileInfo info(outputfile.fileName());
+            QString newFilename = info.baseName()+
+                    (startLoggingDateTime.toString("__yyyyMMdd_hhmmss"))+
+                    (QDateTime::currentDateTime().toString("__yyyyMMdd_hhmmss"))+
+                    QString(".dlt");
+            QFileInfo infoNew(info.absolutePath(),newFilename);
 
-                    outputfile.flush();
+            // rename old file
+            recordWriter->close();
+            outputfile.copy(outputfile.fileName(),infoNew.absoluteFilePath());
 
-                    /* in Logging only mode send all message to plugins */
-                    bool pluginsEnabled = dltIndexer->getPluginsEnabled();
-                    if( ( settings->loggingOnlyMode == 1 ) && ( pluginsEnabled == true ) )
-                    {
-                        QList<QDltPlugin*> activeViewerPlugins;
-                        activeViewerPlugins = pluginManager.getViewerPlugins();
-                        for(int i = 0; i < activeViewerPlugins.size(); i++){
-                            QDltPlugin *item = (QDltPlugin*)activeViewerPlugins.at(i);
-                            item->updateMsg(-1,qmsg);
-                            pluginManager.decodeMsg(qmsg,!OptManager::getInstance()->issilentMode());
-                            item->updateMsgDecoded(-1,qmsg);
-                        }
-                    }
-                }
-            }
+            // set new start time
+            startLoggingDateTime = QDateTime::currentDateTime();
 
-            /* analyse received message, check if DLT control message response */
-            if ( (qmsg.getType()==QDltMsg::DltTypeControl) && (qmsg.getSubtype()==QDltMsg::DltControlResponse))
-            {
-                controlMessage_ReceiveControlMessage(ecuitem,qmsg);
-            }
+            // create new file
+            on_New_triggered(info.absoluteFilePath());
+            fileSize = recordWriter->size();
         }
 
-        if(ecuitem->interfacetype == EcuItem::INTERFACETYPE_TCP || ecuitem->interfacetype == EcuItem::INTERFACETYPE_UDP)
-        {
-            /* TCP or UDP */
-            totalByteErrorsRcvd+=ecuitem->ipcon.bytesError;
-            ecuitem->ipcon.bytesError = 0;
-            totalBytesRcvd+=ecuitem->ipcon.bytesReceived;
-            ecuitem->ipcon.bytesReceived = 0;
-            totalSyncFoundRcvd+=ecuitem->ipcon.syncFound;
-            ecuitem->ipcon.syncFound = 0;
-         }
-        else if(ecuitem->m_serialport)
-        {
-            /* serial */
-            totalByteErrorsRcvd+=ecuitem->serialcon.bytesError;
-            ecuitem->serialcon.bytesError = 0;
-            totalBytesRcvd+=ecuitem->serialcon.bytesReceived;
-            ecuitem->serialcon.bytesReceived = 0;
-            totalSyncFoundRcvd+=ecuitem->serialcon.syncFound;
-            ecuitem->serialcon.syncFound = 0;
-        }
+        written.append(num);
+    }
 
-        if (outputfile.isOpen() )
-        {
-            if(!dltIndexer->isRunning())
-                updateIndex();
+    /* in Logging only mode send all message to plugins */
+    if(loggingOnly)
+    {
+        QList<QDltPlugin*> activeViewerPlugins;
+        activeViewerPlugins = pluginManager.getViewerPlugins();
+        for(int numwritten = 0; numwritten < written.size(); numwritten++)
+        {
+            QDltMsg qmsg;
+            qmsg.setMsg(batch.getMsg(written.at(numwritten)));
+            for(int i = 0; i < activeViewerPlugins.size(); i++){
+                QDltPlugin *item = (QDltPlugin*)activeViewerPlugins.at(i);
+                item->updateMsg(-1,qmsg);
+                pluginManager.decodeMsg(qmsg,!OptManager::getInstance()->issilentMode());
+                item->updateMsgDecoded(-1,qmsg);
+            }
         }
     }
 }
 
 void MainWindow::updateIndex()
 {
+    /* read received messages in DLT file parser and update DLT message list view */
+    /* update indexes  and table view */
+    qint64 oldsize = qfile.size();
+    qfile.updateIndex();
+
+    updateIndexMsgs(oldsize,QList<QByteArray>());
+}
+
+void MainWindow::updateIndexMsgs(qint64 oldsize, const QList<QByteArray> &bufs)
+{
+    /* bufs contains the new messages, if they are already available, otherwise they are read from the DLT file */
     QList<QDltPlugin*> activeViewerPlugins;
     QList<QDltPlugin*> activeDecoderPlugins;
     QDltPlugin *item = 0;
@@ -3266,11 +3240,6 @@ void MainWindow::updateIndex()
     activeViewerPlugins = pluginManager.getViewerPlugins();
     bool pluginsEnabled = dltIndexer->getPluginsEnabled();
 
-    /* read received messages in DLT file parser and update DLT message list view */
-    /* update indexes  and table view */
-    int oldsize = qfile.size();
-    qfile.updateIndex();
-
     bool silentMode = !OptManager::getInstance()->issilentMode();
 
     if(oldsize!=qfile.size())
@@ -3283,9 +3252,13 @@ void MainWindow::updateIndex()
         }
     }
 
-    for(int num=oldsize;num<qfile.size();num++)
+    qint64 newsize = qfile.size();
+    for(qint64 num=oldsize;num<newsize;num++)
     {
-        qmsg.setMsg(qfile.getMsg(num));
+        if(num-oldsize < bufs.size())
+            qmsg.setMsg(bufs.at(num-oldsize));
+        else
+            qmsg.setMsg(qfile.getMsg(num));
 
         for(int i = 0; i < activeViewerPlugins.size(); i++){
             item = activeViewerPlugins.at(i);
@@ -3341,6 +3314,8 @@ void MainWindow::drawUpdatedView()
     //Line below would resize the payload column automatically so that the whole content is readable
     //ui->tableView->resizeColumnToContents(11); //Column 11 is the payload column
     if(settings->autoScroll) {
+        // follow the last message, if it is beyond the current page
+        tableModel->showFilterIndex(qfile.sizeFilter()-1);
         ui->tableView->scrollToBottom();
     }
 
@@ -3365,13 +3340,13 @@ void MainWindow::on_tableView_selectionChanged(const QItemSelection & selected,
         QList<QDltPlugin*> activeViewerPlugins;
         QList<QDltPlugin*> activeDecoderPlugins;
         QDltMsg msg;
-        int msgIndex;
+        qint64 msgIndex;
 
         //scroll manually because autoscroll is off
         ui->tableView->scrollTo(index);
 
-        msgIndex = qfile.getMsgFilterPos(index.row());
-        msg.setMsg(qfile.getMsgFilter(index.row()));
+        msgIndex = qfile.getMsgFilterPos(tableModel->filterIndex(index.row()));
+        msg.setMsg(qfile.getMsgFilter(tableModel->filterIndex(index.row())));
         activeViewerPlugins = pluginManager.getViewerPlugins();
         activeDecoderPlugins = pluginManager.getDecoderPlugins();
 
@@ -3614,7 +3589,7 @@ void MainWindow::controlMessage_SendControlMessage(EcuItem* ecuitem,DltMessage &
 
     /* prepare storage header */
     msg.storageheader = (DltStorageHeader*)msg.headerbuffer;
-    dlt_set_storageheader(msg.storageheader,ecuitem->id.toLatin1());
+    dlt_set_storageheader(msg.storageheader,ecuitem->id.toString().toLatin1());
 
     /* prepare standard header */
     msg.standardheader = (DltStandardHeader*)(msg.headerbuffer + sizeof(DltStorageHeader));
@@ -3627,7 +3602,7 @@ void MainWindow::controlMessage_SendControlMessage(EcuItem* ecuitem,DltMessage &
     msg.standardheader->mcnt = 0;
 
     /* Set header extra parameters */
-    dlt_set_id(msg.headerextra.ecu,ecuitem->id.toLatin1());
+    dlt_set_id(msg.headerextra.ecu,ecuitem->id.toString().toLatin1());
     msg.headerextra.tmsp = dlt_uptime();
 
     /* Copy header extra parameters to headerbuffer */
@@ -3658,30 +3633,26 @@ void MainWindow::controlMessage_SendControlMessage(EcuItem* ecuitem,DltMessage &
     msg.headersize = sizeof(DltStorageHeader) + sizeof(DltStandardHeader) + sizeof(DltExtendedHeader) + DLT_STANDARD_HEADER_EXTRA_SIZE(msg.standardheader->htyp);
     msg.standardheader->len = DLT_HTOBE_16(msg.headersize - sizeof(DltStorageHeader) + msg.datasize);
 
-    /* send message to daemon */
-    if ((ecuitem->interfacetype == EcuItem::INTERFACETYPE_TCP || ecuitem->interfacetype == EcuItem::INTERFACETYPE_UDP) && ecuitem->socket->isOpen())
+    /* send message to daemon, the data is written by the receive thread */
+    if (ecuitem->connection && ecuitem->connected)
     {
         QByteArray tmpBuf;
+        bool sendSerialHeader;
+
+        if (ecuitem->interfacetype == EcuItem::INTERFACETYPE_SERIAL)
+            sendSerialHeader = ecuitem->getSendSerialHeaderSerial();
+        else
+            sendSerialHeader = ecuitem->getSendSerialHeaderIp();
 
         /* Optional: Send serial header, if requested */
-        if (ecuitem->getSendSerialHeaderIp())
+        if (sendSerialHeader)
             tmpBuf.append((const char*)dltSerialHeader, sizeof(dltSerialHeader));
 
         /* Send data */
         tmpBuf.append((const char*)msg.headerbuffer+sizeof(DltStorageHeader),msg.headersize-sizeof(DltStorageHeader));
         tmpBuf.append((const char*)msg.databuffer,msg.datasize);
 
-        ecuitem->socket->write(tmpBuf);
-    }
-    else if (ecuitem->interfacetype == EcuItem::INTERFACETYPE_SERIAL && ecuitem->m_serialport && ecuitem->m_serialport->isOpen())
-    {
-        /* Optional: Send serial header, if requested */
-        if (ecuitem->getSendSerialHeaderSerial())
-            ecuitem->m_serialport->write((const char*)dltSerialHeader,sizeof(dltSerialHeader));
-
-        /* Send data */
-        ecuitem->m_serialport->write((const char*)msg.headerbuffer+sizeof(DltStorageHeader),msg.headersize-sizeof(DltStorageHeader));
-        ecuitem->m_serialport->write((const char*)msg.databuffer,msg.datasize);
+        ecuitem->connection->send(tmpBuf);
     }
     else
     {
@@ -3689,28 +3660,17 @@ void MainWindow::controlMessage_SendControlMessage(EcuItem* ecuitem,DltMessage &
         return;
     }
 
-    /* Skip the file handling, if indexer is working on the file */
-    if(dltIndexer->tryLock())
+    /* store ctrl message in log file, the index is updated when it is written */
+    if (outputfile.isOpen())
     {
-        /* store ctrl message in log file */
-        if (outputfile.isOpen())
+        if (settings->writeControl)
         {
-            if (settings->writeControl)
-            {
-                // https://bugreports.qt-project.org/browse/QTBUG-26069
-                outputfile.seek(outputfile.size());
-                outputfile.write((const char*)msg.headerbuffer,msg.headersize);
-                outputfile.write((const char*)msg.databuffer,msg.datasize);
-                outputfile.flush();
-            }
+            QByteArray buf((const char*)msg.headerbuffer,msg.headersize);
+            buf.append((const char*)msg.databuffer,msg.datasize);
+            qint64 position = recordWriter->append(buf);
+            if(position >= 0)
+                liveMsgs.append(qMakePair(position,buf));
         }
-
-        /* read received messages in DLT file parser and update DLT message list view */
-        /* update indexes  and table view */
-        if(!dltIndexer->isRunning())
-            updateIndex();
-
-        dltIndexer->unlock();
     }
 }
 
@@ -3765,28 +3725,17 @@ void MainWindow::controlMessage_WriteControlMessage(DltMessage &msg, QString app
     msg.headersize = sizeof(DltStorageHeader) + sizeof(DltStandardHeader) + sizeof(DltExtendedHeader) + DLT_STANDARD_HEADER_EXTRA_SIZE(msg.standardheader->htyp);
     msg.standardheader->len = DLT_HTOBE_16(msg.headersize - sizeof(DltStorageHeader) + msg.datasize);
 
-    /* Skip the file handling, if indexer is working on the file */
-    if(dltIndexer->tryLock())
+    /* store ctrl message in log file, the index is updated when it is written */
+    if (outputfile.isOpen())
     {
-        /* store ctrl message in log file */
-        if (outputfile.isOpen())
+        if (settings->writeControl)
         {
-            if (settings->writeControl)
-            {
-                // https://bugreports.qt-project.org/browse/QTBUG-26069
-                outputfile.seek(outputfile.size());
-                outputfile.write((const char*)msg.headerbuffer,msg.headersize);
-                outputfile.write((const char*)msg.databuffer,msg.datasize);
-                outputfile.flush();
-            }
+            QByteArray buf((const char*)msg.headerbuffer,msg.headersize);
+            buf.append((const char*)msg.databuffer,msg.datasize);
+            qint64 position = recordWriter->append(buf);
+            if(position >= 0)
+                liveMsgs.append(qMakePair(position,buf));
         }
-
-        /* read received messages in DLT file parser and update DLT message list view */
-        /* update indexes  and table view */
-        if(!dltIndexer->isRunning())
-            updateIndex();
-
-        dltIndexer->unlock();
     }
 }
 
@@ -3838,8 +3787,8 @@ void MainWindow::on_action_menuDLT_Set_Log_Level_triggered()
         EcuItem* ecuitem = (EcuItem*) appitem->parent();
 
         /* send set log level and trace status request */
-        controlMessage_SetLogLevel(ecuitem,appitem->id,conitem->id,conitem->loglevel);
-        controlMessage_SetTraceStatus(ecuitem,appitem->id,conitem->id,conitem->tracestatus);
+        controlMessage_SetLogLevel(ecuitem,appitem->id.toString(),conitem->id.toString(),conitem->loglevel);
+        controlMessage_SetTraceStatus(ecuitem,appitem->id.toString(),conitem->id.toString(),conitem->tracestatus);
 
         /* update status */
         conitem->status = ContextItem::valid;
@@ -3856,8 +3805,8 @@ void MainWindow::on_action_menuDLT_Set_Log_Level_triggered()
                 EcuItem* ecuitem = (EcuItem*) appitem->parent();
 
                 /* send set log level and trace status request */
-                controlMessage_SetLogLevel(ecuitem,appitem->id,conitem->id,conitem->loglevel);
-                controlMessage_SetTraceStatus(ecuitem,appitem->id,conitem->id,conitem->tracestatus);
+                controlMessage_SetLogLevel(ecuitem,appitem->id.toString(),conitem->id.toString(),conitem->loglevel);
+                controlMessage_SetTraceStatus(ecuitem,appitem->id.toString(),conitem->id.toString(),conitem->tracestatus);
 
                 /* update status */
                 conitem->status = ContextItem::valid;
@@ -3889,8 +3838,8 @@ void MainWindow::on_action_menuDLT_Set_All_Log_Levels_triggered()
                 ContextItem * conitem = (ContextItem *) appitem->child(numcontext);
 
                 /* set log level and trace status of this context */
-                controlMessage_SetLogLevel(ecuitem,appitem->id,conitem->id,conitem->loglevel);
-                controlMessage_SetTraceStatus(ecuitem,appitem->id,conitem->id,conitem->tracestatus);
+                controlMessage_SetLogLevel(ecuitem,appitem->id.toString(),conitem->id.toString(),conitem->loglevel);
+                controlMessage_SetTraceStatus(ecuitem,appitem->id.toString(),conitem->id.toString(),conitem->tracestatus);
 
                 /* update status */
                 conitem->status = ContextItem::valid;
@@ -4400,12 +4349,12 @@ void MainWindow::on_action_menuDLT_Send_Injection_triggered()
 
         if(conitem)
         {
-            dlg.setApplicationId(appitem->id);
-            dlg.setContextId(conitem->id);
+            dlg.setApplicationId(appitem->id.toString());
+            dlg.setContextId(conitem->id.toString());
         }
         else if(appitem)
         {
-            dlg.setApplicationId(appitem->id);
+            dlg.setApplicationId(appitem->id.toString());
             dlg.setContextId(injectionContextId);
         }
         else
@@ -4442,7 +4391,7 @@ void MainWindow::controlMessage_SetApplication(EcuItem *ecuitem, QString apid, Q
     {
         ApplicationItem * appitem = (ApplicationItem *) ecuitem->child(numapp);
 
-        if(appitem->id == apid)
+        if(appitem->id == QDltId(apid))
         {
             appitem->description = appdescription;
             appitem->update();
@@ -4453,7 +4402,7 @@ void MainWindow::controlMessage_SetApplication(EcuItem *ecuitem, QString apid, Q
 
     /* No app and no con found */
     ApplicationItem* appitem = new ApplicationItem(ecuitem);
-    appitem->id = apid;
+    appitem->id = QDltId(apid);
     appitem->description = appdescription;
     appitem->update();
     ecuitem->addChild(appitem);
@@ -4470,7 +4419,7 @@ void MainWindow::controlMessage_SetContext(EcuItem *ecuitem, QString apid, QStri
         {
             ContextItem * conitem = (ContextItem *) appitem->child(numcontext);
 
-            if(appitem->id == apid && conitem->id == ctid)
+            if(appitem->id == QDltId(apid) && conitem->id == QDltId(ctid))
             {
                 /* set new log level and trace status */
                 conitem->loglevel = log_level;
@@ -4488,11 +4437,11 @@ void MainWindow::controlMessage_SetContext(EcuItem *ecuitem, QString apid, QStri
     {
         ApplicationItem * appitem = (ApplicationItem *) ecuitem->child(numapp);
 
-        if(appitem->id == apid)
+        if(appitem->id == QDltId(apid))
         {
             /* Add new context */
             ContextItem* conitem = new ContextItem(appitem);
-            conitem->id = ctid;
+            conitem->id = QDltId(ctid);
             conitem->loglevel = log_level;
             conitem->tracestatus = trace_status;
             conitem->description = ctdescription;
@@ -4506,12 +4455,12 @@ void MainWindow::controlMessage_SetContext(EcuItem *ecuitem, QString apid, QStri
 
     /* No app and no con found */
     ApplicationItem* appitem = new ApplicationItem(ecuitem);
-    appitem->id = apid;
+    appitem->id = QDltId(apid);
     appitem->description = QString("");
     appitem->update();
     ecuitem->addChild(appitem);
     ContextItem* conitem = new ContextItem(appitem);
-    conitem->id = ctid;
+    conitem->id = QDltId(ctid);
     conitem->loglevel = log_level;
     conitem->tracestatus = trace_status;
     conitem->description = ctdescription;
@@ -4539,7 +4488,7 @@ void MainWindow::controlMessage_UnregisterContext(QString ecuId,QString appId,QS
     for(int num = 0; num < project.ecu->topLevelItemCount (); num++)
     {
         EcuItem *ecuitem = (EcuItem*)project.ecu->topLevelItem(num);
-        if(ecuitem->id == ecuId)
+        if(ecuitem->id == QDltId(ecuId))
         {
             ecuitemFound = ecuitem;
             break;
@@ -4558,7 +4507,7 @@ void MainWindow::controlMessage_UnregisterContext(QString ecuId,QString appId,QS
         {
             ContextItem * conitem = (ContextItem *) appitem->child(numcontext);
 
-            if(appitem->id == appId && conitem->id == ctId)
+            if(appitem->id == QDltId(appId) && conitem->id == QDltId(ctId))
             {
                 /* remove context */
                 delete conitem->parent()->takeChild(conitem->parent()->indexOfChild(conitem));
@@ -4933,54 +4882,20 @@ void MainWindow::sendUpdates(EcuItem* ecuitem)
 
 }
 
-void MainWindow::stateChangedSerial(bool dsrChanged){
-    /* signal emited when connection state changed */
-
-    /* find socket which emited signal */
-    for(int num = 0; num < project.ecu->topLevelItemCount (); num++)
-    {
-        EcuItem *ecuitem = (EcuItem*)project.ecu->topLevelItem(num);
-        if( ecuitem->m_serialport == sender())
-        {
-            /* update ECU item */
-            ecuitem->update();
-
-            if(dsrChanged)
-            {
-                /* send new default log level to ECU, if selected in dlg */
-                if (ecuitem->updateDataIfOnline)
-                {
-                    sendUpdates(ecuitem);
-                }
-            }
-
-            if(dsrChanged)
-            {
-                pluginManager.stateChanged(num,QDltConnection::QDltConnectionOnline,ecuitem->getHostname());
-            }
-            else
-            {
-                pluginManager.stateChanged(num,QDltConnection::QDltConnectionOffline,ecuitem->getHostname());
-            }
-
-        }
-    }
-}
-
-void MainWindow::stateChangedTCP(QAbstractSocket::SocketState socketState)
+void MainWindow::stateChanged(int state)
 {
     /* signal emited when connection state changed */
 
-    /* find socket which emited signal */
+    /* find connection which emited signal */
     for(int num = 0; num < project.ecu->topLevelItemCount (); num++)
     {
         EcuItem *ecuitem = (EcuItem*)project.ecu->topLevelItem(num);
-        if( ecuitem && ecuitem->socket == sender())
+        if( ecuitem && ecuitem->connection == sender())
         {
             /* update ECU item */
             ecuitem->update();
 
-            if (socketState==QAbstractSocket::ConnectedState)
+            if (state==QDltConnection::QDltConnectionOnline)
             {
                 /* send new default log level to ECU, if selected in dlg */
                 if (ecuitem->updateDataIfOnline)
@@ -4989,23 +4904,7 @@ void MainWindow::stateChangedTCP(QAbstractSocket::SocketState socketState)
                 }
             }
 
-            switch(socketState){
-            case QAbstractSocket::UnconnectedState:
-                pluginManager.stateChanged(num,QDltConnection::QDltConnectionOffline,ecuitem->getHostname());
-                break;
-            case QAbstractSocket::ConnectingState:
-                pluginManager.stateChanged(num,QDltConnection::QDltConnectionConnecting,ecuitem->getHostname());
-                break;
-            case QAbstractSocket::ConnectedState:
-                pluginManager.stateChanged(num,QDltConnection::QDltConnectionOnline,ecuitem->getHostname());
-                break;
-            case QAbstractSocket::ClosingState:
-                pluginManager.stateChanged(num,QDltConnection::QDltConnectionOffline,ecuitem->getHostname());
-                break;
-            default:
-                pluginManager.stateChanged(num,QDltConnection::QDltConnectionOffline,ecuitem->getHostname());
-                break;
-            }
+            pluginManager.stateChanged(num,(QDltConnection::QDltConnectionState)state,ecuitem->getHostname());
         }
     }
 }
@@ -5060,6 +4959,7 @@ void MainWindow::loadPlugins()
         item->dockWidget->setFeatures(QDockWidget::DockWidgetClosable | QDockWidget::DockWidgetMovable | QDockWidget::DockWidgetFloatable);
         item->dockWidget->setWidget(item->widget);
         item->dockWidget->setObjectName(plugin->getName());
+        connect(item->dockWidget, SIGNAL(visibilityChanged(bool)), this, SLOT(pluginDockVisibilityChanged(bool)));
 
         addDockWidget(Qt::LeftDockWidgetArea, item->dockWidget);
 
@@ -5074,6 +4974,9 @@ void MainWindow::loadPlugins()
 
     }
 
+    /* messages are decoded with the enabled decoder plugins */
+    pluginManager.updateDecoderConfiguration();
+
     /* initialise control interface */
     qcontrol.silentmode = OptManager::getInstance()->issilentMode();
     qcontrol.commandlinemode = OptManager::getInstance()->isCommandlineMode();
@@ -5088,7 +4991,7 @@ void MainWindow::updatePluginsECUList()
     {
         EcuItem *ecuitem = (EcuItem*)project.ecu->topLevelItem(num);
 
-        list.append(ecuitem->id + " (" + ecuitem->description + ")");
+        list.append(ecuitem->id.toString() + " (" + ecuitem->description + ")");
     }
     pluginManager.initConnections(list);
 }
@@ -5106,7 +5009,11 @@ void MainWindow::updatePlugin(PluginItem *item)
 {
     item->takeChildren();
 
+    /* messages decoded with the old configuration are not valid anymore */
+    qfile.getMsgCache().clear();
+
     bool ret = item->getPlugin()->loadConfig(item->getFilename());
+    pluginManager.updateDecoderConfiguration();
     QString err_text = item->getPlugin()->error();
     //We should not need error handling when disabling the plugins. But why is loadConfig called then anyway?
     if (item->getMode() != QDltPlugin::ModeDisable)
@@ -5204,6 +5111,7 @@ void MainWindow::pluginsAutoload(QString version)
                     // load new configuration
                     item->setFilename(filename);
                     item->getPlugin()->loadConfig(filename);
+                    pluginManager.updateDecoderConfiguration();
                     item->update();
                 }
                 else
@@ -5366,6 +5274,14 @@ void MainWindow::on_action_menuPlugin_Disable_triggered()
                              QString("No Plugin selected!"));
 }
 
+void MainWindow::pluginDockVisibilityChanged(bool visible)
+{
+    Q_UNUSED(visible);
+
+    /* closing the dock widget disables the plugin */
+    pluginManager.updateDecoderConfiguration();
+}
+
 //----------------------------------------------------------------------------
 // Filter functionalities
 //----------------------------------------------------------------------------
@@ -5392,7 +5308,7 @@ void MainWindow::filterAddTable() {
         }
     }
 
-    data = qfile.getMsgFilter(index.row());
+    data = qfile.getMsgFilter(tableModel->filterIndex(index.row()));
     msg.setMsg(data);
 
     /* decode message if necessary */
@@ -5446,19 +5362,19 @@ void MainWindow::filterAdd() {
     if(ecuitem)
     {
         dlg.setEnableEcuId(true);
-        dlg.setEcuId(ecuitem->id);
+        dlg.setEcuId(ecuitem->id.toString());
     }
 
     if(appitem)
     {
         dlg.setEnableApplicationId(true);
-        dlg.setApplicationId(appitem->id);
+        dlg.setApplicationId(appitem->id.toString());
     }
 
     if(conitem)
     {
         dlg.setEnableContextId(true);
-        dlg.setContextId(conitem->id);
+        dlg.setContextId(conitem->id.toString());
     }
 
     if(dlg.exec()==1) {
@@ -6021,7 +5937,7 @@ void MainWindow::on_action_menuFilter_Append_Filters_triggered()
     openDlfFile(fileName,false);
 }
 
-int MainWindow::nearest_line(int line){
+qint64 MainWindow::nearest_line(qint64 line){
 
     if (line < 0 || line > qfile.size()-1){
         return -1;
@@ -6029,7 +5945,7 @@ int MainWindow::nearest_line(int line){
 
     // If filters are off, just go directly to the row
     // If filters are enabled and no search result are matched, jump to beginning
-    int row = 0;
+    qint64 row = 0;
     if(!qfile.isFilter())
     {
         row = line;
@@ -6039,8 +5955,9 @@ int MainWindow::nearest_line(int line){
         /* Iterate through filter index, trying to find
          * matching index. If it cannot be found, just settle
          * for the last one that we saw before going over */
-        int lastFound = 0;
-        for(int i=0;i<qfile.sizeFilter();i++)
+        qint64 lastFound = 0;
+        qint64 count = qfile.sizeFilter();
+        for(qint64 i=0;i<count;i++)
         {
             if(qfile.getMsgFilterPos(i) == line)
             {
@@ -6069,7 +5986,7 @@ int MainWindow::nearest_line(int line){
     return row;
 }
 
-void MainWindow::jumpToMsgSignal(int index)
+void MainWindow::jumpToMsgSignal(qint64 index)
 {
     jump_to_line(index);
 }
@@ -6088,10 +6005,10 @@ void MainWindow::reopenFileSignal()
     reloadLogFile(false);
 }
 
-bool MainWindow::jump_to_line(int line)
+bool MainWindow::jump_to_line(qint64 line)
 {
 
-    int row = nearest_line(line);
+    int row = tableModel->showFilterIndex(nearest_line(line));
     int column = -1;
     if (0 > row)
         return false;
@@ -6131,8 +6048,8 @@ bool MainWindow::jump_to_line(int line)
 void MainWindow::on_actionJump_To_triggered()
 {
     JumpToDialog dlg(this);
-    int min = 0;
-    int max = qfile.size()-1;
+    qint64 min = 0;
+    qint64 max = qfile.size()-1;
     dlg.setLimits(min, max);
 
     int result = dlg.exec();
@@ -6263,7 +6180,7 @@ void MainWindow::saveSelection()
 
     for(int i=0;i<rows.count();i++)
     {
-        int sr = rows.at(i).row();
+        qint64 sr = tableModel->filterIndex(rows.at(i).row());
         previousSelection.append(qfile.getMsgFilterPos(sr));
         //qDebug() << "Save Selection " << i << " at line " << qfile.getMsgFilterPos(sr);
     }
@@ -6285,14 +6202,26 @@ void MainWindow::restoreSelection()
     // restore all selected lines
     for(int j=0;j<previousSelection.count();j++)
     {
-        int nearestIndex = nearest_line(previousSelection.at(j));
+        qint64 nearestLine = nearest_line(previousSelection.at(j));
+        int nearestIndex;
 
-        //qDebug() << "Restore Selection" << j << "at index" << nearestIndex << "at line" << previousSelection.at(0);
+        //qDebug() << "Restore Selection" << j << "at index" << nearestLine << "at line" << previousSelection.at(0);
 
         if(j==0)
         {
+            // show the page of the first selected line
+            nearestIndex = tableModel->showFilterIndex(nearestLine);
             firstIndex = nearestIndex;
         }
+        else if(nearestLine >= tableModel->getPageOffset() && nearestLine < tableModel->getPageOffset() + DLT_VIEWER_TABLE_PAGE_SIZE)
+        {
+            nearestIndex = static_cast<int>(nearestLine - tableModel->getPageOffset());
+        }
+        else
+        {
+            // selected line is not on the current page
+            continue;
+        }
 
         QModelIndex idx = tableModel->index(nearestIndex, 0);
         newSelection.select(idx, idx);
@@ -6339,7 +6268,7 @@ void MainWindow::searchtable_cellSelected( QModelIndex index)
 
     int position = index.row();
     printf("POSITION:%i\n", position);
-    unsigned long entry;
+    qint64 entry;
 
     if (! m_searchtableModel->get_SearchResultEntry(position, entry) )
         return;
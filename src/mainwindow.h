@@ -37,6 +37,8 @@
 #include "dltsettingsmanager.h"
 #include "filterdialog.h"
 #include "dltfileindexer.h"
+#include "dltreceiver.h"
+#include "dltrecordwriter.h"
 #include "workingdirectory.h"
 #include "exporterdialog.h"
 #include <QCompleter>
@@ -141,6 +143,7 @@ private:
     QLabel *statusByteErrorsReceived;
     QLabel *statusSyncFoundReceived;
     QProgressBar *statusProgressBar;
+    int statusProgressBarShift;
 
     unsigned long totalBytesRcvd;
     unsigned long totalByteErrorsRcvd;
@@ -206,6 +209,15 @@ private:
     /* dlt-file Indexer with cancel cabability */
     DltFileIndexer *dltIndexer;
 
+    /* Receive thread, parses the data read from the ECUs */
+    DltReceiver *dltReceiver;
+
+    /* Writer thread, writes the received data to the log file */
+    DltRecordWriter *recordWriter;
+
+    /* Position and data of the messages given to the writer, which are not in the index yet */
+    QList<QPair<qint64,QByteArray> > liveMsgs;
+
     /* Color for blinking 'Apply changes'-button */
     QColor pulseButtonColor;
 
@@ -271,8 +283,9 @@ private:
     void connectECU(EcuItem *ecuitem,bool force = false);
     void disconnectECU(EcuItem *ecuitem);
     void checkConnectionState();
-    void read(EcuItem *ecuitem);
+    void writeReceivedBatch(const DltReceivedBatch &batch);
     void updateIndex();
+    void updateIndexMsgs(qint64 oldsize, const QList<QByteArray> &bufs);
     void drawUpdatedView();
 
     void updateRecentFileActions();
@@ -313,8 +326,8 @@ private:
 
     void deleteactualFile();
 
-    int nearest_line(int line);
-    bool jump_to_line(int line);
+    qint64 nearest_line(qint64 line);
+    bool jump_to_line(qint64 line);
 
  /**
      * @brief ErrorMessage
@@ -327,7 +340,7 @@ private:
     void clearSelection();
     void saveSelection();
     void restoreSelection();
-    QList<int> previousSelection;
+    QList<qint64> previousSelection;
 
     /* Disconnect and Reconnect serial connections */
     QList<int> m_previouslyConnectedSerialECUs;
@@ -456,14 +469,16 @@ private slots:
     void on_action_menuPlugin_Edit_triggered();
     void action_menuPlugin_Enable_triggered();
     void on_action_menuPlugin_Disable_triggered();
+    void pluginDockVisibilityChanged(bool visible);
 
     //Rename
     void filterAdd();
     void filterAddTable();
     void connected();
     void disconnected();
-    void error(QAbstractSocket::SocketError);
-    void readyRead();
+    void error(QString errorString);
+    void receiveDataAvailable();
+    void recordCommitted();
     void timeout();
     void draw_timeout();
     void connectAll();
@@ -474,8 +489,7 @@ private slots:
     void openRecentProject();
     void openRecentFilters();
     void applyConfigEnabled(bool enabled);
-    void stateChangedTCP(QAbstractSocket::SocketState socketState);
-    void stateChangedSerial(bool dsrChanged);
+    void stateChanged(int state);
     void sectionInTableDoubleClicked(int logicalIndex);
     void on_actionJump_To_triggered();
     void on_actionAutoScroll_triggered(bool checked);
@@ -509,7 +523,7 @@ public slots:
 
     void sendInjection(int index,QString applicationId,QString contextId,int serviceId,QByteArray data);
     void filterOrderChanged();
-    void jumpToMsgSignal(int index);
+    void jumpToMsgSignal(qint64 index);
     void markerSignal();
     void connectEcuSignal(int index);
     void disconnectEcuSignal(int index);
@@ -33,10 +33,10 @@ const char *traceinfo[] = {"default","off","on"};
 
 EcuItem::EcuItem(QTreeWidgetItem *parent)
 : QTreeWidgetItem(parent,ecu_type)
-, socket(0)
+, connection(0)
 {
     /* initialise receive buffer and message*/
-    id = "ECU";
+    id = QDltId("ECU");
     description = "A new ECU";
     interfacetype = INTERFACETYPE_TCP; /* default TCP */
     hostname = "localhost";
@@ -64,44 +64,40 @@ EcuItem::EcuItem(QTreeWidgetItem *parent)
 
     status = EcuItem::unknown;
 
-    m_serialport = 0;
-
-    /* Limit size of socket receiption buffer to limit application buffer size */
-    /* qt sets buffer normally to unlimited */
-    //socket.setReadBufferSize(64000);
-
     autoReconnectTimestamp = QDateTime::currentDateTime();
 }
 
 EcuItem::~EcuItem()
 {
-
+    /* the connection lives in the receive thread */
+    if(connection)
+        connection->deleteLater();
 }
 
 void EcuItem::update()
 {
     if(tryToConnect & connected)
     {
-        setData(0,Qt::DisplayRole,id + " online");
+        setData(0,Qt::DisplayRole,id.toString() + " online");
         setBackground(0,QBrush(QColor(Qt::green)));
     }
     else if(tryToConnect & !connected)
     {
         if(connectError.isEmpty())
         {
-            setData(0,Qt::DisplayRole,id + " connect");
+            setData(0,Qt::DisplayRole,id.toString() + " connect");
             setBackground(0,QBrush(QColor(Qt::yellow)));
         }
         else
         {
-            setData(0,Qt::DisplayRole,id + " connect ["+connectError+"]");
+            setData(0,Qt::DisplayRole,id.toString() + " connect ["+connectError+"]");
             setBackground(0,QBrush(QColor(Qt::red)));
         }
 
     }
     else
     {
-        setData(0,Qt::DisplayRole,id + " offline");
+        setData(0,Qt::DisplayRole,id.toString() + " offline");
         setBackground(0,QBrush(QColor(Qt::white)));
     }
 
@@ -109,15 +105,12 @@ void EcuItem::update()
     {
         case EcuItem::INTERFACETYPE_TCP:
             setData(1,Qt::DisplayRole,QString("%1 [%2:%3]").arg(description).arg(hostname).arg(ipport));
-            socket = & tcpsocket;
             break;
         case EcuItem::INTERFACETYPE_UDP:
             setData(1,Qt::DisplayRole,QString("%1 [%2:%3]").arg(description).arg(hostname).arg(ipport));
-            socket = & udpsocket;
             break;
         case EcuItem::INTERFACETYPE_SERIAL:
             setData(1,Qt::DisplayRole,QString("%1 [%2]").arg(description).arg(port));
-            socket = 0;
             break;
     }
 
@@ -213,7 +206,7 @@ ApplicationItem::~ApplicationItem()
 
 void ApplicationItem::update()
 {
-    setData(0,0,id);
+    setData(0,0,id.toString());
     setData(1,0,description);
 }
 
@@ -252,7 +245,7 @@ ContextItem::~ContextItem()
 
 void ContextItem::update()
 {
-    setData(0,0,id);
+    setData(0,0,id.toString());
     setData(1,0,description);
     setData(2,0,QString("%1").arg(loginfo[loglevel+1]));
     setData(3,0,QString("%1").arg(traceinfo[tracestatus+1]));
@@ -782,11 +775,11 @@ bool Project::Load(QString filename)
               if(xml.name() == QString("id"))
               {
                   if(contextitem)
-                      contextitem->id = xml.readElementText();
+                      contextitem->id = QDltId(xml.readElementText());
                   else if(applicationitem)
-                      applicationitem->id = xml.readElementText();
+                      applicationitem->id = QDltId(xml.readElementText());
                   else if(ecuitem)
-                      ecuitem->id = xml.readElementText();
+                      ecuitem->id = QDltId(xml.readElementText());
               }
               if(xml.name() == QString("description"))
               {
@@ -1073,7 +1066,7 @@ bool Project::Save(QString filename)
         EcuItem *ecuitem = (EcuItem*)ecu->topLevelItem(num);
         xml.writeStartElement("ecu");
 
-        xml.writeTextElement("id",ecuitem->id);
+        xml.writeTextElement("id",ecuitem->id.toString());
         xml.writeTextElement("description",ecuitem->description);
         xml.writeTextElement("interface",QString("%1").arg(ecuitem->interfacetype));
         xml.writeTextElement("hostname",ecuitem->getHostname());
@@ -1100,7 +1093,7 @@ bool Project::Save(QString filename)
             ApplicationItem * appitem = (ApplicationItem *) ecuitem->child(numapp);
             xml.writeStartElement("application");
 
-            xml.writeTextElement("id",appitem->id);
+            xml.writeTextElement("id",appitem->id.toString());
             xml.writeTextElement("description",appitem->description);
 
             for(int numcontext = 0; numcontext < appitem->childCount(); numcontext++)
@@ -1108,7 +1101,7 @@ bool Project::Save(QString filename)
                 ContextItem * conitem = (ContextItem *) appitem->child(numcontext);
                 xml.writeStartElement("context");
 
-                xml.writeTextElement("id",conitem->id);
+                xml.writeTextElement("id",conitem->id.toString());
                 xml.writeTextElement("description",conitem->description);
                 xml.writeTextElement("loglevel",QString("%1").arg(conitem->loglevel));
                 xml.writeTextElement("tracestatus",QString("%1").arg(conitem->tracestatus));
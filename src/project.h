@@ -38,6 +38,7 @@
 #endif
 
 #include "settingsdialog.h"
+#include "dltreceiverconnection.h"
 
 
 
@@ -69,7 +70,7 @@ public:
     void InvalidAll();
 
     /* configuration all */
-    QString id;
+    QDltId id;
     QString description;
     int interfacetype;
     int loglevel;
@@ -85,12 +86,8 @@ public:
     bool updateDataIfOnline;
     void update();
 
-    /* connection */
-    QTcpSocket tcpsocket;
-    QUdpSocket udpsocket;
-    QAbstractSocket * socket;
-
-    QextSerialPort *m_serialport;
+    /* connection, read by the receive thread, 0 if not connected before */
+    DltReceiverConnection *connection;
 
     /* connection status */
     int tryToConnect;
@@ -163,7 +160,7 @@ public:
     ApplicationItem(QTreeWidgetItem *parent = 0);
     ~ApplicationItem();
 
-    QString id;
+    QDltId id;
     QString description;
 
     void update();
@@ -181,7 +178,7 @@ public:
 
     enum {invalid,unknown,valid} status;
 
-    QString id;
+    QDltId id;
     QString description;
     int loglevel;
     int tracestatus;
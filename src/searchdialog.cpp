@@ -26,6 +26,7 @@
 #include <QMessageBox>
 #include <QProgressBar>
 #include <QProgressDialog>
+#include <limits.h>
 
 SearchDialog::SearchDialog(QWidget *parent) :
     QDialog(parent),
@@ -65,7 +66,7 @@ void SearchDialog::setCaseSensitive(bool caseSensitive) { ui->checkBoxCaseSensit
 void SearchDialog::setRegExp(bool regExp) { ui->checkBoxRegExp->setCheckState(regExp?Qt::Checked:Qt::Unchecked);}
 void SearchDialog::setNextClicked(bool next){nextClicked = next;}
 void SearchDialog::setMatch(bool matched){match=matched;}
-void SearchDialog::setStartLine(int start){startLine=start;}
+void SearchDialog::setStartLine(qint64 start){startLine=start;}
 void SearchDialog::setOnceClicked(bool clicked){onceClicked=clicked;}
 void SearchDialog::appendLineEdit(QLineEdit *lineEdit){ lineEdits->append(lineEdit);}
 void SearchDialog::setApIDText(QString text){ ui->apIdlineEdit->setText(text);}
@@ -82,7 +83,7 @@ bool SearchDialog::getMatch(){return match;}
 bool SearchDialog::getOnceClicked(){return onceClicked;}
 bool SearchDialog::searchtoIndex(){return (ui->checkBoxSearchIndex->checkState() ==Qt::Checked);}
 
-int SearchDialog::getStartLine( ){return startLine;}
+qint64 SearchDialog::getStartLine( ){return startLine;}
 QString SearchDialog::getApIDText(){ return ui->apIdlineEdit->text();}
 QString SearchDialog::getCtIDText(){ return ui->ctIdlineEdit->text();}
 QString SearchDialog::getTimeStampStart(){return ui->timeStartlineEdit->text();}
@@ -113,10 +114,10 @@ void SearchDialog::setSearchColour(QLineEdit *lineEdit,int result)
     }
 }
 
-void SearchDialog::focusRow(int searchLine)
+void SearchDialog::focusRow(qint64 searchLine)
 {
     TableModel *model = qobject_cast<TableModel *>(table->model());
-    QModelIndex idx = model->index(searchLine, 0, QModelIndex());
+    QModelIndex idx = model->index(model->showFilterIndex(searchLine), 0, QModelIndex());
     table->scrollTo(idx, QAbstractItemView::EnsureVisible);
     model->setLastSearchIndex(searchLine);
     table->selectionModel()->clear();
@@ -126,10 +127,10 @@ void SearchDialog::focusRow(int searchLine)
 int SearchDialog::find()
 {
     emit addActionHistory();
-    QRegExp searchTextRegExp;
+    QDltRegExp searchTextRegExp;
 
-    int searchLine;
-    int searchBorder;
+    qint64 searchLine;
+    qint64 searchBorder;
 
     emit searchProgressChanged(true);
 
@@ -151,7 +152,7 @@ int SearchDialog::find()
                     break;
                 }
             }
-            setStartLine(index.row());
+            setStartLine(qobject_cast<TableModel *>(table->model())->filterIndex(index.row()));
         }
     }
 
@@ -168,8 +169,7 @@ int SearchDialog::find()
 
     if(getRegExp())
     {
-        searchTextRegExp.setPattern(getText());
-        searchTextRegExp.setCaseSensitivity(getCaseSensitive()?Qt::CaseSensitive:Qt::CaseInsensitive);
+        searchTextRegExp.setPattern(getText(),getCaseSensitive()?Qt::CaseSensitive:Qt::CaseInsensitive);
         if (!searchTextRegExp.isValid())
         {
             QMessageBox::warning(0, QString("Search"),
@@ -201,15 +201,16 @@ int SearchDialog::find()
 }
 
 
-void SearchDialog::findProcess(int searchLine, int searchBorder, QRegExp &searchTextRegExp,QString apID, QString ctID, QString tStart, QString tEnd, QString tpayloadStart, QString tpayloadEnd)
+void SearchDialog::findProcess(qint64 searchLine, qint64 searchBorder, QDltRegExp &searchTextRegExp,QString apID, QString ctID, QString tStart, QString tEnd, QString tpayloadStart, QString tpayloadEnd)
 {
 
-    QDltMsg msg;
+    QDltMsgCacheEntry entry;
+    QDltMsg &msg = entry.msg;
     QByteArray buf;
     QString text;
     QString headerText;
 
-    int ctr = 0;
+    qint64 ctr = 0;
     Qt::CaseSensitivity is_Case_Sensitive = Qt::CaseInsensitive;
 
     if(getCaseSensitive())
@@ -240,13 +241,25 @@ void SearchDialog::findProcess(int searchLine, int searchBorder, QRegExp &search
 
     m_searchtablemodel->clear_SearchResults();
 
-    QProgressDialog fileprogress("Searching...", "Abort", 0, file->sizeFilter(), this);
+    /* the progress dialog is limited to int, scale down large files */
+    int progressShift = 0;
+    while((file->sizeFilter() >> progressShift) > INT_MAX)
+        progressShift++;
+
+    QProgressDialog fileprogress("Searching...", "Abort", 0, static_cast<int>(file->sizeFilter() >> progressShift), this);
     fileprogress.setWindowTitle("DLT Viewer");
     fileprogress.setWindowModality(Qt::NonModal);
     fileprogress.show();
 
     bool silentMode = !OptManager::getInstance()->issilentMode();
 
+    /* messages are searched one after the other, read them in large blocks */
+    QDltFileCursor cursor(file);
+
+    /* recently shown messages are taken from the message cache, which is not filled by the search */
+    bool pluginsEnabled = DltSettingsManager::getInstance()->value("startup/pluginsEnabled", true).toBool();
+    QByteArray configuration = pluginsEnabled ? pluginManager->getDecoderConfiguration() : QByteArray();
+
     do
     {
         ctr++;
@@ -272,7 +285,7 @@ void SearchDialog::findProcess(int searchLine, int searchBorder, QRegExp &search
         if(searchLine%1000==0)
         {
 
-            fileprogress.setValue(ctr);
+            fileprogress.setValue(static_cast<int>(ctr >> progressShift));
 
             if(fileprogress.wasCanceled())
             {
@@ -282,18 +295,22 @@ void SearchDialog::findProcess(int searchLine, int searchBorder, QRegExp &search
         }
 
         /* get the message with the selected item id */
-        buf = file->getMsgFilter(searchLine);
-        msg.setMsg(buf);
-        if(DltSettingsManager::getInstance()->value("startup/pluginsEnabled", true).toBool())
-            pluginManager->decodeMsg(msg,silentMode);
+        if(!file->getMsgCache().find(file->getMsgFilterPos(searchLine), configuration, entry))
+        {
+            buf = cursor.getMsgFilter(searchLine);
+            msg.setMsg(buf);
+            if(pluginsEnabled)
+                pluginManager->decodeMsg(msg,silentMode);
+            entry.render();
+        }
 
         bool pluginFound = false;
         headerText.clear();
         /* search header */
         if(!pluginFound || text.isEmpty())
         {
-            text += msg.toStringHeader();
-            tempPayLoad = msg.toStringPayload();
+            text += entry.header;
+            tempPayLoad = entry.payload;
 
         }
         headerText = text;
@@ -320,7 +337,7 @@ void SearchDialog::findProcess(int searchLine, int searchBorder, QRegExp &search
         {
             if (getRegExp())
             {
-                if(text.contains(searchTextRegExp))
+                if(searchTextRegExp.contains(text))
                 {
                     if ( foundLine(searchLine) )
                         break;
@@ -436,14 +453,14 @@ void SearchDialog::findProcess(int searchLine, int searchBorder, QRegExp &search
         text.clear();
         if(!pluginFound || text.isEmpty())
         {
-            text += msg.toStringPayload();
+            text += entry.payload;
         }
 
         if(getPayload())
         {
             if (getRegExp())
             {
-                if(tempPayLoad.contains(searchTextRegExp))
+                if(searchTextRegExp.contains(tempPayLoad))
                 {
                     if ( foundLine(searchLine) )
                         break;
@@ -605,7 +622,7 @@ bool SearchDialog::payLoadValidityCheck()
     return is_PayLoadRangeValid;
 }
 
-bool SearchDialog::timeStampPayloadValidityCheck(int searchLine)
+bool SearchDialog::timeStampPayloadValidityCheck(qint64 searchLine)
 {
     if(is_TimeStampSearchSelected)
     {
@@ -638,7 +655,7 @@ bool SearchDialog::timeStampPayloadValidityCheck(int searchLine)
     return false;
 }
 
-bool SearchDialog::timeStampCheck(int searchLine)
+bool SearchDialog::timeStampCheck(qint64 searchLine)
 {
     bool retVal = false;
     // If time stamps are given, they are considered to be of highest priority
@@ -691,7 +708,7 @@ bool SearchDialog::timeStampCheck(int searchLine)
     return retVal;
 }
 
-bool SearchDialog::foundLine(int searchLine)
+bool SearchDialog::foundLine(qint64 searchLine)
 {
     setMatch(true);
 
@@ -788,7 +805,7 @@ void SearchDialog::updateColorbutton()
 }
 
 
-void SearchDialog::addToSearchIndex(int searchLine)
+void SearchDialog::addToSearchIndex(qint64 searchLine)
 {
     m_searchtablemodel->add_SearchResultEntry(file->getMsgFilterPos(searchLine));    
 
@@ -817,7 +834,7 @@ void SearchDialog::loadSearchHistory()
     }
 
     // creating a local list to store the indexes related to the key retrieved from the cache.
-    QList <unsigned long> tmp ;
+    QList <qint64> tmp ;
     if(cachedHistoryKey.size() > 0)
     {
         tmp = cachedHistoryKey[text];
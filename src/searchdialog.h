@@ -42,7 +42,7 @@ private:
     Ui::SearchDialog *ui;
     SearchTableModel *m_searchtablemodel;
 
-    int startLine;    
+    qint64 startLine;    
     bool nextClicked;
     bool match;
     bool onceClicked;
@@ -57,7 +57,7 @@ private:
     bool is_TimeStampSearchSelected;
     bool is_TimeStampRangeValid;
 
-    QHash<QString, QList <unsigned long>> cachedHistoryKey;
+    QHash<QString, QList <qint64>> cachedHistoryKey;
 
 public:
     explicit SearchDialog(QWidget *parent = 0);
@@ -72,7 +72,7 @@ public:
     void setCaseSensitive(bool caseSensitive);
     void setRegExp(bool regExp);
     void setMatch(bool matched);
-    void setStartLine(int start);
+    void setStartLine(qint64 start);
     void setNextClicked(bool next);
     void setSearchColour(QLineEdit *lineEdit,int result);
     void setEnabledPrevious(bool enabled);
@@ -83,7 +83,7 @@ public:
     void setCtIDText(QString);
     void cacheSearchHistory();
     void clearCacheHistory();
-    QList < QList <unsigned long>> m_searchHistory;
+    QList < QList <qint64>> m_searchHistory;
 
     QString getText();
     bool getHeader();
@@ -96,23 +96,23 @@ public:
     bool getClicked();
     bool getOnceClicked();
     bool searchtoIndex();
-    int getStartLine();
+    qint64 getStartLine();
     QString getApIDText();
     QString getCtIDText();
     QString getTimeStampStart();
     QString getTimeStampEnd();
 
     int find();
-    void findProcess(int searchLine, int searchBorder, QRegExp &searchTextRegExp,QString apID, QString ctID, QString tStart, QString tEnd, QString payloadStart, QString payloadEnd);
-    bool timeStampCheck(int searchLine );
+    void findProcess(qint64 searchLine, qint64 searchBorder, QDltRegExp &searchTextRegExp,QString apID, QString ctID, QString tStart, QString tEnd, QString payloadStart, QString payloadEnd);
+    bool timeStampCheck(qint64 searchLine );
     void registerSearchTableModel(SearchTableModel *model);
     /**
      * @brief foundLine
      * @param searchLine
      * @return true, if search can be breaked here, false if it should continue
      */
-    bool foundLine(int searchLine);
-    void addToSearchIndex(int searchLine);
+    bool foundLine(qint64 searchLine);
+    void addToSearchIndex(qint64 searchLine);
     QDltFile *file;
     QTableView *table;
     QDltPluginManager *pluginManager;
@@ -122,10 +122,10 @@ public:
 
     QString getPayLoadStampStart();
     QString getPayLoadStampEnd();
-    bool timeStampPayloadValidityCheck(int searchLine);
+    bool timeStampPayloadValidityCheck(qint64 searchLine);
 private:
     void updateColorbutton();
-    void focusRow(int searchLine);
+    void focusRow(qint64 searchLine);
 
 private slots:
     void on_lineEditText_textEdited(QString newText);
@@ -41,7 +41,8 @@ SearchTableModel::~SearchTableModel()
 
 QVariant SearchTableModel::data(const QModelIndex &index, int role) const
 {
-    QDltMsg msg;
+    QDltMsgCacheEntry entry;
+    QDltMsg &msg = entry.msg;
     QByteArray buf;
 
     if (!index.isValid())
@@ -52,8 +53,10 @@ QVariant SearchTableModel::data(const QModelIndex &index, int role) const
 
     if (role == Qt::DisplayRole)
     {
-        /* get the message with the selected item id */
-        if(!qfile->getMsg(m_searchResultList.at(index.row()), msg))
+        /* get the decoded message with the selected item id, shared with the main table */
+        bool pluginsEnabled = DltSettingsManager::getInstance()->value("startup/pluginsEnabled", true).toBool();
+        if(!qfile->getMsgCache().getMsg(*qfile, m_searchResultList.at(index.row()), pluginsEnabled ? pluginManager : 0,
+                                        !OptManager::getInstance()->issilentMode(), entry))
         {
             if(index.column() == FieldNames::Index)
             {
@@ -66,9 +69,6 @@ QVariant SearchTableModel::data(const QModelIndex &index, int role) const
             return QVariant();
         }
 
-        if(DltSettingsManager::getInstance()->value("startup/pluginsEnabled", true).toBool())
-            pluginManager->decodeMsg(msg,!OptManager::getInstance()->issilentMode());
-
         switch(index.column())
         {
         case FieldNames::Index:
@@ -97,7 +97,7 @@ QVariant SearchTableModel::data(const QModelIndex &index, int role) const
                     for(int numapp = 0; numapp < ecuitem->childCount(); numapp++)
                     {
                         ApplicationItem * appitem = (ApplicationItem *) ecuitem->child(numapp);
-                        if(appitem->id == msg.getApid() && !appitem->description.isEmpty())
+                        if(appitem->id == msg.getApidId() && !appitem->description.isEmpty())
                         {
                            return appitem->description;
                         }
@@ -125,7 +125,7 @@ QVariant SearchTableModel::data(const QModelIndex &index, int role) const
                         {
                             ContextItem * conitem = (ContextItem *) appitem->child(numcontext);
 
-                            if(appitem->id == msg.getApid() && conitem->id == msg.getCtid()
+                            if(appitem->id == msg.getApidId() && conitem->id == msg.getCtidId()
                                     && !conitem->description.isEmpty())
                             {
                                return conitem->description;
@@ -162,7 +162,7 @@ QVariant SearchTableModel::data(const QModelIndex &index, int role) const
             return QString("%1").arg(msg.getNumberOfArguments());
         case FieldNames::Payload:
             /* display payload */
-            return msg.toStringPayload();
+            return entry.payload;
         default:
             if (index.column()>=FieldNames::Arg0)
             {
@@ -282,13 +282,13 @@ void SearchTableModel::clear_SearchResults()
     m_searchResultList.clear();
 }
 
-void SearchTableModel::add_SearchResultEntry(unsigned long entry)
+void SearchTableModel::add_SearchResultEntry(qint64 entry)
 {
     m_searchResultList.append(entry);
 }
 
 
-bool SearchTableModel::get_SearchResultEntry(int position, unsigned long &entry)
+bool SearchTableModel::get_SearchResultEntry(int position, qint64 &entry)
 {
     if (position > m_searchResultList.size() || 0 > position )
     {
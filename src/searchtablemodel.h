@@ -45,11 +45,11 @@ public:
     void modelChanged();
 
     void clear_SearchResults();
-    void add_SearchResultEntry(unsigned long entry);
+    void add_SearchResultEntry(qint64 entry);
 
 
     int get_SearchResultListSize() const;
-    bool get_SearchResultEntry(int position, unsigned long &entry);
+    bool get_SearchResultEntry(int position, qint64 &entry);
 
 
     /* pointer to the current loaded file */
@@ -63,7 +63,7 @@ public slots:
 
 
 public:
-    QList <unsigned long> m_searchResultList;
+    QList <qint64> m_searchResultList;
     
 };
 
@@ -111,6 +111,7 @@ SettingsDialog::SettingsDialog(QDltFile *_qFile, QWidget *parent):
 
     maxFileSizeMB = 0;
     appendDateTime = 0;
+    writeSync = 0;
 }
 
 SettingsDialog::SettingsDialog(QWidget *parent) :
@@ -231,6 +232,7 @@ void SettingsDialog::writeDlg()
     ui->groupBoxMaxFileSizeMB->setChecked(maxFileSizeMB);
     ui->lineEditMaxFileSizeMB->setText(QString("%1").arg(maxFileSizeMB));
     ui->checkBoxAppendDateTime->setCheckState(appendDateTime?Qt::Checked:Qt::Unchecked);
+    ui->comboBoxWriteSync->setCurrentIndex(writeSync);
 
     /* table */
     ui->spinBoxFontSize->setValue(fontSize);
@@ -402,6 +404,7 @@ void SettingsDialog::readDlg()
     else
         maxFileSizeMB = 0;
     appendDateTime = (ui->checkBoxAppendDateTime->checkState() == Qt::Checked);
+    writeSync = ui->comboBoxWriteSync->currentIndex();
 
     /* table */
     fontSize = ui->spinBoxFontSize->value();
@@ -484,6 +487,7 @@ void SettingsDialog::writeSettings(QMainWindow *mainwindow)
     settings->setValue("startup/loggingOnlyMode",loggingOnlyMode);
     settings->setValue("startup/maxFileSizeMB",maxFileSizeMB);
     settings->setValue("startup/appendDateTime",appendDateTime);
+    settings->setValue("startup/writeSync",writeSync);
 
     /* table */
     settings->setValue("startup/fontSize",fontSize);
@@ -556,6 +560,7 @@ void SettingsDialog::readSettings()
     loggingOnlyMode = settings->value("startup/loggingOnlyMode",0).toInt();
     maxFileSizeMB = settings->value("startup/maxFileSizeMB",0).toInt();
     appendDateTime = settings->value("startup/appendDateTime",0).toInt();
+    writeSync = settings->value("startup/writeSync",0).toInt();
 
     /* project table */
     fontSize = settings->value("startup/fontSize",8).toInt();
@@ -771,7 +776,7 @@ void SettingsDialog::on_pushButtonClearIndexCache_clicked()
 {
     QString path = ui->lineEditFilterCache->text();
     QDir dir(path);
-    dir.setNameFilters(QStringList() << "*.dix");
+    dir.setNameFilters(QStringList() << "*.dix" << "*.dim" << "*.dfm");
     dir.setFilter(QDir::Files);
     foreach(QString dirFile, dir.entryList())
     {
@@ -807,7 +812,7 @@ void SettingsDialog::clearIndexCacheAfterDays()
     }
 
     // go through each file and check modification date of file
-    dir.setNameFilters(QStringList() << "*.dix");
+    dir.setNameFilters(QStringList() << "*.dix" << "*.dim" << "*.dfm");
     dir.setFilter(QDir::Files);
     foreach(QString dirFile, dir.entryList())
     {
@@ -71,6 +71,7 @@ public:
     int loggingOnlyMode;
     int maxFileSizeMB;
     int appendDateTime;
+    int writeSync;
 
     int fontSize;
     int showIndex;
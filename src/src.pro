@@ -121,7 +121,14 @@ SOURCES += main.cpp \
     exporterdialog.cpp \
     dltmsgqueue.cpp \
     dltfileindexerthread.cpp \
-    dltfileindexerdefaultfilterthread.cpp
+    dltfileindexerdefaultfilterthread.cpp \
+    dltfileindexerrangethread.cpp \
+    dltfileindexerworkerthread.cpp \
+    dltfileindexersortthread.cpp \
+    dltfiltermatchcache.cpp \
+    dltreceiver.cpp \
+    dltreceiverconnection.cpp \
+    dltrecordwriter.cpp
 
 # Show these headers in the project
 HEADERS += mainwindow.h \
@@ -153,8 +160,16 @@ HEADERS += mainwindow.h \
     plugintreewidget.h \
     exporterdialog.h \
     dltmsgqueue.h \
+    dltblockingqueue.h \
     dltfileindexerthread.h \
-    dltfileindexerdefaultfilterthread.h
+    dltfileindexerdefaultfilterthread.h \
+    dltfileindexerrangethread.h \
+    dltfileindexerworkerthread.h \
+    dltfileindexersortthread.h \
+    dltfiltermatchcache.h \
+    dltreceiver.h \
+    dltreceiverconnection.h \
+    dltrecordwriter.h
 
 # Compile these UI files
 FORMS += mainwindow.ui \
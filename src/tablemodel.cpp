@@ -29,34 +29,9 @@
 #include "dlt_protocol.h"
 
 
-static int lastrow = -1; // necessary because object tablemodel can not be changed, so no member variable can be used
 char buffer[DLT_VIEWER_LIST_BUFFER_SIZE];
 
 
-void getmessage( int indexrow, long int filterposindex, unsigned int* decodeflag, QDltMsg* msg, QDltMsg* lastmsg, QDltFile* qfile, bool* success )
-{
- if ( indexrow == lastrow)
- {
-  *msg = *lastmsg;
- }
- else
- {
-  *success = qfile->getMsg(filterposindex, *msg);
-  *lastmsg = *msg;
-  *decodeflag = 1;
- }
- if ( indexrow == 0)
- {
-  lastrow = 0;
- }
- else
- {
-  lastrow = indexrow;
- }
-
-}
-
-
 TableModel::TableModel(const QString & /*data*/, QObject *parent)
      : QAbstractTableModel(parent)
  {
@@ -64,9 +39,9 @@ TableModel::TableModel(const QString & /*data*/, QObject *parent)
      project = NULL;
      pluginManager = NULL;
      lastSearchIndex = -1;
+     pageOffset = 0;
      emptyForceFlag = false;
      loggingOnlyMode = false;
-     lastrow = -1;
  }
 
  TableModel::~TableModel()
@@ -82,13 +57,12 @@ TableModel::TableModel(const QString & /*data*/, QObject *parent)
  QVariant TableModel::data(const QModelIndex &index, int role) const
  {
      QByteArray buf;
-     static QDltMsg msg;
-     static QDltMsg lastmsg;
-     static QDltMsg last_decoded_msg;
-     static unsigned int decodeflag = 0;
-     static bool success = true;
+     QDltMsgCacheEntry entry;
+     QDltMsg &msg = entry.msg;
+     bool success = true;
 
-     long int filterposindex = 0;
+     qint64 filterposindex = 0;
+     qint64 indexrow = 0;
 
 
      if (index.isValid() == false)
@@ -96,12 +70,14 @@ TableModel::TableModel(const QString & /*data*/, QObject *parent)
          return QVariant();
      }
 
-     if (index.row() >= qfile->sizeFilter() && index.row()<0)
+     indexrow = filterIndex(index.row());
+
+     if (indexrow >= qfile->sizeFilter() && indexrow<0)
      {
          return QVariant();
      }
 
-     filterposindex = qfile->getMsgFilterPos(index.row());
+     filterposindex = qfile->getMsgFilterPos(indexrow);
 
      if (role == Qt::DisplayRole)
      {
@@ -112,13 +88,13 @@ TableModel::TableModel(const QString & /*data*/, QObject *parent)
          }
          else
          {
-           getmessage( index.row(), filterposindex, &decodeflag, &msg, &lastmsg, qfile, &success);
+           success = getMessage(filterposindex, entry);
 
            if ( success == false )
            {
              if(index.column() == FieldNames::Index)
              {
-                 return QString("%1").arg(qfile->getMsgFilterPos(index.row()));
+                 return QString("%1").arg(filterposindex);
              }
              else if(index.column() == FieldNames::Payload)
              {
@@ -128,27 +104,11 @@ TableModel::TableModel(const QString & /*data*/, QObject *parent)
           }
          }
 
-         if((DltSettingsManager::getInstance()->value("startup/pluginsEnabled", true).toBool()))
-         {
-             if ( decodeflag == 1 )
-              {
-               decodeflag = 0;
-               last_decoded_msg = msg;
-               pluginManager->decodeMsg(msg,!OptManager::getInstance()->issilentMode());
-               last_decoded_msg = msg;
-              }
-              else
-              {
-                msg = last_decoded_msg;
-              }
-         }
-
-
          switch(index.column())
          {
          case FieldNames::Index:
              /* display index */
-             return QString("%1").arg(qfile->getMsgFilterPos(index.row()));
+             return QString("%1").arg(filterposindex);
          case FieldNames::Time:
              if( project->settings->automaticTimeSettings == 0 )
                 return QString("%1.%2").arg(msg.getGmTimeWithOffsetString(project->settings->utcOffset,project->settings->dst)).arg(msg.getMicroseconds(),6,10,QLatin1Char('0'));
@@ -173,7 +133,7 @@ TableModel::TableModel(const QString & /*data*/, QObject *parent)
                      for(int numapp = 0; numapp < ecuitem->childCount(); numapp++)
                      {
                          ApplicationItem * appitem = (ApplicationItem *) ecuitem->child(numapp);
-                         if(appitem->id == msg.getApid() && !appitem->description.isEmpty())
+                         if(appitem->id == msg.getApidId() && !appitem->description.isEmpty())
                          {
                             return appitem->description;
                          }
@@ -201,7 +161,7 @@ TableModel::TableModel(const QString & /*data*/, QObject *parent)
                          {
                              ContextItem * conitem = (ContextItem *) appitem->child(numcontext);
 
-                             if(appitem->id == msg.getApid() && conitem->id == msg.getCtid()
+                             if(appitem->id == msg.getApidId() && conitem->id == msg.getCtidId()
                                      && !conitem->description.isEmpty())
                              {
                                 return conitem->description;
@@ -246,7 +206,7 @@ TableModel::TableModel(const QString & /*data*/, QObject *parent)
                  return QString("Logging only Mode! Disable in Project Settings!");
              }
              /* display payload */
-             return msg.toStringPayload();
+             return entry.payload;
          default:
              if (index.column()>=FieldNames::Arg0)
              {
@@ -267,19 +227,19 @@ TableModel::TableModel(const QString & /*data*/, QObject *parent)
 
      if ( role == Qt::ForegroundRole )
      {
-         getmessage( index.row(), filterposindex, &decodeflag, &msg, &lastmsg, qfile, &success); // version2
+         getMessage(filterposindex, entry);
 
          // Color the last search row
          if(lastSearchIndex != -1 && filterposindex == qfile->getMsgFilterPos(lastSearchIndex))
          {
              return QVariant(QBrush(DltUiUtils::optimalTextColor(searchBackgroundColor())));
          }
-         else if (QColor(qfile->checkMarker(msg)).isValid())
+         else if (QColor(qfile->checkMarker(entry)).isValid())
          {
-           QColor color = qfile->checkMarker(msg);
+           QColor color = qfile->checkMarker(entry);
            return QVariant(QBrush(DltUiUtils::optimalTextColor(color)));
          }
-         else if(project->settings->autoMarkFatalError && !QColor(qfile->checkMarker(msg)).isValid() && ( msg.getSubtypeString() == "error" || msg.getSubtypeString() == "fatal")  )
+         else if(project->settings->autoMarkFatalError && !QColor(qfile->checkMarker(entry)).isValid() && ( msg.getSubtypeString() == "error" || msg.getSubtypeString() == "fatal")  )
          {
             return QVariant(QBrush(QColor(255,255,255)));
          }
@@ -291,24 +251,9 @@ TableModel::TableModel(const QString & /*data*/, QObject *parent)
 
      if ( role == Qt::BackgroundRole )
      {
-         getmessage( index.row(), filterposindex, &decodeflag, &msg, &lastmsg, qfile, &success); // version2
+         getMessage(filterposindex, entry);
 
-         if((DltSettingsManager::getInstance()->value("startup/pluginsEnabled", true).toBool()))
-         {
-             if ( decodeflag == 1 )
-              {
-               decodeflag = 0;
-               last_decoded_msg = msg;
-               pluginManager->decodeMsg(msg,!OptManager::getInstance()->issilentMode());
-               last_decoded_msg = msg;
-              }
-              else
-              {
-                msg = last_decoded_msg;
-              }
-         }
-
-         QColor color = qfile->checkMarker(msg);
+         QColor color = qfile->checkMarker(entry);
          if(color.isValid())
          {
             return QVariant(QBrush(color));
@@ -415,16 +360,38 @@ QVariant TableModel::headerData(int section, Qt::Orientation orientation,
      else if(loggingOnlyMode)
          return 1;
      else
-         return qfile->sizeFilter();
+         return static_cast<int>(qBound(static_cast<qint64>(0), qfile->sizeFilter() - pageOffset, static_cast<qint64>(DLT_VIEWER_TABLE_PAGE_SIZE)));
+ }
+
+ int TableModel::showFilterIndex(qint64 filterIndex)
+ {
+     if(filterIndex < 0)
+         return -1;
+
+     if(filterIndex < pageOffset || filterIndex >= pageOffset + DLT_VIEWER_TABLE_PAGE_SIZE)
+     {
+         /* move page, so that the message is in the middle of the page */
+         beginResetModel();
+         pageOffset = qMax(static_cast<qint64>(0), filterIndex - DLT_VIEWER_TABLE_PAGE_SIZE / 2);
+         endResetModel();
+     }
+
+     return static_cast<int>(filterIndex - pageOffset);
  }
 
  void TableModel::modelChanged()
  {
+     /* keep the page valid, if the filter index got smaller */
+     if(pageOffset > 0 && pageOffset >= qfile->sizeFilter())
+     {
+         pageOffset = qMax(static_cast<qint64>(0), qfile->sizeFilter() - DLT_VIEWER_TABLE_PAGE_SIZE);
+     }
+
      if(emptyForceFlag)
      {
          index(0, 1);
-         index(qfile->sizeFilter()-1, 0);
-         index(qfile->sizeFilter()-1, columnCount() - 1);
+         index(rowCount()-1, 0);
+         index(rowCount()-1, columnCount() - 1);
      }
      else
      {
@@ -432,13 +399,21 @@ QVariant TableModel::headerData(int section, Qt::Orientation orientation,
          index(0, 0);
          index(0, columnCount() - 1);
      }
-     lastrow = -1;
      emit(layoutChanged());
  }
 
 
 
 
+bool TableModel::getMessage(qint64 filterposindex, QDltMsgCacheEntry &entry) const
+{
+    /* messages are decoded once and shared with the search, markers and the export */
+    bool pluginsEnabled = DltSettingsManager::getInstance()->value("startup/pluginsEnabled", true).toBool();
+
+    return qfile->getMsgCache().getMsg(*qfile, filterposindex, pluginsEnabled ? pluginManager : 0,
+                                       !OptManager::getInstance()->issilentMode(), entry);
+}
+
 QColor TableModel::searchBackgroundColor() const
 {
     QString color = DltSettingsManager::getInstance()->value("other/searchResultColor", QString("#00AAFF")).toString();
@@ -32,6 +32,9 @@
 #define DLT_VIEWER_LIST_BUFFER_SIZE 100024
 #define DLT_VIEWER_COLUMN_COUNT 13
 
+/* number of messages shown at once, the row count of a model is limited to int */
+#define DLT_VIEWER_TABLE_PAGE_SIZE (1 << 30)
+
 extern "C"
 {
 }
@@ -59,13 +62,26 @@ public:
     void setForceEmpty(bool emptyForceFlag) { this->emptyForceFlag = emptyForceFlag; }
     void setLoggingOnlyMode(bool loggingOnlyMode) { this->loggingOnlyMode = loggingOnlyMode; }
 
-    void setLastSearchIndex(int idx) {this->lastSearchIndex = idx;}
+    void setLastSearchIndex(qint64 idx) {this->lastSearchIndex = idx;}
+
+    /* position in the filter index of the message shown in a row */
+    qint64 filterIndex(int row) const { return pageOffset + row; }
+
+    /* show the page containing a message and return its row, -1 if invalid */
+    int showFilterIndex(qint64 filterIndex);
+
+    /* position in the filter index of the message shown in the first row */
+    qint64 getPageOffset() const { return pageOffset; }
 private:
-    int lastSearchIndex;
+    qint64 lastSearchIndex;
+    qint64 pageOffset;
     bool emptyForceFlag;
     bool loggingOnlyMode;
 
     QColor searchBackgroundColor() const;
+
+    /* get the decoded message from the message cache */
+    bool getMessage(qint64 filterposindex, QDltMsgCacheEntry &entry) const;
 };
 
 class HtmlDelegate : public QStyledItemDelegate
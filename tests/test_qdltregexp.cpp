@@ -0,0 +1,92 @@
+/**
+ * @licence app begin@
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file test_qdltregexp.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QtTest>
+
+#include "qdltregexp.h"
+
+class TestQDltRegExp : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void requiredLiteral_data();
+    void requiredLiteral();
+    void contains_data();
+    void contains();
+};
+
+void TestQDltRegExp::requiredLiteral_data()
+{
+    QTest::addColumn<QString>("pattern");
+    QTest::addColumn<QString>("literal");
+    QTest::addColumn<bool>("complete");
+
+    QTest::newRow("literal") << "abc" << "abc" << true;
+    QTest::newRow("escaped") << "a\\.b" << "a.b" << true;
+    QTest::newRow("longest") << "ab.*cdef" << "cdef" << false;
+    QTest::newRow("optional") << "abcx?" << "abc" << false;
+    QTest::newRow("alternative") << "abc|xyz" << "" << false;
+    QTest::newRow("alternative in group") << "abc(d|e)" << "abc" << false;
+    QTest::newRow("alternative behind hex escape") << "abc\\x41|xyz" << "" << false;
+    QTest::newRow("alternative behind back reference") << "(a)bc\\1|xyz" << "" << false;
+    QTest::newRow("alternative behind property") << "abc\\p{L}|xyz" << "" << false;
+    QTest::newRow("unterminated class") << "abc[x" << "" << false;
+    QTest::newRow("unterminated group") << "abc(x" << "" << false;
+    QTest::newRow("option") << "(?i)abc" << "" << false;
+}
+
+void TestQDltRegExp::requiredLiteral()
+{
+    QFETCH(QString, pattern);
+    QFETCH(QString, literal);
+    QFETCH(bool, complete);
+
+    bool literalOnly = !complete;
+    QCOMPARE(QDltRegExp::requiredLiteral(pattern, &literalOnly), literal);
+    QCOMPARE(literalOnly, complete);
+}
+
+void TestQDltRegExp::contains_data()
+{
+    QTest::addColumn<QString>("pattern");
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<bool>("found");
+
+    QTest::newRow("literal") << "abc" << "xxabcxx" << true;
+    QTest::newRow("literal missing") << "abc" << "xxabxx" << false;
+    QTest::newRow("prefiltered") << "ab.*cdef" << "ab12cdef" << true;
+    QTest::newRow("first alternative behind hex escape") << "abc\\x41|xyz" << "abcA" << true;
+    QTest::newRow("second alternative behind hex escape") << "abc\\x41|xyz" << "xyz" << true;
+    QTest::newRow("no alternative behind hex escape") << "abc\\x41|xyz" << "abc" << false;
+}
+
+void TestQDltRegExp::contains()
+{
+    QFETCH(QString, pattern);
+    QFETCH(QString, text);
+    QFETCH(bool, found);
+
+    QDltRegExp regexp(pattern);
+    QVERIFY(regexp.isValid());
+    QCOMPARE(regexp.contains(text), found);
+}
+
+QTEST_APPLESS_MAIN(TestQDltRegExp)
+
+#include "test_qdltregexp.moc"